@@ -0,0 +1,1481 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <set>
+#include <span>
+#include <stack>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "s21_containers.h"
+#include "s21_perf_counters.h"
+
+static std::vector<int> shuffledKeys(int n) {
+  std::vector<int> keys(n);
+  for (int i = 0; i < n; i++) keys[i] = i;
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  return keys;
+}
+
+// ---------------------------------------------------------------------------
+// Container suite: the same operations on every s21 container and on its std
+// counterpart, over sizes from 10 to 10M and three key types. Names read
+// BM_<Operation><Container, Key>/<size>, so a run can be narrowed with
+// --benchmark_filter (e.g. 'Lookup<.*Map, int>') and compared against a
+// stored baseline with s21_bench_compare.py.
+
+// A key as wide as a cache line: comparisons stay cheap, but every node
+// and every copy moves 64 bytes.
+struct Blob64 {
+  int64_t id;
+  char payload[56];
+
+  bool operator<(const Blob64 &other) const { return id < other.id; }
+  bool operator>(const Blob64 &other) const { return id > other.id; }
+  bool operator==(const Blob64 &other) const { return id == other.id; }
+};
+static_assert(sizeof(Blob64) == 64);
+
+template <typename K>
+static K makeKey(int i);
+
+template <>
+int makeKey<int>(int i) {
+  return i;
+}
+
+// Longer than the small-string buffer, so every key owns a heap block.
+template <>
+std::string makeKey<std::string>(int i) {
+  std::string digits = std::to_string(i);
+  return std::string(24 - digits.size(), '0') + digits;
+}
+
+template <>
+Blob64 makeKey<Blob64>(int i) {
+  Blob64 key{};
+  key.id = i;
+  return key;
+}
+
+template <typename K>
+static std::vector<K> suiteKeys(int64_t n) {
+  std::vector<K> keys;
+  keys.reserve(n);
+  for (int i : shuffledKeys(n)) keys.push_back(makeKey<K>(i));
+  return keys;
+}
+
+// One spelling per operation for all containers.
+template <typename C, typename K>
+static void add(C &c, const K &key) {
+  if constexpr (requires { c.push_back(key); }) {
+    c.push_back(key);
+  } else if constexpr (requires { c.push(key); }) {
+    c.push(key);
+  } else if constexpr (requires { typename C::mapped_type; }) {
+    if constexpr (requires { c.try_emplace(key); }) {
+      c.try_emplace(key);
+    } else {
+      c.insert(key, typename C::mapped_type());
+    }
+  } else {
+    c.insert(key);
+  }
+}
+
+template <typename C, typename K>
+static C build(const std::vector<K> &keys) {
+  C c;
+  for (const K &key : keys) add(c, key);
+  return c;
+}
+
+// Fills a container for a benchmark that does not measure the filling.
+// Flat containers take the whole range at once instead of n inserts into
+// the middle of an array.
+template <typename C, typename K>
+static C prepare(const std::vector<K> &keys) {
+  if constexpr (std::is_same_v<C, s21::flat_set<K>>) {
+    return C(keys.begin(), keys.end());
+  } else if constexpr (std::is_same_v<C, s21::flat_map<K, int>>) {
+    std::vector<std::pair<K, int>> items;
+    for (const K &key : keys) items.emplace_back(key, 0);
+    return C(items.begin(), items.end());
+  } else {
+    return build<C>(keys);
+  }
+}
+
+template <typename C>
+static size_t visit(C &c) {
+  size_t visited = 0;
+  for (auto it = c.begin(); it != c.end(); ++it) {
+    const auto &element = *it;
+    benchmark::DoNotOptimize(&element);
+    ++visited;
+  }
+  return visited;
+}
+
+// Hardware counters over the timed part of a suite benchmark, reported
+// per item as extra columns (cycles, instructions, IPC, cache, branch and
+// TLB misses). The counters pause with the timer, so setup done under
+// pause() is not charged. Events the machine does not offer are left out;
+// the run's context records which ones were measured.
+static s21::perf_counters &perfCounters() {
+  static s21::perf_counters counters;
+  return counters;
+}
+
+class Counted {
+ public:
+  explicit Counted(benchmark::State &state) : state_(state) {
+    perfCounters().reset();
+    perfCounters().start();
+  }
+  Counted(const Counted &) = delete;
+  Counted &operator=(const Counted &) = delete;
+
+  void pause() {
+    perfCounters().stop();
+    state_.PauseTiming();
+  }
+
+  void resume() {
+    state_.ResumeTiming();
+    perfCounters().start();
+  }
+
+  void finish(int64_t items) {
+    perfCounters().stop();
+    state_.SetItemsProcessed(items);
+    if (items == 0) return;
+    for (int i = 0; i < s21::kPerfEvents; i++) {
+      auto event = s21::perf_event(i);
+      if (perfCounters().available(event)) {
+        state_.counters[s21::perf_event_name(event)] =
+            double(perfCounters().read(event)) / items;
+      }
+    }
+    if (state_.counters.count("cycles") &&
+        state_.counters.count("instructions") &&
+        state_.counters["cycles"] > 0) {
+      state_.counters["IPC"] =
+          state_.counters["instructions"] / state_.counters["cycles"];
+    }
+  }
+
+ private:
+  benchmark::State &state_;
+};
+
+template <template <typename> class C, typename K>
+static void BM_Insert(benchmark::State &state) {
+  std::vector<K> keys = suiteKeys<K>(state.range(0));
+  Counted counted(state);
+  for (auto _ : state) {
+    C<K> c = build<C<K>>(keys);
+    benchmark::DoNotOptimize(c.size());
+  }
+  counted.finish(state.iterations() * state.range(0));
+}
+
+// Half of the probes hit; the misses use keys from a second range.
+template <template <typename> class C, typename K>
+static void BM_Lookup(benchmark::State &state) {
+  std::vector<K> keys = suiteKeys<K>(state.range(0));
+  C<K> c = prepare<C<K>>(keys);
+  std::vector<K> probes;
+  for (size_t i = 0; i < keys.size(); i++) {
+    probes.push_back(i % 2 ? keys[i] : makeKey<K>(state.range(0) + i));
+  }
+  Counted counted(state);
+  for (auto _ : state) {
+    size_t hits = 0;
+    for (const K &key : probes) hits += c.contains(key);
+    benchmark::DoNotOptimize(hits);
+  }
+  counted.finish(state.iterations() * state.range(0));
+}
+
+template <template <typename> class C, typename K>
+static void BM_Erase(benchmark::State &state) {
+  std::vector<K> keys = suiteKeys<K>(state.range(0));
+  Counted counted(state);
+  for (auto _ : state) {
+    counted.pause();
+    C<K> c = prepare<C<K>>(keys);
+    counted.resume();
+    for (const K &key : keys) c.erase(key);
+    benchmark::DoNotOptimize(c.size());
+  }
+  counted.finish(state.iterations() * state.range(0));
+}
+
+template <template <typename> class C, typename K>
+static void BM_Iterate(benchmark::State &state) {
+  C<K> c = prepare<C<K>>(suiteKeys<K>(state.range(0)));
+  Counted counted(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(visit(c));
+  }
+  counted.finish(state.iterations() * state.range(0));
+}
+
+template <template <typename> class C, typename K>
+static void BM_Copy(benchmark::State &state) {
+  C<K> c = prepare<C<K>>(suiteKeys<K>(state.range(0)));
+  Counted counted(state);
+  for (auto _ : state) {
+    C<K> copy(c);
+    benchmark::DoNotOptimize(copy.size());
+  }
+  counted.finish(state.iterations() * state.range(0));
+}
+
+// Moves the contents out and back, so each iteration does two moves.
+template <template <typename> class C, typename K>
+static void BM_Move(benchmark::State &state) {
+  C<K> c = prepare<C<K>>(suiteKeys<K>(state.range(0)));
+  Counted counted(state);
+  for (auto _ : state) {
+    C<K> moved(std::move(c));
+    c = std::move(moved);
+    benchmark::DoNotOptimize(c.size());
+  }
+  counted.finish(state.iterations() * 2);
+}
+
+// Sequences: remove from the back, one element at a time.
+template <template <typename> class C, typename K>
+static void BM_PopBack(benchmark::State &state) {
+  std::vector<K> keys = suiteKeys<K>(state.range(0));
+  Counted counted(state);
+  for (auto _ : state) {
+    counted.pause();
+    C<K> c = build<C<K>>(keys);
+    counted.resume();
+    while (!c.empty()) c.pop_back();
+    benchmark::DoNotOptimize(c.size());
+  }
+  counted.finish(state.iterations() * state.range(0));
+}
+
+template <template <typename> class C, typename K>
+static void BM_Index(benchmark::State &state) {
+  std::vector<K> keys = suiteKeys<K>(state.range(0));
+  C<K> c = build<C<K>>(keys);
+  std::vector<int> positions = shuffledKeys(state.range(0));
+  Counted counted(state);
+  for (auto _ : state) {
+    for (int i : positions) benchmark::DoNotOptimize(c[i]);
+  }
+  counted.finish(state.iterations() * state.range(0));
+}
+
+template <template <typename> class C, typename K>
+static void BM_Sort(benchmark::State &state) {
+  std::vector<K> keys = suiteKeys<K>(state.range(0));
+  Counted counted(state);
+  for (auto _ : state) {
+    counted.pause();
+    C<K> c = build<C<K>>(keys);
+    counted.resume();
+    c.sort();
+    benchmark::DoNotOptimize(c.size());
+  }
+  counted.finish(state.iterations() * state.range(0));
+}
+
+// Merges two disjoint halves; lists get them sorted, as merge requires.
+template <template <typename> class C, typename K>
+static void BM_Merge(benchmark::State &state) {
+  std::vector<K> keys = suiteKeys<K>(state.range(0));
+  auto middle = keys.begin() + keys.size() / 2;
+  std::vector<K> low(keys.begin(), middle);
+  std::vector<K> high(middle, keys.end());
+  if constexpr (requires(C<K> c) { c.sort(); }) {
+    std::sort(low.begin(), low.end());
+    std::sort(high.begin(), high.end());
+  }
+  Counted counted(state);
+  for (auto _ : state) {
+    counted.pause();
+    C<K> a = build<C<K>>(low);
+    C<K> b = build<C<K>>(high);
+    counted.resume();
+    a.merge(b);
+    benchmark::DoNotOptimize(a.size());
+  }
+  counted.finish(state.iterations() * state.range(0));
+}
+
+template <template <typename> class C, typename K>
+static void BM_Splice(benchmark::State &state) {
+  std::vector<K> keys = suiteKeys<K>(state.range(0));
+  auto middle = keys.begin() + keys.size() / 2;
+  std::vector<K> front(keys.begin(), middle);
+  std::vector<K> back(middle, keys.end());
+  Counted counted(state);
+  for (auto _ : state) {
+    counted.pause();
+    C<K> a = build<C<K>>(front);
+    C<K> b = build<C<K>>(back);
+    counted.resume();
+    if constexpr (requires { a.splice(a.endConst(), b); }) {
+      a.splice(a.endConst(), b);
+    } else {
+      a.splice(a.end(), b);
+    }
+    benchmark::DoNotOptimize(a.size());
+  }
+  counted.finish(state.iterations() * state.range(0));
+}
+
+// Adaptors: fill, then drain.
+template <template <typename> class C, typename K>
+static void BM_PushPop(benchmark::State &state) {
+  std::vector<K> keys = suiteKeys<K>(state.range(0));
+  Counted counted(state);
+  for (auto _ : state) {
+    C<K> c = build<C<K>>(keys);
+    while (!c.empty()) c.pop();
+    benchmark::DoNotOptimize(c.size());
+  }
+  counted.finish(state.iterations() * state.range(0));
+}
+
+template <typename K>
+using S21Vector = s21::vector<K>;
+template <typename K>
+using StdVector = std::vector<K>;
+template <typename K>
+using S21List = s21::list<K>;
+template <typename K>
+using StdList = std::list<K>;
+template <typename K>
+using S21Queue = s21::queue<K>;
+template <typename K>
+using StdQueue = std::queue<K>;
+template <typename K>
+using S21Stack = s21::stack<K>;
+template <typename K>
+using StdStack = std::stack<K>;
+template <typename K>
+using S21Set = s21::set<K>;
+template <typename K>
+using S21FlatSet = s21::flat_set<K>;
+template <typename K>
+using StdSet = std::set<K>;
+template <typename K>
+using S21Map = s21::map<K, int>;
+template <typename K>
+using S21FlatMap = s21::flat_map<K, int>;
+template <typename K>
+using S21PersistentMap = s21::persistent_map<K, int>;
+template <typename K>
+using StdMap = std::map<K, int>;
+
+// Sizes 10, 100, ..., up to max. String and Blob64 keys stop at 1M: at 10M
+// the key vector plus a container and its copy no longer fit comfortably
+// in the memory of the machines we benchmark on.
+template <int64_t max>
+static void sizesUpTo(benchmark::internal::Benchmark *b) {
+  for (int64_t n = 10; n <= max; n *= 10) b->Arg(n);
+}
+
+constexpr int64_t kLargest = 10'000'000;
+constexpr int64_t kLargestWide = 1'000'000;
+// Inserting into and erasing from flat containers one key at a time is
+// O(n^2), so those stop early to let a full run finish.
+constexpr int64_t kQuadratic = 10'000;
+
+#define S21_SUITE(op, container, max)                         \
+  BENCHMARK_TEMPLATE(op, container, int)->Apply(sizesUpTo<max>); \
+  BENCHMARK_TEMPLATE(op, container, std::string)                 \
+      ->Apply(sizesUpTo<std::min(max, kLargestWide)>);           \
+  BENCHMARK_TEMPLATE(op, container, Blob64)                      \
+      ->Apply(sizesUpTo<std::min(max, kLargestWide)>)
+
+S21_SUITE(BM_Insert, S21Vector, kLargest);
+S21_SUITE(BM_Insert, StdVector, kLargest);
+S21_SUITE(BM_Insert, S21List, kLargest);
+S21_SUITE(BM_Insert, StdList, kLargest);
+S21_SUITE(BM_Insert, S21Set, kLargest);
+S21_SUITE(BM_Insert, S21FlatSet, kQuadratic);
+S21_SUITE(BM_Insert, StdSet, kLargest);
+S21_SUITE(BM_Insert, S21Map, kLargest);
+S21_SUITE(BM_Insert, S21FlatMap, kQuadratic);
+S21_SUITE(BM_Insert, S21PersistentMap, kLargest);
+S21_SUITE(BM_Insert, StdMap, kLargest);
+
+S21_SUITE(BM_Lookup, S21Set, kLargest);
+S21_SUITE(BM_Lookup, S21FlatSet, kLargest);
+S21_SUITE(BM_Lookup, StdSet, kLargest);
+S21_SUITE(BM_Lookup, S21Map, kLargest);
+S21_SUITE(BM_Lookup, S21FlatMap, kLargest);
+S21_SUITE(BM_Lookup, S21PersistentMap, kLargest);
+S21_SUITE(BM_Lookup, StdMap, kLargest);
+S21_SUITE(BM_Index, S21Vector, kLargest);
+S21_SUITE(BM_Index, StdVector, kLargest);
+
+S21_SUITE(BM_Erase, S21Set, kLargest);
+S21_SUITE(BM_Erase, S21FlatSet, kQuadratic);
+S21_SUITE(BM_Erase, StdSet, kLargest);
+S21_SUITE(BM_Erase, S21Map, kLargest);
+S21_SUITE(BM_Erase, S21FlatMap, kQuadratic);
+S21_SUITE(BM_Erase, S21PersistentMap, kLargest);
+S21_SUITE(BM_Erase, StdMap, kLargest);
+S21_SUITE(BM_PopBack, S21Vector, kLargest);
+S21_SUITE(BM_PopBack, StdVector, kLargest);
+S21_SUITE(BM_PopBack, S21List, kLargest);
+S21_SUITE(BM_PopBack, StdList, kLargest);
+S21_SUITE(BM_PushPop, S21Queue, kLargest);
+S21_SUITE(BM_PushPop, StdQueue, kLargest);
+S21_SUITE(BM_PushPop, S21Stack, kLargest);
+S21_SUITE(BM_PushPop, StdStack, kLargest);
+
+S21_SUITE(BM_Iterate, S21Vector, kLargest);
+S21_SUITE(BM_Iterate, StdVector, kLargest);
+S21_SUITE(BM_Iterate, S21List, kLargest);
+S21_SUITE(BM_Iterate, StdList, kLargest);
+S21_SUITE(BM_Iterate, S21Set, kLargest);
+S21_SUITE(BM_Iterate, S21FlatSet, kLargest);
+S21_SUITE(BM_Iterate, StdSet, kLargest);
+S21_SUITE(BM_Iterate, S21Map, kLargest);
+S21_SUITE(BM_Iterate, S21FlatMap, kLargest);
+S21_SUITE(BM_Iterate, S21PersistentMap, kLargest);
+S21_SUITE(BM_Iterate, StdMap, kLargest);
+
+S21_SUITE(BM_Sort, S21List, kLargest);
+S21_SUITE(BM_Sort, StdList, kLargest);
+S21_SUITE(BM_Merge, S21List, kLargest);
+S21_SUITE(BM_Merge, StdList, kLargest);
+S21_SUITE(BM_Merge, S21Set, kLargest);
+S21_SUITE(BM_Merge, StdSet, kLargest);
+S21_SUITE(BM_Merge, S21Map, kLargest);
+S21_SUITE(BM_Merge, StdMap, kLargest);
+S21_SUITE(BM_Splice, S21List, kLargest);
+S21_SUITE(BM_Splice, StdList, kLargest);
+
+S21_SUITE(BM_Copy, S21Vector, kLargest);
+S21_SUITE(BM_Copy, StdVector, kLargest);
+S21_SUITE(BM_Copy, S21List, kLargest);
+S21_SUITE(BM_Copy, StdList, kLargest);
+S21_SUITE(BM_Copy, S21Set, kLargest);
+S21_SUITE(BM_Copy, S21FlatSet, kLargest);
+S21_SUITE(BM_Copy, StdSet, kLargest);
+S21_SUITE(BM_Copy, S21Map, kLargest);
+S21_SUITE(BM_Copy, S21FlatMap, kLargest);
+S21_SUITE(BM_Copy, S21PersistentMap, kLargest);
+S21_SUITE(BM_Copy, StdMap, kLargest);
+
+S21_SUITE(BM_Move, S21Vector, kLargest);
+S21_SUITE(BM_Move, StdVector, kLargest);
+S21_SUITE(BM_Move, S21List, kLargest);
+S21_SUITE(BM_Move, StdList, kLargest);
+S21_SUITE(BM_Move, S21Set, kLargest);
+S21_SUITE(BM_Move, StdSet, kLargest);
+S21_SUITE(BM_Move, S21Map, kLargest);
+S21_SUITE(BM_Move, StdMap, kLargest);
+
+// ---------------------------------------------------------------------------
+// Targeted benchmarks for individual optimisations.
+
+static void BM_S21MapFullScan(benchmark::State &state) {
+  s21::map<int, int> m;
+  for (int key : shuffledKeys(state.range(0))) m.insert(key, key);
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto it = m.begin(); it != m.end(); ++it) sum += it->second;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_S21MapFullScan)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+static void BM_StdMapFullScan(benchmark::State &state) {
+  std::map<int, int> m;
+  for (int key : shuffledKeys(state.range(0))) m.insert({key, key});
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto it = m.begin(); it != m.end(); ++it) sum += it->second;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdMapFullScan)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+static void BM_S21SetFullScan(benchmark::State &state) {
+  s21::set<int> s;
+  for (int key : shuffledKeys(state.range(0))) s.insert(key);
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto it = s.begin(); it != s.end(); ++it) sum += *it;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_S21SetFullScan)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+static void BM_StdSetFullScan(benchmark::State &state) {
+  std::set<int> s;
+  for (int key : shuffledKeys(state.range(0))) s.insert(key);
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto it = s.begin(); it != s.end(); ++it) sum += *it;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdSetFullScan)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+// Long keys sharing a 64-byte prefix make every comparison expensive, so
+// the number of comparisons per node dominates lookup time.
+static std::vector<std::string> longStringKeys(int n) {
+  std::vector<std::string> keys;
+  for (int key : shuffledKeys(n)) {
+    keys.push_back(std::string(64, 'k') + std::to_string(key));
+  }
+  return keys;
+}
+
+struct LessOnly {
+  bool operator()(const std::string &a, const std::string &b) const {
+    return a < b;
+  }
+};
+
+template <typename Map>
+static void stringLookup(benchmark::State &state) {
+  std::vector<std::string> keys = longStringKeys(state.range(0));
+  Map m;
+  for (const std::string &key : keys) m.insert({key, 1});
+  for (auto _ : state) {
+    long hits = 0;
+    for (const std::string &key : keys) hits += m.count(key);
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_S21MapStringLookupThreeWay(benchmark::State &state) {
+  stringLookup<s21::map<std::string, int>>(state);
+}
+BENCHMARK(BM_S21MapStringLookupThreeWay)->Range(1 << 10, 1 << 16);
+
+static void BM_S21MapStringLookupLessOnly(benchmark::State &state) {
+  stringLookup<s21::map<std::string, int, LessOnly>>(state);
+}
+BENCHMARK(BM_S21MapStringLookupLessOnly)->Range(1 << 10, 1 << 16);
+
+static void BM_StdMapStringLookup(benchmark::State &state) {
+  stringLookup<std::map<std::string, int>>(state);
+}
+BENCHMARK(BM_StdMapStringLookup)->Range(1 << 10, 1 << 16);
+
+// Building from already-sorted input skips the sort and links nodes into a
+// balanced tree directly.
+template <typename Map>
+static void sortedBuild(benchmark::State &state) {
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < state.range(0); i++) items.push_back({i, i});
+  for (auto _ : state) {
+    Map m(items.begin(), items.end());
+    benchmark::DoNotOptimize(m.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_S21MapSortedBuild(benchmark::State &state) {
+  sortedBuild<s21::map<int, int>>(state);
+}
+BENCHMARK(BM_S21MapSortedBuild)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+static void BM_StdMapSortedBuild(benchmark::State &state) {
+  sortedBuild<std::map<int, int>>(state);
+}
+BENCHMARK(BM_StdMapSortedBuild)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+template <typename Set>
+static void mergeHalves(benchmark::State &state) {
+  std::vector<int> keys = shuffledKeys(state.range(0));
+  auto middle = keys.begin() + keys.size() / 2;
+  for (auto _ : state) {
+    state.PauseTiming();
+    Set a(keys.begin(), middle);
+    Set b(middle, keys.end());
+    state.ResumeTiming();
+    a.merge(b);
+    benchmark::DoNotOptimize(a.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_S21SetMerge(benchmark::State &state) {
+  mergeHalves<s21::set<int>>(state);
+}
+BENCHMARK(BM_S21SetMerge)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+static void BM_StdSetMerge(benchmark::State &state) {
+  mergeHalves<std::set<int>>(state);
+}
+BENCHMARK(BM_StdSetMerge)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+// Intersection of two ID sets: probing one set with contains() for every
+// key of the other against a single merge walk, serial and threaded.
+static void intersectionInputs(int n, s21::set<int> &a, s21::set<int> &b) {
+  std::vector<int> a_items;
+  std::vector<int> b_items;
+  for (int i = 0; i < n; i++) {
+    a_items.push_back(2 * i);
+    b_items.push_back(3 * i);
+  }
+  s21::set<int>(a_items.begin(), a_items.end()).swap(a);
+  s21::set<int>(b_items.begin(), b_items.end()).swap(b);
+}
+
+static void BM_S21SetIntersectionByContains(benchmark::State &state) {
+  s21::set<int> a;
+  s21::set<int> b;
+  intersectionInputs(state.range(0), a, b);
+  for (auto _ : state) {
+    s21::set<int> out;
+    for (auto it = a.begin(); it != a.end(); ++it) {
+      if (b.contains(*it)) out.insert(*it);
+    }
+    benchmark::DoNotOptimize(out.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+BENCHMARK(BM_S21SetIntersectionByContains)->Range(1 << 10, 1 << 14);
+
+static void BM_S21SetIntersection(benchmark::State &state) {
+  s21::set<int> a;
+  s21::set<int> b;
+  intersectionInputs(state.range(0), a, b);
+  for (auto _ : state) {
+    s21::set<int> out = s21::set_intersection(a, b, state.range(1));
+    benchmark::DoNotOptimize(out.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+BENCHMARK(BM_S21SetIntersection)
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 20, 8), {1, 4}});
+
+// Shared-map throughput from 1 to 64 threads. Each thread draws keys from
+// its own generator; read_percent of the operations are lookups and the
+// rest alternate between insert and erase.
+constexpr int kSharedKeys = 1 << 16;
+
+struct GlobalMutexMap {
+  std::mutex mutex;
+  s21::map<int, int> map;
+
+  bool find(int key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return map.contains(key);
+  }
+  void insert(int key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    map.try_emplace(key, key);
+  }
+  void erase(int key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    map.erase(key);
+  }
+};
+
+struct ShardedMap {
+  s21::concurrent_map<int, int> map;
+
+  bool find(int key) { return map.contains(key); }
+  void insert(int key) { map.insert(key, key); }
+  void erase(int key) { map.erase(key); }
+};
+
+struct SkipListMap {
+  s21::concurrent_skiplist_map<int, int> map;
+
+  bool find(int key) { return map.contains(key); }
+  void insert(int key) { map.insert(key, key); }
+  void erase(int key) { map.erase(key); }
+};
+
+template <typename Shared>
+static Shared &sharedMap() {
+  static Shared *shared = [] {
+    Shared *created = new Shared;
+    for (int key : shuffledKeys(kSharedKeys)) created->insert(key);
+    return created;
+  }();
+  return *shared;
+}
+
+template <typename Shared>
+static void mixedWorkload(benchmark::State &state) {
+  Shared &shared = sharedMap<Shared>();
+  int read_percent = state.range(0);
+  std::mt19937 rng(state.thread_index() + 1);
+  long hits = 0;
+  for (auto _ : state) {
+    unsigned draw = rng();
+    int key = draw % kSharedKeys;
+    if (static_cast<int>((draw >> 20) % 100) < read_percent) {
+      hits += shared.find(key);
+    } else if (draw & (1u << 30)) {
+      shared.insert(key);
+    } else {
+      shared.erase(key);
+    }
+  }
+  benchmark::DoNotOptimize(hits);
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_GlobalMutexMap(benchmark::State &state) {
+  mixedWorkload<GlobalMutexMap>(state);
+}
+BENCHMARK(BM_GlobalMutexMap)
+    ->Arg(95)
+    ->Arg(50)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+static void BM_ConcurrentMap(benchmark::State &state) {
+  mixedWorkload<ShardedMap>(state);
+}
+BENCHMARK(BM_ConcurrentMap)
+    ->Arg(95)
+    ->Arg(50)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+static void BM_SkipListMap(benchmark::State &state) {
+  mixedWorkload<SkipListMap>(state);
+}
+BENCHMARK(BM_SkipListMap)
+    ->Arg(95)
+    ->Arg(50)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+// Membership tests against a read-only key set. The sizes put the keys in
+// L2 (1 << 15), in L3 (1 << 20) and in DRAM (1 << 25; the node-based set
+// stops at 1 << 22, where its nodes alone are far beyond the L3).
+static std::vector<int> probes(int n) {
+  std::vector<int> keys(1 << 16);
+  std::mt19937 rng(7);
+  for (int &key : keys) key = rng() % (2 * n);
+  return keys;
+}
+
+template <typename Set>
+static void lookups(benchmark::State &state, const Set &s) {
+  std::vector<int> keys = probes(state.range(0));
+  for (auto _ : state) {
+    long hits = 0;
+    for (int key : keys) hits += s.contains(key);
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+static std::vector<int> evenKeys(int n) {
+  std::vector<int> keys(n);
+  for (int i = 0; i < n; i++) keys[i] = 2 * i;
+  return keys;
+}
+
+static void BM_S21SetContains(benchmark::State &state) {
+  std::vector<int> keys = evenKeys(state.range(0));
+  lookups(state, s21::set<int>(keys.begin(), keys.end()));
+}
+BENCHMARK(BM_S21SetContains)->Arg(1 << 15)->Arg(1 << 20)->Arg(1 << 22);
+
+static void BM_FlatSetContains(benchmark::State &state) {
+  std::vector<int> keys = evenKeys(state.range(0));
+  lookups(state, s21::flat_set<int>(keys.begin(), keys.end()));
+}
+BENCHMARK(BM_FlatSetContains)->Arg(1 << 15)->Arg(1 << 20)->Arg(1 << 25);
+
+static void BM_StaticSetContains(benchmark::State &state) {
+  std::vector<int> keys = evenKeys(state.range(0));
+  lookups(state, s21::static_set<int>(keys.begin(), keys.end()));
+}
+BENCHMARK(BM_StaticSetContains)->Arg(1 << 15)->Arg(1 << 20)->Arg(1 << 25);
+
+// Replays a Zipfian (s = 0.99) trace over 1M keys through a cache of
+// range(0) entries; a miss is followed by a put, as in a read-through cache.
+static const std::vector<int> &zipfTrace() {
+  static const std::vector<int> trace = [] {
+    const int kKeys = 1 << 20;
+    std::vector<double> cdf(kKeys);
+    double total = 0;
+    for (int i = 0; i < kKeys; i++) {
+      total += 1.0 / std::pow(i + 1, 0.99);
+      cdf[i] = total;
+    }
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> uniform(0, total);
+    std::vector<int> keys(1 << 20);
+    for (int &key : keys) {
+      key = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) -
+            cdf.begin();
+    }
+    std::vector<int> scramble = shuffledKeys(kKeys);
+    for (int &key : keys) key = scramble[key];
+    return keys;
+  }();
+  return trace;
+}
+
+static void BM_LruCacheZipf(benchmark::State &state) {
+  const std::vector<int> &trace = zipfTrace();
+  double hit_ratio = 0;
+  for (auto _ : state) {
+    s21::lru_cache<int, int> cache(state.range(0));
+    for (int key : trace) {
+      if (cache.get(key) == nullptr) cache.put(key, key);
+    }
+    hit_ratio = static_cast<double>(cache.stats().hits) / trace.size();
+  }
+  state.counters["hit_ratio"] = hit_ratio;
+  state.SetItemsProcessed(state.iterations() * trace.size());
+}
+BENCHMARK(BM_LruCacheZipf)->Range(1 << 10, 1 << 18);
+
+// The list-plus-map cache this container replaces, on std containers so
+// that the comparison is not dominated by a linear list search.
+static void BM_StdListMapLruZipf(benchmark::State &state) {
+  const std::vector<int> &trace = zipfTrace();
+  size_t capacity = state.range(0);
+  for (auto _ : state) {
+    std::list<std::pair<int, int>> order;
+    std::unordered_map<int, std::list<std::pair<int, int>>::iterator> index;
+    for (int key : trace) {
+      auto found = index.find(key);
+      if (found != index.end()) {
+        order.splice(order.begin(), order, found->second);
+        continue;
+      }
+      order.emplace_front(key, key);
+      index[key] = order.begin();
+      if (order.size() > capacity) {
+        index.erase(order.back().first);
+        order.pop_back();
+      }
+    }
+    benchmark::DoNotOptimize(order.size());
+  }
+  state.SetItemsProcessed(state.iterations() * trace.size());
+}
+BENCHMARK(BM_StdListMapLruZipf)->Range(1 << 10, 1 << 18);
+
+// Scans over s21::vector with each SIMD level, range(1) being the level
+// (0 scalar, 1 SSE2, 2 AVX2), over 1 KiB (L1) to 16 MiB (DRAM) of data.
+template <typename T, typename Scan>
+static void simdScan(benchmark::State &state, Scan scan) {
+  auto wanted = static_cast<s21::simd::level>(state.range(1));
+  if (wanted > s21::simd::supported()) {
+    state.SkipWithError("level not supported by this CPU");
+    return;
+  }
+  s21::simd::use(wanted);
+  s21::vector<T> v(state.range(0) / sizeof(T));
+  for (size_t i = 0; i < v.size(); i++) v[i] = T(i % 1000);
+  s21::vector<T> copy(v);
+  for (auto _ : state) benchmark::DoNotOptimize(scan(v, copy));
+  s21::simd::use(s21::simd::supported());
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void simdSizes(benchmark::internal::Benchmark *b) {
+  b->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 24, 16), {0, 1, 2}});
+}
+
+// Looks for a value that is not there, so the whole vector is read.
+static void BM_SimdFindInt(benchmark::State &state) {
+  simdScan<int32_t>(state, [](auto &v, auto &) {
+    return s21::simd::find(v, -1) == v.end();
+  });
+}
+BENCHMARK(BM_SimdFindInt)->Apply(simdSizes);
+
+static void BM_SimdCountInt(benchmark::State &state) {
+  simdScan<int32_t>(state,
+                    [](auto &v, auto &) { return s21::simd::count(v, 7); });
+}
+BENCHMARK(BM_SimdCountInt)->Apply(simdSizes);
+
+static void BM_SimdMinInt(benchmark::State &state) {
+  simdScan<int32_t>(state, [](auto &v, auto &) { return s21::simd::min(v); });
+}
+BENCHMARK(BM_SimdMinInt)->Apply(simdSizes);
+
+static void BM_SimdSumInt(benchmark::State &state) {
+  simdScan<int32_t>(state, [](auto &v, auto &) { return s21::simd::sum(v); });
+}
+BENCHMARK(BM_SimdSumInt)->Apply(simdSizes);
+
+static void BM_SimdSumFloat(benchmark::State &state) {
+  simdScan<float>(state, [](auto &v, auto &) { return s21::simd::sum(v); });
+}
+BENCHMARK(BM_SimdSumFloat)->Apply(simdSizes);
+
+static void BM_SimdMaxFloat(benchmark::State &state) {
+  simdScan<float>(state, [](auto &v, auto &) { return s21::simd::max(v); });
+}
+BENCHMARK(BM_SimdMaxFloat)->Apply(simdSizes);
+
+// Reads both vectors, so the bytes processed are twice the counter.
+static void BM_SimdEqualInt(benchmark::State &state) {
+  simdScan<int32_t>(state,
+                    [](auto &v, auto &w) { return s21::simd::equal(v, w); });
+}
+BENCHMARK(BM_SimdEqualInt)->Apply(simdSizes);
+
+// s21::par scaling: range(1) threads, from 1 to every hardware thread, on
+// 16M elements. Pools are made once per thread count and kept.
+static s21::par::thread_pool &poolOf(unsigned threads) {
+  static std::map<unsigned, std::unique_ptr<s21::par::thread_pool>> pools;
+  auto &pool = pools[threads];
+  if (!pool) pool = std::make_unique<s21::par::thread_pool>(threads - 1);
+  return *pool;
+}
+
+static void parallelThreads(benchmark::internal::Benchmark *b) {
+  int all = std::max(std::thread::hardware_concurrency(), 1u);
+  for (int threads = 1; threads < all; threads *= 2) {
+    b->Args({1 << 24, threads});
+  }
+  b->Args({1 << 24, all});
+  // CPU time would only count the calling thread, so every point of the
+  // scaling curve is timed by the wall clock.
+  b->UseRealTime();
+}
+
+static s21::vector<int> randomInts(size_t n) {
+  s21::vector<int> v(n);
+  std::mt19937 rng(5);
+  for (size_t i = 0; i < n; i++) v[i] = rng();
+  return v;
+}
+
+static void BM_ParSort(benchmark::State &state) {
+  s21::par::thread_pool &pool = poolOf(state.range(1));
+  s21::vector<int> keys = randomInts(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    s21::vector<int> v(keys);
+    state.ResumeTiming();
+    s21::par::sort(pool, v);
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParSort)->Apply(parallelThreads);
+
+static void BM_ParReduce(benchmark::State &state) {
+  s21::par::thread_pool &pool = poolOf(state.range(1));
+  s21::vector<int> v = randomInts(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s21::par::reduce(pool, v, 0L, std::plus<>()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+}
+BENCHMARK(BM_ParReduce)->Apply(parallelThreads);
+
+static void BM_ParTransform(benchmark::State &state) {
+  s21::par::thread_pool &pool = poolOf(state.range(1));
+  s21::vector<int> v = randomInts(state.range(0));
+  for (auto _ : state) {
+    auto roots = s21::par::transform(
+        pool, v, [](int x) { return std::sqrt(std::abs(double(x))); });
+    benchmark::DoNotOptimize(roots.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParTransform)->Apply(parallelThreads);
+
+static void BM_ParForEach(benchmark::State &state) {
+  s21::par::thread_pool &pool = poolOf(state.range(1));
+  s21::vector<int> v = randomInts(state.range(0));
+  for (auto _ : state) {
+    s21::par::for_each(pool, v, [](int &x) { x = x * 1103515245 + 12345; });
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParForEach)->Apply(parallelThreads);
+
+// Walks the subtrees of a 1M-node set from split() on each thread.
+static void BM_ParSetReduce(benchmark::State &state) {
+  s21::par::thread_pool &pool = poolOf(state.range(1));
+  std::vector<int> keys = shuffledKeys(state.range(0) / 16);
+  s21::set<int> s(keys.begin(), keys.end());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s21::par::reduce(
+        pool, s, 0L, [](long sum, int key) { return sum + key; },
+        std::plus<>()));
+  }
+  state.SetItemsProcessed(state.iterations() * s.size());
+}
+BENCHMARK(BM_ParSetReduce)->Apply(parallelThreads);
+
+// Radix sort against std::sort on random keys, and on 32-byte records
+// sorted by a 64-bit id.
+template <typename T>
+static s21::vector<T> radixKeys(size_t n) {
+  s21::vector<T> v(n);
+  std::mt19937_64 rng(13);
+  for (size_t i = 0; i < n; i++) {
+    if constexpr (std::is_floating_point_v<T>) {
+      v[i] = std::normal_distribution<T>(0, 1e6)(rng);
+    } else {
+      v[i] = static_cast<T>(rng());
+    }
+  }
+  return v;
+}
+
+template <typename T, typename Sort>
+static void sortCopies(benchmark::State &state, const s21::vector<T> &keys,
+                       Sort sort) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    s21::vector<T> v(keys);
+    state.ResumeTiming();
+    sort(v);
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename T>
+static void BM_RadixSort(benchmark::State &state) {
+  sortCopies(state, radixKeys<T>(state.range(0)),
+             [](s21::vector<T> &v) { s21::radix_sort(v); });
+}
+
+template <typename T>
+static void BM_StdSort(benchmark::State &state) {
+  sortCopies(state, radixKeys<T>(state.range(0)),
+             [](s21::vector<T> &v) { std::sort(v.begin(), v.end()); });
+}
+
+BENCHMARK_TEMPLATE(BM_RadixSort, uint32_t)->Range(1 << 10, 1 << 24);
+BENCHMARK_TEMPLATE(BM_StdSort, uint32_t)->Range(1 << 10, 1 << 24);
+BENCHMARK_TEMPLATE(BM_RadixSort, int64_t)->Range(1 << 10, 1 << 24);
+BENCHMARK_TEMPLATE(BM_StdSort, int64_t)->Range(1 << 10, 1 << 24);
+BENCHMARK_TEMPLATE(BM_RadixSort, float)->Range(1 << 10, 1 << 24);
+BENCHMARK_TEMPLATE(BM_StdSort, float)->Range(1 << 10, 1 << 24);
+
+struct Record32 {
+  int64_t id;
+  int64_t payload[3];
+};
+
+static s21::vector<Record32> records(size_t n) {
+  s21::vector<Record32> v(n);
+  std::mt19937_64 rng(17);
+  for (size_t i = 0; i < n; i++) v[i].id = rng();
+  return v;
+}
+
+static void BM_RadixSortRecords(benchmark::State &state) {
+  sortCopies(state, records(state.range(0)), [](s21::vector<Record32> &v) {
+    s21::radix_sort(v, [](const Record32 &r) { return r.id; });
+  });
+}
+BENCHMARK(BM_RadixSortRecords)->Range(1 << 10, 1 << 22);
+
+static void BM_StdSortRecords(benchmark::State &state) {
+  sortCopies(state, records(state.range(0)), [](s21::vector<Record32> &v) {
+    std::sort(v.begin(), v.end(), [](const Record32 &a, const Record32 &b) {
+      return a.id < b.id;
+    });
+  });
+}
+BENCHMARK(BM_StdSortRecords)->Range(1 << 10, 1 << 22);
+
+static void BM_S21ListRadixSort(benchmark::State &state) {
+  s21::vector<uint32_t> keys = radixKeys<uint32_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    s21::list<uint32_t> l;
+    for (uint32_t key : keys) l.push_back(key);
+    state.ResumeTiming();
+    l.radix_sort();
+    benchmark::DoNotOptimize(l.size());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_S21ListRadixSort)->Range(1 << 10, 1 << 22);
+
+static void BM_S21ListMergeSort(benchmark::State &state) {
+  s21::vector<uint32_t> keys = radixKeys<uint32_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    s21::list<uint32_t> l;
+    for (uint32_t key : keys) l.push_back(key);
+    state.ResumeTiming();
+    l.sort();
+    benchmark::DoNotOptimize(l.size());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_S21ListMergeSort)->Range(1 << 10, 1 << 22);
+
+// Process start-up: opening a file of n 16-byte records with mmap_vector
+// against reading it into a vector with fread and push_back. The file is
+// in the page cache after the first run, so this measures the copying
+// rather than the disk. Files are written once and removed at exit.
+struct FileRecord {
+  int64_t id;
+  double value;
+};
+
+static std::string recordFile(size_t n) {
+  struct Files {
+    std::map<size_t, std::string> paths;
+    ~Files() {
+      for (auto &entry : paths) std::remove(entry.second.c_str());
+    }
+  };
+  static Files files;
+  std::string &path = files.paths[n];
+  if (path.empty()) {
+    path = "/tmp/s21_bench_records_" + std::to_string(n);
+    std::remove(path.c_str());
+    s21::mmap_vector<FileRecord> v(path, s21::mmap_mode::read_write);
+    v.resize(n);
+    for (size_t i = 0; i < n; i++) v[i] = {int64_t(i), i * 0.5};
+  }
+  return path;
+}
+
+static void BM_MmapVectorOpen(benchmark::State &state) {
+  std::string path = recordFile(state.range(0));
+  for (auto _ : state) {
+    s21::mmap_vector<FileRecord> v(path);
+    benchmark::DoNotOptimize(v.back().id);
+  }
+}
+BENCHMARK(BM_MmapVectorOpen)->Range(1 << 16, 1 << 24);
+
+static void BM_MmapVectorOpenAndScan(benchmark::State &state) {
+  std::string path = recordFile(state.range(0));
+  for (auto _ : state) {
+    s21::mmap_vector<FileRecord> v(path);
+    v.advise(s21::mmap_access::sequential);
+    double sum = 0;
+    for (const FileRecord &record : v) sum += record.value;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) *
+                          sizeof(FileRecord));
+}
+BENCHMARK(BM_MmapVectorOpenAndScan)->Range(1 << 16, 1 << 24);
+
+static void BM_VectorReadAndScan(benchmark::State &state) {
+  std::string path = recordFile(state.range(0));
+  for (auto _ : state) {
+    s21::vector<FileRecord> v;
+    std::FILE *in = std::fopen(path.c_str(), "rb");
+    FileRecord record;
+    while (std::fread(&record, sizeof(record), 1, in) == 1) {
+      v.push_back(record);
+    }
+    std::fclose(in);
+    double sum = 0;
+    for (const FileRecord &r : v) sum += r.value;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) *
+                          sizeof(FileRecord));
+}
+BENCHMARK(BM_VectorReadAndScan)->Range(1 << 16, 1 << 24);
+
+// Start-up with a saved index: loading a snapshot of n (int64, double)
+// entries, which links the nodes into a balanced tree as they are read,
+// against inserting the same records one by one from the flat file above.
+// Sizes that would not fit in memory are skipped.
+static bool fitsInMemory(benchmark::State &state, size_t bytes) {
+  size_t memory =
+      size_t(sysconf(_SC_PHYS_PAGES)) * size_t(sysconf(_SC_PAGE_SIZE));
+  if (bytes > memory / 2) {
+    state.SkipWithError("not enough memory for this size");
+    return false;
+  }
+  return true;
+}
+
+// About a node and its allocation, plus a record in the page cache.
+constexpr size_t kBytesPerSavedEntry = 96;
+
+template <typename Tree>
+static std::string snapshotFile(size_t n, const char *kind) {
+  struct Files {
+    std::map<std::string, std::string> paths;
+    ~Files() {
+      for (auto &entry : paths) std::remove(entry.second.c_str());
+    }
+  };
+  static Files files;
+  std::string name = kind + std::to_string(n);
+  std::string &path = files.paths[name];
+  if (path.empty()) {
+    path = "/tmp/s21_bench_snapshot_" + name;
+    s21::mmap_vector<FileRecord> records(recordFile(n));
+    Tree tree;
+    for (const FileRecord &record : records) {
+      if constexpr (requires { tree.insert(record.id, record.value); }) {
+        tree.insert(record.id, record.value);
+      } else {
+        tree.insert(record.id);
+      }
+    }
+    std::ofstream out(path, std::ios::binary);
+    tree.save(out);
+  }
+  return path;
+}
+
+static void snapshotSizes(benchmark::internal::Benchmark *b) {
+  b->Arg(1000000)->Arg(10000000)->Arg(100000000);
+  b->Unit(benchmark::kMillisecond)->Iterations(3);
+}
+
+static void BM_MapLoad(benchmark::State &state) {
+  if (!fitsInMemory(state, state.range(0) * kBytesPerSavedEntry)) return;
+  using Map = s21::map<int64_t, double>;
+  std::string path = snapshotFile<Map>(state.range(0), "map");
+  for (auto _ : state) {
+    Map m;
+    std::ifstream in(path, std::ios::binary);
+    m.load(in);
+    benchmark::DoNotOptimize(m.size());
+  }
+}
+BENCHMARK(BM_MapLoad)->Apply(snapshotSizes);
+
+static void BM_MapInsertFromFile(benchmark::State &state) {
+  if (!fitsInMemory(state, state.range(0) * kBytesPerSavedEntry)) return;
+  std::string path = recordFile(state.range(0));
+  for (auto _ : state) {
+    s21::map<int64_t, double> m;
+    std::FILE *in = std::fopen(path.c_str(), "rb");
+    FileRecord record;
+    while (std::fread(&record, sizeof(record), 1, in) == 1) {
+      m.insert(record.id, record.value);
+    }
+    std::fclose(in);
+    benchmark::DoNotOptimize(m.size());
+  }
+}
+BENCHMARK(BM_MapInsertFromFile)->Apply(snapshotSizes);
+
+static void BM_SetLoad(benchmark::State &state) {
+  if (!fitsInMemory(state, state.range(0) * kBytesPerSavedEntry)) return;
+  using Set = s21::set<int64_t>;
+  std::string path = snapshotFile<Set>(state.range(0), "set");
+  for (auto _ : state) {
+    Set s;
+    std::ifstream in(path, std::ios::binary);
+    s.load(in);
+    benchmark::DoNotOptimize(s.size());
+  }
+}
+BENCHMARK(BM_SetLoad)->Apply(snapshotSizes);
+
+static void BM_SetInsertFromFile(benchmark::State &state) {
+  if (!fitsInMemory(state, state.range(0) * kBytesPerSavedEntry)) return;
+  std::string path = recordFile(state.range(0));
+  for (auto _ : state) {
+    s21::set<int64_t> s;
+    std::FILE *in = std::fopen(path.c_str(), "rb");
+    FileRecord record;
+    while (std::fread(&record, sizeof(record), 1, in) == 1) {
+      s.insert(record.id);
+    }
+    std::fclose(in);
+    benchmark::DoNotOptimize(s.size());
+  }
+}
+BENCHMARK(BM_SetInsertFromFile)->Apply(snapshotSizes);
+
+// Many short-lived vectors of 0 to 11 ints, most of them under 8, as when
+// each request collects a handful of ids: s21::vector allocates on the
+// first push_back and again at 2, 3, 5 and 9 elements, while
+// small_vector<int, 8> only allocates for the few that outgrow it.
+// allocs_per_vector is counted in a separate untimed pass, by watching
+// data() move to a new buffer.
+static s21::vector<int> shortLengths() {
+  s21::vector<int> lengths;
+  std::mt19937 rng(49);
+  std::geometric_distribution<int> length(0.3);
+  for (int i = 0; i < 1 << 14; i++) {
+    lengths.push_back(std::min(length(rng), 11));
+  }
+  return lengths;
+}
+
+template <typename V>
+static void BM_ShortVectors(benchmark::State &state) {
+  static const s21::vector<int> lengths = shortLengths();
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (int length : lengths) {
+      V v;
+      for (int i = 0; i < length; i++) v.push_back(i);
+      for (int x : v) sum += x;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  size_t allocations = 0;
+  for (int length : lengths) {
+    V v;
+    const int *buffer = v.data();
+    for (int i = 0; i < length; i++) {
+      v.push_back(i);
+      allocations += v.data() != buffer;
+      buffer = v.data();
+    }
+  }
+  state.counters["allocs_per_vector"] = double(allocations) / lengths.size();
+  state.SetItemsProcessed(state.iterations() * lengths.size());
+}
+BENCHMARK_TEMPLATE(BM_ShortVectors, s21::vector<int>);
+BENCHMARK_TEMPLATE(BM_ShortVectors, s21::small_vector<int, 8>);
+BENCHMARK_TEMPLATE(BM_ShortVectors, std::vector<int>);
+
+// Passes over particles that read one or two of eight fields, stored as a
+// vector of 32-byte structs (AoS) and as a soa_vector with a column per
+// field (SoA). The AoS loop pulls every field through the cache to use
+// one; the SoA loop reads only the columns it needs, in sequence.
+struct Particle {
+  float x, y, z;
+  float vx, vy, vz;
+  float mass;
+  int32_t id;
+};
+
+using ParticleColumns =
+    s21::soa_vector<float, float, float, float, float, float, float, int32_t>;
+
+static void particleSizes(benchmark::internal::Benchmark *b) {
+  b->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+}
+
+static s21::vector<Particle> particleStructs(size_t n) {
+  s21::vector<Particle> particles;
+  particles.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    float f = float(i % 1000);
+    particles.push_back({f, f, f, 1, 2, 3, 0.5f + f, int32_t(i)});
+  }
+  return particles;
+}
+
+static ParticleColumns particleColumns(size_t n) {
+  ParticleColumns particles;
+  particles.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    float f = float(i % 1000);
+    particles.push_back({f, f, f, 1, 2, 3, 0.5f + f, int32_t(i)});
+  }
+  return particles;
+}
+
+static void BM_AosSumMass(benchmark::State &state) {
+  s21::vector<Particle> particles = particleStructs(state.range(0));
+  for (auto _ : state) {
+    float sum = 0;
+    for (const Particle &p : particles) sum += p.mass;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AosSumMass)->Apply(particleSizes);
+
+static void BM_SoaSumMass(benchmark::State &state) {
+  ParticleColumns particles = particleColumns(state.range(0));
+  for (auto _ : state) {
+    float sum = 0;
+    for (float mass : particles.column<6>()) sum += mass;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SoaSumMass)->Apply(particleSizes);
+
+static void BM_SoaSimdSumMass(benchmark::State &state) {
+  ParticleColumns particles = particleColumns(state.range(0));
+  for (auto _ : state) {
+    std::span<const float> mass = std::as_const(particles).column<6>();
+    benchmark::DoNotOptimize(
+        s21::simd::sum(mass.data(), mass.data() + mass.size()));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SoaSimdSumMass)->Apply(particleSizes);
+
+static void BM_AosAdvanceX(benchmark::State &state) {
+  s21::vector<Particle> particles = particleStructs(state.range(0));
+  for (auto _ : state) {
+    for (Particle &p : particles) p.x += p.vx * 0.01f;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AosAdvanceX)->Apply(particleSizes);
+
+static void BM_SoaAdvanceX(benchmark::State &state) {
+  ParticleColumns particles = particleColumns(state.range(0));
+  for (auto _ : state) {
+    std::span<float> x = particles.column<0>();
+    std::span<const float> vx = std::as_const(particles).column<3>();
+    for (size_t i = 0; i < x.size(); i++) x[i] += vx[i] * 0.01f;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SoaAdvanceX)->Apply(particleSizes);
+
+// BENCHMARK_MAIN plus a context entry naming the hardware counters measured.
+int main(int argc, char **argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  std::string events;
+  for (int i = 0; i < s21::kPerfEvents; i++) {
+    auto event = s21::perf_event(i);
+    if (perfCounters().available(event)) {
+      events += events.empty() ? "" : ",";
+      events += s21::perf_event_name(event);
+    }
+  }
+  if (!perfCounters().unavailable_reason().empty()) {
+    events += (events.empty() ? "" : "; ") + std::string("unavailable: ") +
+              perfCounters().unavailable_reason();
+  }
+  benchmark::AddCustomContext("perf_counters", events);
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
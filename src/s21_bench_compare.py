@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Flags benchmark regressions against a stored baseline.
+
+Usage:
+    s21_bench_compare.py BASELINE CURRENT [--threshold 0.10]
+                         [--metric cpu_time|real_time]
+
+Both files are Google Benchmark JSON output (--benchmark_out_format=json).
+Benchmarks are matched by name; when a run used repetitions, the median
+aggregate is compared. A benchmark slower than the baseline by more than
+the threshold is a regression and makes the script exit with status 1.
+Benchmarks found in only one of the files are listed but do not fail.
+"""
+
+import argparse
+import json
+import sys
+
+UNIT_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path, metric):
+    with open(path) as f:
+        runs = json.load(f)["benchmarks"]
+    times = {}
+    medians = {}
+    for run in runs:
+        if run.get("error_occurred"):
+            continue
+        value = run[metric] * UNIT_NS[run.get("time_unit", "ns")]
+        if run.get("run_type") == "aggregate":
+            if run.get("aggregate_name") == "median":
+                medians[run["run_name"]] = value
+        else:
+            times.setdefault(run.get("run_name", run["name"]), value)
+    times.update(medians)
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="allowed slowdown as a fraction (default 0.10)")
+    parser.add_argument("--metric", choices=["cpu_time", "real_time"],
+                        default="cpu_time")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    current = load(args.current, args.metric)
+
+    regressions = []
+    improvements = []
+    for name in sorted(baseline.keys() & current.keys()):
+        before, after = baseline[name], current[name]
+        if before <= 0:
+            continue
+        change = after / before - 1
+        if change > args.threshold:
+            regressions.append((name, before, after, change))
+        elif change < -args.threshold:
+            improvements.append((name, before, after, change))
+
+    def report(title, rows):
+        if rows:
+            print(f"{title} ({len(rows)}):")
+            for name, before, after, change in rows:
+                print(f"  {name}: {before:.0f} ns -> {after:.0f} ns "
+                      f"({change:+.1%})")
+
+    report("Regressions", regressions)
+    report("Improvements", improvements)
+    for title, names in (("Only in baseline", baseline.keys() - current.keys()),
+                         ("Only in current", current.keys() - baseline.keys())):
+        if names:
+            print(f"{title}: {len(names)} benchmarks")
+    compared = len(baseline.keys() & current.keys())
+    print(f"{compared} benchmarks compared, {len(regressions)} regressed "
+          f"by more than {args.threshold:.0%}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
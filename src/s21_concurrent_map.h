@@ -0,0 +1,96 @@
+#ifndef SRC_S21_CONCURRENT_MAP_H_
+#define SRC_S21_CONCURRENT_MAP_H_
+
+#include <bit>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+
+#include "s21_memory_stats.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Hash map for many threads. Keys are spread over a power-of-two number of
+// shards, each a separately chained hash table behind its own reader-writer
+// lock, so lookups in one shard never wait for writers in another and
+// lookups in the same shard only wait for writers there. Shards sit on
+// their own cache lines. Values are returned by copy: a reference into a
+// shard would outlive the lock that protects it.
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class concurrent_map {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  static constexpr size_type kDefaultShards = 64;
+
+  explicit concurrent_map(size_type shards = kDefaultShards);
+  concurrent_map(const concurrent_map &) = delete;
+  concurrent_map &operator=(const concurrent_map &) = delete;
+  ~concurrent_map();
+
+  std::optional<V> find(const K &key) const;
+  bool contains(const K &key) const;
+  bool insert(const K &key, const V &value);
+  bool insert_or_assign(const K &key, const V &value);
+  bool erase(const K &key);
+
+  // Returns the value for key, calling make() to create it if the key is
+  // absent. make() runs under the shard's write lock, so it is called at
+  // most once per key even when several threads race on the same key.
+  template <typename F>
+  V compute_if_absent(const K &key, F &&make);
+
+  // Calls f(value) under the shard's write lock if key is present.
+  template <typename F>
+  bool update(const K &key, F &&f);
+
+  void clear();
+  size_type size() const;
+  bool empty() const;
+  size_type shard_count() const;
+  // Locks the shards one after another, like size().
+  memory_stats memory_usage() const;
+
+ private:
+  struct Entry {
+    K key;
+    V value;
+    size_t hash;
+    Entry *next;
+  };
+
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    vector<Entry *> buckets;
+    size_type count = 0;
+    [[no_unique_address]] memory_counter<memory_category::concurrent_map>
+        accounting;
+
+    Entry *find(const K &key, size_t hash, const KeyEqual &equal) const;
+    void add(Entry *entry);
+    void rehash();
+    void clear();
+  };
+
+  vector<Shard> shards_;
+  size_type shard_mask_;
+  Hash hash_;
+  KeyEqual equal_;
+
+  size_t hashOf(const K &key) const;
+  Shard &shardFor(size_t hash);
+  const Shard &shardFor(size_t hash) const;
+};
+
+#include "s21_concurrent_map.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_CONCURRENT_MAP_H_
@@ -0,0 +1,243 @@
+using namespace s21;
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+concurrent_map<K, V, Hash, KeyEqual>::concurrent_map(size_type shards)
+    : shards_(std::bit_ceil(shards ? shards : 1)),
+      shard_mask_(shards_.size() - 1) {}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+concurrent_map<K, V, Hash, KeyEqual>::~concurrent_map() {
+  clear();
+}
+
+// std::hash is the identity for integers. Multiplying carries every input
+// bit into the high half, which picks the shard, but the low bits of the
+// product still depend only on the low bits of the key; folding the high
+// half down gives the bucket, taken from the low bits, all of them too.
+template <typename K, typename V, typename Hash, typename KeyEqual>
+size_t concurrent_map<K, V, Hash, KeyEqual>::hashOf(const K &key) const {
+  size_t hash = static_cast<size_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+  return hash ^ (hash >> 32);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename concurrent_map<K, V, Hash, KeyEqual>::Shard &
+concurrent_map<K, V, Hash, KeyEqual>::shardFor(size_t hash) {
+  return shards_[(hash >> 40) & shard_mask_];
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+const typename concurrent_map<K, V, Hash, KeyEqual>::Shard &
+concurrent_map<K, V, Hash, KeyEqual>::shardFor(size_t hash) const {
+  return shards_[(hash >> 40) & shard_mask_];
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename concurrent_map<K, V, Hash, KeyEqual>::Entry *
+concurrent_map<K, V, Hash, KeyEqual>::Shard::find(
+    const K &key, size_t hash, const KeyEqual &equal) const {
+  if (buckets.empty()) {
+    return nullptr;
+  }
+  Entry *entry = buckets[hash & (buckets.size() - 1)];
+  while (entry != nullptr && !(entry->hash == hash && equal(entry->key, key))) {
+    entry = entry->next;
+  }
+  return entry;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void concurrent_map<K, V, Hash, KeyEqual>::Shard::add(Entry *entry) {
+  if (count >= buckets.size()) {
+    rehash();
+  }
+  Entry *&head = buckets[entry->hash & (buckets.size() - 1)];
+  entry->next = head;
+  head = entry;
+  ++count;
+  accounting.allocated(sizeof(Entry));
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void concurrent_map<K, V, Hash, KeyEqual>::Shard::rehash() {
+  vector<Entry *> grown(buckets.empty() ? 8 : buckets.size() * 2);
+  for (Entry *head : buckets) {
+    while (head != nullptr) {
+      Entry *next = head->next;
+      Entry *&slot = grown[head->hash & (grown.size() - 1)];
+      head->next = slot;
+      slot = head;
+      head = next;
+    }
+  }
+  buckets.swap(grown);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void concurrent_map<K, V, Hash, KeyEqual>::Shard::clear() {
+  for (Entry *&head : buckets) {
+    while (head != nullptr) {
+      Entry *next = head->next;
+      accounting.freed(sizeof(Entry));
+      delete head;
+      head = next;
+    }
+  }
+  count = 0;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+std::optional<V> concurrent_map<K, V, Hash, KeyEqual>::find(
+    const K &key) const {
+  size_t hash = hashOf(key);
+  const Shard &shard = shardFor(hash);
+  std::shared_lock lock(shard.mutex);
+  Entry *entry = shard.find(key, hash, equal_);
+  if (entry == nullptr) {
+    return std::nullopt;
+  }
+  return entry->value;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool concurrent_map<K, V, Hash, KeyEqual>::contains(const K &key) const {
+  size_t hash = hashOf(key);
+  const Shard &shard = shardFor(hash);
+  std::shared_lock lock(shard.mutex);
+  return shard.find(key, hash, equal_) != nullptr;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool concurrent_map<K, V, Hash, KeyEqual>::insert(const K &key,
+                                                  const V &value) {
+  size_t hash = hashOf(key);
+  Shard &shard = shardFor(hash);
+  std::unique_lock lock(shard.mutex);
+  if (shard.find(key, hash, equal_) != nullptr) {
+    return false;
+  }
+  shard.add(new Entry{key, value, hash, nullptr});
+  return true;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool concurrent_map<K, V, Hash, KeyEqual>::insert_or_assign(const K &key,
+                                                            const V &value) {
+  size_t hash = hashOf(key);
+  Shard &shard = shardFor(hash);
+  std::unique_lock lock(shard.mutex);
+  Entry *entry = shard.find(key, hash, equal_);
+  if (entry != nullptr) {
+    entry->value = value;
+    return false;
+  }
+  shard.add(new Entry{key, value, hash, nullptr});
+  return true;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool concurrent_map<K, V, Hash, KeyEqual>::erase(const K &key) {
+  size_t hash = hashOf(key);
+  Shard &shard = shardFor(hash);
+  std::unique_lock lock(shard.mutex);
+  if (shard.buckets.empty()) {
+    return false;
+  }
+  Entry **link = &shard.buckets[hash & (shard.buckets.size() - 1)];
+  while (*link != nullptr &&
+         !((*link)->hash == hash && equal_((*link)->key, key))) {
+    link = &(*link)->next;
+  }
+  Entry *entry = *link;
+  if (entry == nullptr) {
+    return false;
+  }
+  *link = entry->next;
+  shard.accounting.freed(sizeof(Entry));
+  delete entry;
+  --shard.count;
+  return true;
+}
+
+// The common case, a key that is already there, only takes the read lock.
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename F>
+V concurrent_map<K, V, Hash, KeyEqual>::compute_if_absent(const K &key,
+                                                          F &&make) {
+  size_t hash = hashOf(key);
+  Shard &shard = shardFor(hash);
+  {
+    std::shared_lock lock(shard.mutex);
+    if (Entry *entry = shard.find(key, hash, equal_)) {
+      return entry->value;
+    }
+  }
+  std::unique_lock lock(shard.mutex);
+  if (Entry *entry = shard.find(key, hash, equal_)) {
+    return entry->value;
+  }
+  Entry *entry = new Entry{key, std::forward<F>(make)(), hash, nullptr};
+  shard.add(entry);
+  return entry->value;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename F>
+bool concurrent_map<K, V, Hash, KeyEqual>::update(const K &key, F &&f) {
+  size_t hash = hashOf(key);
+  Shard &shard = shardFor(hash);
+  std::unique_lock lock(shard.mutex);
+  Entry *entry = shard.find(key, hash, equal_);
+  if (entry == nullptr) {
+    return false;
+  }
+  std::forward<F>(f)(entry->value);
+  return true;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void concurrent_map<K, V, Hash, KeyEqual>::clear() {
+  for (Shard &shard : shards_) {
+    std::unique_lock lock(shard.mutex);
+    shard.clear();
+  }
+}
+
+// Shards are counted one after another, so under concurrent writes the
+// total is only a momentary estimate.
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename concurrent_map<K, V, Hash, KeyEqual>::size_type
+concurrent_map<K, V, Hash, KeyEqual>::size() const {
+  size_type total = 0;
+  for (const Shard &shard : shards_) {
+    std::shared_lock lock(shard.mutex);
+    total += shard.count;
+  }
+  return total;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool concurrent_map<K, V, Hash, KeyEqual>::empty() const {
+  return size() == 0;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename concurrent_map<K, V, Hash, KeyEqual>::size_type
+concurrent_map<K, V, Hash, KeyEqual>::shard_count() const {
+  return shards_.size();
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+memory_stats concurrent_map<K, V, Hash, KeyEqual>::memory_usage() const {
+  memory_stats total = shards_.memory_usage();
+  for (const Shard &shard : shards_) {
+    std::shared_lock lock(shard.mutex);
+    memory_stats entries;
+    entries.live_bytes = shard.count * sizeof(Entry);
+    entries.nodes = shard.count;
+    shard.accounting.report(entries);
+    total += entries;
+    total += shard.buckets.memory_usage();
+  }
+  return total;
+}
@@ -0,0 +1,114 @@
+#ifndef SRC_S21_CONCURRENT_SKIPLIST_MAP_H_
+#define SRC_S21_CONCURRENT_SKIPLIST_MAP_H_
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <optional>
+#include <random>
+
+#include "s21_epoch.h"
+
+namespace s21 {
+
+// Ordered map that many threads may read and write at once without locks.
+// It is a skip list whose links carry a "deleted" mark in their low bit:
+// erase first marks a node's links (the mark on the bottom link is the
+// logical deletion) and the node is then physically unlinked by whichever
+// thread walks past it. Unlinked nodes are freed through epoch_domain, so
+// a thread that still holds a pointer to one never sees it reused.
+//
+// Values are immutable once inserted: find() returns a copy, and there is
+// no assignment. Iteration is weakly consistent: it never returns a node
+// twice or out of order and sees every key that was present for the whole
+// walk, but may or may not see concurrent inserts and erases. An iterator
+// pins its thread, so keep iterators short-lived and on one thread.
+template <typename K, typename V, typename Compare = std::less<>>
+class concurrent_skiplist_map {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  static constexpr int kMaxHeight = 24;
+
+ private:
+  using Link = std::atomic<uintptr_t>;
+
+  struct Node {
+    K first;
+    [[no_unique_address]] V second;
+    int height;
+    // Set to 2: the inserting thread and the erasing thread each drop one
+    // reference once they are done linking or unlinking the node.
+    std::atomic<int> owners;
+    Link *next;
+
+    Node(const K &key, const V &value, int levels);
+  };
+
+  mutable Link head_[kMaxHeight];
+  std::atomic<size_type> size_{0};
+  key_compare comp;
+
+  static Node *createNode(const K &key, const V &value, int height);
+  static void destroyNode(void *node);
+  static Node *pointer(uintptr_t link);
+  static bool marked(uintptr_t link);
+  static uintptr_t linkTo(Node *node);
+  static int randomHeight();
+
+  bool find(const K &key, Link **preds, Node **succs) const;
+  void unlinkAll(const K &key) const;
+  void release(Node *node) const;
+  Node *firstNotLess(const K &key) const;
+  static Node *skipDeleted(Node *node);
+
+ public:
+  class ConstIterator;
+
+  concurrent_skiplist_map();
+  explicit concurrent_skiplist_map(const Compare &compare);
+  concurrent_skiplist_map(const concurrent_skiplist_map &) = delete;
+  concurrent_skiplist_map &operator=(const concurrent_skiplist_map &) =
+      delete;
+  ~concurrent_skiplist_map();
+
+  bool insert(const K &key, const V &value);
+  bool erase(const K &key);
+  std::optional<V> find(const K &key) const;
+  bool contains(const K &key) const;
+
+  // Counts completed inserts and erases, so it is exact only when idle.
+  size_type size() const;
+  bool empty() const;
+  key_compare key_comp() const;
+
+  ConstIterator begin() const;
+  ConstIterator end() const;
+  ConstIterator lower_bound(const K &key) const;
+
+  class ConstIterator {
+   public:
+    bool operator==(const ConstIterator &other) const;
+    bool operator!=(const ConstIterator &other) const;
+    ConstIterator &operator++();
+    ConstIterator operator++(int);
+    const Node &operator*() const;
+    const Node *operator->() const;
+
+   private:
+    friend class concurrent_skiplist_map;
+    explicit ConstIterator(Node *node);
+    epoch_guard guard;
+    Node *current;
+  };
+};
+
+#include "s21_concurrent_skiplist_map.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_CONCURRENT_SKIPLIST_MAP_H_
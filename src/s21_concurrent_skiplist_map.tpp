@@ -0,0 +1,363 @@
+using namespace s21;
+
+template <typename K, typename V, typename Compare>
+concurrent_skiplist_map<K, V, Compare>::Node::Node(const K &key,
+                                                   const V &value, int levels)
+    : first(key),
+      second(value),
+      height(levels),
+      owners(2),
+      next(reinterpret_cast<Link *>(this + 1)) {}
+
+// A node and its tower of links share one allocation.
+template <typename K, typename V, typename Compare>
+typename concurrent_skiplist_map<K, V, Compare>::Node *
+concurrent_skiplist_map<K, V, Compare>::createNode(const K &key,
+                                                   const V &value,
+                                                   int height) {
+  static_assert(sizeof(Node) % alignof(Link) == 0);
+  void *memory = ::operator new(sizeof(Node) + height * sizeof(Link));
+  Node *node = new (memory) Node(key, value, height);
+  for (int level = 0; level < height; level++) {
+    new (&node->next[level]) Link(0);
+  }
+  return node;
+}
+
+template <typename K, typename V, typename Compare>
+void concurrent_skiplist_map<K, V, Compare>::destroyNode(void *node) {
+  static_cast<Node *>(node)->~Node();
+  ::operator delete(node);
+}
+
+template <typename K, typename V, typename Compare>
+typename concurrent_skiplist_map<K, V, Compare>::Node *
+concurrent_skiplist_map<K, V, Compare>::pointer(uintptr_t link) {
+  return reinterpret_cast<Node *>(link & ~uintptr_t(1));
+}
+
+template <typename K, typename V, typename Compare>
+bool concurrent_skiplist_map<K, V, Compare>::marked(uintptr_t link) {
+  return link & 1;
+}
+
+template <typename K, typename V, typename Compare>
+uintptr_t concurrent_skiplist_map<K, V, Compare>::linkTo(Node *node) {
+  return reinterpret_cast<uintptr_t>(node);
+}
+
+// Geometric with p = 1/2: one more level per trailing zero bit.
+template <typename K, typename V, typename Compare>
+int concurrent_skiplist_map<K, V, Compare>::randomHeight() {
+  thread_local std::minstd_rand rng(std::random_device{}());
+  uint32_t bits = static_cast<uint32_t>(rng()) | (1u << (kMaxHeight - 1));
+  return 1 + std::countr_zero(bits);
+}
+
+template <typename K, typename V, typename Compare>
+concurrent_skiplist_map<K, V, Compare>::concurrent_skiplist_map()
+    : concurrent_skiplist_map(Compare()) {}
+
+template <typename K, typename V, typename Compare>
+concurrent_skiplist_map<K, V, Compare>::concurrent_skiplist_map(
+    const Compare &compare)
+    : comp(compare) {
+  for (Link &link : head_) {
+    link.store(0, std::memory_order_relaxed);
+  }
+}
+
+// No other thread may use the map any more; nodes still linked at the
+// bottom level are exactly the live ones, erased nodes were retired.
+template <typename K, typename V, typename Compare>
+concurrent_skiplist_map<K, V, Compare>::~concurrent_skiplist_map() {
+  Node *node = pointer(head_[0].load());
+  while (node != nullptr) {
+    Node *next = pointer(node->next[0].load());
+    destroyNode(node);
+    node = next;
+  }
+}
+
+// Fills preds with the links to update and succs with the first node not
+// less than key on every level, snipping out marked nodes on the way.
+// Returns whether succs[0] holds key. Caller must be pinned.
+template <typename K, typename V, typename Compare>
+bool concurrent_skiplist_map<K, V, Compare>::find(const K &key, Link **preds,
+                                                  Node **succs) const {
+retry:
+  Link *pred = head_;
+  for (int level = kMaxHeight - 1; level >= 0; level--) {
+    Node *current = pointer(pred[level].load());
+    while (current != nullptr) {
+      uintptr_t succ = current->next[level].load();
+      if (marked(succ)) {
+        uintptr_t expected = linkTo(current);
+        if (!pred[level].compare_exchange_strong(expected, succ & ~1)) {
+          goto retry;
+        }
+        current = pointer(succ);
+      } else if (comp(current->first, key)) {
+        pred = current->next;
+        current = pointer(succ);
+      } else {
+        break;
+      }
+    }
+    preds[level] = pred;
+    succs[level] = current;
+  }
+  return succs[0] != nullptr && !comp(key, succs[0]->first);
+}
+
+// Walks every level through all nodes not greater than key and snips the
+// marked ones. Unlike find it does not stop at the first equal key, so a
+// deleted node sharing its key with a live one is unlinked too.
+template <typename K, typename V, typename Compare>
+void concurrent_skiplist_map<K, V, Compare>::unlinkAll(const K &key) const {
+retry:
+  Link *start = head_;
+  for (int level = kMaxHeight - 1; level >= 0; level--) {
+    Link *pred = start;
+    Node *current = pointer(pred[level].load());
+    while (current != nullptr) {
+      uintptr_t succ = current->next[level].load();
+      if (marked(succ)) {
+        uintptr_t expected = linkTo(current);
+        if (!pred[level].compare_exchange_strong(expected, succ & ~1)) {
+          goto retry;
+        }
+        current = pointer(succ);
+        continue;
+      }
+      if (comp(key, current->first)) {
+        break;
+      }
+      if (comp(current->first, key)) {
+        start = current->next;
+      }
+      pred = current->next;
+      current = pointer(succ);
+    }
+  }
+}
+
+template <typename K, typename V, typename Compare>
+void concurrent_skiplist_map<K, V, Compare>::release(Node *node) const {
+  if (node->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    epoch_domain::global().retire(node, destroyNode);
+  }
+}
+
+// The node is published by the bottom-level CAS; the upper levels are
+// linked afterwards and linking stops as soon as an erase marks the node.
+template <typename K, typename V, typename Compare>
+bool concurrent_skiplist_map<K, V, Compare>::insert(const K &key,
+                                                    const V &value) {
+  epoch_guard guard;
+  Link *preds[kMaxHeight];
+  Node *succs[kMaxHeight];
+  Node *node = nullptr;
+  while (true) {
+    if (find(key, preds, succs)) {
+      if (node != nullptr) {
+        destroyNode(node);
+      }
+      return false;
+    }
+    if (node == nullptr) {
+      node = createNode(key, value, randomHeight());
+    }
+    for (int level = 0; level < node->height; level++) {
+      node->next[level].store(linkTo(succs[level]),
+                              std::memory_order_relaxed);
+    }
+    uintptr_t expected = linkTo(succs[0]);
+    if (preds[0][0].compare_exchange_strong(expected, linkTo(node))) {
+      break;
+    }
+  }
+  size_.fetch_add(1);
+  for (int level = 1; level < node->height; level++) {
+    while (true) {
+      uintptr_t next = node->next[level].load();
+      if (marked(next) || !node->next[level].compare_exchange_strong(
+                              next, linkTo(succs[level]))) {
+        goto linked;
+      }
+      uintptr_t expected = linkTo(succs[level]);
+      if (preds[level][level].compare_exchange_strong(expected,
+                                                      linkTo(node))) {
+        break;
+      }
+      find(key, preds, succs);
+      if (marked(node->next[0].load())) {
+        goto linked;
+      }
+    }
+  }
+linked:
+  if (marked(node->next[0].load())) {
+    unlinkAll(key);
+  }
+  release(node);
+  return true;
+}
+
+// Marks the tower top-down; marking the bottom link is the linearization
+// point and decides which of several racing erases wins.
+template <typename K, typename V, typename Compare>
+bool concurrent_skiplist_map<K, V, Compare>::erase(const K &key) {
+  epoch_guard guard;
+  Link *preds[kMaxHeight];
+  Node *succs[kMaxHeight];
+  while (find(key, preds, succs)) {
+    Node *node = succs[0];
+    for (int level = node->height - 1; level >= 1; level--) {
+      uintptr_t next = node->next[level].load();
+      while (!marked(next) &&
+             !node->next[level].compare_exchange_weak(next, next | 1)) {
+      }
+    }
+    uintptr_t next = node->next[0].load();
+    while (!marked(next)) {
+      if (node->next[0].compare_exchange_weak(next, next | 1)) {
+        size_.fetch_sub(1);
+        unlinkAll(key);
+        release(node);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Read-only descent: marked nodes are stepped over, not snipped.
+template <typename K, typename V, typename Compare>
+typename concurrent_skiplist_map<K, V, Compare>::Node *
+concurrent_skiplist_map<K, V, Compare>::firstNotLess(const K &key) const {
+  Link *pred = head_;
+  Node *current = nullptr;
+  for (int level = kMaxHeight - 1; level >= 0; level--) {
+    current = pointer(pred[level].load());
+    while (current != nullptr && comp(current->first, key)) {
+      pred = current->next;
+      current = pointer(current->next[level].load());
+    }
+  }
+  return skipDeleted(current);
+}
+
+template <typename K, typename V, typename Compare>
+typename concurrent_skiplist_map<K, V, Compare>::Node *
+concurrent_skiplist_map<K, V, Compare>::skipDeleted(Node *node) {
+  while (node != nullptr) {
+    uintptr_t next = node->next[0].load();
+    if (!marked(next)) {
+      break;
+    }
+    node = pointer(next);
+  }
+  return node;
+}
+
+template <typename K, typename V, typename Compare>
+std::optional<V> concurrent_skiplist_map<K, V, Compare>::find(
+    const K &key) const {
+  epoch_guard guard;
+  Node *node = firstNotLess(key);
+  if (node == nullptr || comp(key, node->first)) {
+    return std::nullopt;
+  }
+  return node->second;
+}
+
+template <typename K, typename V, typename Compare>
+bool concurrent_skiplist_map<K, V, Compare>::contains(const K &key) const {
+  epoch_guard guard;
+  Node *node = firstNotLess(key);
+  return node != nullptr && !comp(key, node->first);
+}
+
+template <typename K, typename V, typename Compare>
+typename concurrent_skiplist_map<K, V, Compare>::size_type
+concurrent_skiplist_map<K, V, Compare>::size() const {
+  return size_.load();
+}
+
+template <typename K, typename V, typename Compare>
+bool concurrent_skiplist_map<K, V, Compare>::empty() const {
+  return size() == 0;
+}
+
+template <typename K, typename V, typename Compare>
+typename concurrent_skiplist_map<K, V, Compare>::key_compare
+concurrent_skiplist_map<K, V, Compare>::key_comp() const {
+  return comp;
+}
+
+template <typename K, typename V, typename Compare>
+typename concurrent_skiplist_map<K, V, Compare>::ConstIterator
+concurrent_skiplist_map<K, V, Compare>::begin() const {
+  epoch_guard guard;
+  return ConstIterator(skipDeleted(pointer(head_[0].load())));
+}
+
+template <typename K, typename V, typename Compare>
+typename concurrent_skiplist_map<K, V, Compare>::ConstIterator
+concurrent_skiplist_map<K, V, Compare>::end() const {
+  return ConstIterator(nullptr);
+}
+
+template <typename K, typename V, typename Compare>
+typename concurrent_skiplist_map<K, V, Compare>::ConstIterator
+concurrent_skiplist_map<K, V, Compare>::lower_bound(const K &key) const {
+  epoch_guard guard;
+  return ConstIterator(firstNotLess(key));
+}
+
+template <typename K, typename V, typename Compare>
+concurrent_skiplist_map<K, V, Compare>::ConstIterator::ConstIterator(
+    Node *node)
+    : current(node) {}
+
+template <typename K, typename V, typename Compare>
+bool concurrent_skiplist_map<K, V, Compare>::ConstIterator::operator==(
+    const ConstIterator &other) const {
+  return current == other.current;
+}
+
+template <typename K, typename V, typename Compare>
+bool concurrent_skiplist_map<K, V, Compare>::ConstIterator::operator!=(
+    const ConstIterator &other) const {
+  return current != other.current;
+}
+
+template <typename K, typename V, typename Compare>
+typename concurrent_skiplist_map<K, V, Compare>::ConstIterator &
+concurrent_skiplist_map<K, V, Compare>::ConstIterator::operator++() {
+  if (current != nullptr) {
+    current = skipDeleted(pointer(current->next[0].load()));
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename Compare>
+typename concurrent_skiplist_map<K, V, Compare>::ConstIterator
+concurrent_skiplist_map<K, V, Compare>::ConstIterator::operator++(int) {
+  ConstIterator tmp = *this;
+  ++*this;
+  return tmp;
+}
+
+template <typename K, typename V, typename Compare>
+const typename concurrent_skiplist_map<K, V, Compare>::Node &
+concurrent_skiplist_map<K, V, Compare>::ConstIterator::operator*() const {
+  return *current;
+}
+
+template <typename K, typename V, typename Compare>
+const typename concurrent_skiplist_map<K, V, Compare>::Node *
+concurrent_skiplist_map<K, V, Compare>::ConstIterator::operator->() const {
+  return current;
+}
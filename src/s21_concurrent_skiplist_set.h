@@ -0,0 +1,61 @@
+#ifndef SRC_S21_CONCURRENT_SKIPLIST_SET_H_
+#define SRC_S21_CONCURRENT_SKIPLIST_SET_H_
+
+#include <functional>
+
+#include "s21_concurrent_skiplist_map.h"
+
+namespace s21 {
+
+// Lock-free ordered set: a concurrent_skiplist_map whose mapped value takes
+// no space. Same concurrency guarantees as the map.
+template <typename T, typename Compare = std::less<>>
+class concurrent_skiplist_set {
+  struct Empty {};
+  using Map = concurrent_skiplist_map<T, Empty, Compare>;
+
+ public:
+  using key_type = T;
+  using value_type = T;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  class ConstIterator;
+
+  concurrent_skiplist_set() = default;
+  explicit concurrent_skiplist_set(const Compare &compare);
+
+  bool insert(const T &value);
+  bool erase(const T &value);
+  bool contains(const T &value) const;
+  size_type size() const;
+  bool empty() const;
+  key_compare key_comp() const;
+
+  ConstIterator begin() const;
+  ConstIterator end() const;
+  ConstIterator lower_bound(const T &value) const;
+
+  class ConstIterator {
+   public:
+    bool operator==(const ConstIterator &other) const;
+    bool operator!=(const ConstIterator &other) const;
+    ConstIterator &operator++();
+    ConstIterator operator++(int);
+    const T &operator*() const;
+    const T *operator->() const;
+
+   private:
+    friend class concurrent_skiplist_set;
+    explicit ConstIterator(typename Map::ConstIterator it) : it_(it) {}
+    typename Map::ConstIterator it_;
+  };
+
+ private:
+  Map map_;
+};
+
+#include "s21_concurrent_skiplist_set.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_CONCURRENT_SKIPLIST_SET_H_
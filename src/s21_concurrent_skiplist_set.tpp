@@ -0,0 +1,95 @@
+using namespace s21;
+
+template <typename T, typename Compare>
+concurrent_skiplist_set<T, Compare>::concurrent_skiplist_set(
+    const Compare &compare)
+    : map_(compare) {}
+
+template <typename T, typename Compare>
+bool concurrent_skiplist_set<T, Compare>::insert(const T &value) {
+  return map_.insert(value, Empty());
+}
+
+template <typename T, typename Compare>
+bool concurrent_skiplist_set<T, Compare>::erase(const T &value) {
+  return map_.erase(value);
+}
+
+template <typename T, typename Compare>
+bool concurrent_skiplist_set<T, Compare>::contains(const T &value) const {
+  return map_.contains(value);
+}
+
+template <typename T, typename Compare>
+typename concurrent_skiplist_set<T, Compare>::size_type
+concurrent_skiplist_set<T, Compare>::size() const {
+  return map_.size();
+}
+
+template <typename T, typename Compare>
+bool concurrent_skiplist_set<T, Compare>::empty() const {
+  return map_.empty();
+}
+
+template <typename T, typename Compare>
+typename concurrent_skiplist_set<T, Compare>::key_compare
+concurrent_skiplist_set<T, Compare>::key_comp() const {
+  return map_.key_comp();
+}
+
+template <typename T, typename Compare>
+typename concurrent_skiplist_set<T, Compare>::ConstIterator
+concurrent_skiplist_set<T, Compare>::begin() const {
+  return ConstIterator(map_.begin());
+}
+
+template <typename T, typename Compare>
+typename concurrent_skiplist_set<T, Compare>::ConstIterator
+concurrent_skiplist_set<T, Compare>::end() const {
+  return ConstIterator(map_.end());
+}
+
+template <typename T, typename Compare>
+typename concurrent_skiplist_set<T, Compare>::ConstIterator
+concurrent_skiplist_set<T, Compare>::lower_bound(const T &value) const {
+  return ConstIterator(map_.lower_bound(value));
+}
+
+template <typename T, typename Compare>
+bool concurrent_skiplist_set<T, Compare>::ConstIterator::operator==(
+    const ConstIterator &other) const {
+  return it_ == other.it_;
+}
+
+template <typename T, typename Compare>
+bool concurrent_skiplist_set<T, Compare>::ConstIterator::operator!=(
+    const ConstIterator &other) const {
+  return it_ != other.it_;
+}
+
+template <typename T, typename Compare>
+typename concurrent_skiplist_set<T, Compare>::ConstIterator &
+concurrent_skiplist_set<T, Compare>::ConstIterator::operator++() {
+  ++it_;
+  return *this;
+}
+
+template <typename T, typename Compare>
+typename concurrent_skiplist_set<T, Compare>::ConstIterator
+concurrent_skiplist_set<T, Compare>::ConstIterator::operator++(int) {
+  ConstIterator tmp = *this;
+  ++it_;
+  return tmp;
+}
+
+template <typename T, typename Compare>
+const T &concurrent_skiplist_set<T, Compare>::ConstIterator::operator*()
+    const {
+  return it_->first;
+}
+
+template <typename T, typename Compare>
+const T *concurrent_skiplist_set<T, Compare>::ConstIterator::operator->()
+    const {
+  return &it_->first;
+}
@@ -1,11 +1,30 @@
 #ifndef SRC_S21_CONTAINERS_H_
 #define SRC_S21_CONTAINERS_H_
 
+#include "s21_concurrent_map.h"
+#include "s21_concurrent_skiplist_map.h"
+#include "s21_concurrent_skiplist_set.h"
+#include "s21_flat_map.h"
+#include "s21_flat_set.h"
 #include "s21_list.h"
+#include "s21_lru_cache.h"
 #include "s21_map.h"
+#include "s21_memory_stats.h"
+#include "s21_mmap_vector.h"
+#include "s21_parallel.h"
+#include "s21_persistent_map.h"
 #include "s21_queue.h"
+#include "s21_radix_sort.h"
+#include "s21_serialize.h"
 #include "s21_set.h"
+#include "s21_set_algebra.h"
+#include "s21_small_vector.h"
+#include "s21_soa_vector.h"
 #include "s21_stack.h"
+#include "s21_static_map.h"
+#include "s21_static_set.h"
+#include "s21_trace.h"
 #include "s21_vector.h"
+#include "s21_vector_simd.h"
 
 #endif  //  SRC_S21_CONTAINERS_H_
\ No newline at end of file
@@ -0,0 +1,179 @@
+#ifndef SRC_S21_EPOCH_H_
+#define SRC_S21_EPOCH_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Epoch-based reclamation for the lock-free containers.
+//
+// A thread reading shared nodes holds an epoch_guard. A node that has
+// been unlinked is retire()d together with its deleter and stamped with
+// the global epoch at that moment. The global epoch only moves forward
+// once every pinned thread has observed the current one, so two steps
+// later no guard that could still reach the node is alive, and the
+// retiring thread frees it. Each thread keeps its garbage in three
+// per-epoch buckets on its own record, so retiring and freeing never
+// synchronise with other threads. When a thread exits, its record (and
+// any garbage left on it) is taken over by the next thread that needs one.
+class epoch_domain {
+ public:
+  using deleter_type = void (*)(void *);
+
+  // The one domain. Each thread's record lives in a thread_local shared
+  // by every use of the class, so there can be no second instance.
+  static epoch_domain &global() {
+    static epoch_domain domain;
+    return domain;
+  }
+
+  epoch_domain(const epoch_domain &) = delete;
+  epoch_domain &operator=(const epoch_domain &) = delete;
+  ~epoch_domain() {
+    Record *record = records_.load();
+    while (record != nullptr) {
+      Record *next = record->next;
+      for (int bucket = 0; bucket < kBuckets; bucket++) {
+        freeBucket(*record, bucket);
+      }
+      delete record;
+      record = next;
+    }
+  }
+
+  // Guards nest: only the outermost one on a thread pins and unpins it.
+  void enter() {
+    Record &record = localRecord();
+    if (record.nesting++ == 0) {
+      uint64_t epoch = epoch_.load();
+      record.epoch.store(epoch);
+      reclaim(record, epoch);
+    }
+  }
+
+  void leave() {
+    Record &record = localRecord();
+    if (--record.nesting == 0) {
+      record.epoch.store(kIdle, std::memory_order_release);
+    }
+  }
+
+  // ptr must already be unreachable for threads that pin from now on.
+  void retire(void *ptr, deleter_type deleter) {
+    Record &record = localRecord();
+    uint64_t epoch = epoch_.load();
+    int bucket = epoch % kBuckets;
+    if (record.stamp[bucket] != epoch) {
+      // Same bucket, older stamp: at least kBuckets epochs old, so safe.
+      freeBucket(record, bucket);
+      record.stamp[bucket] = epoch;
+    }
+    record.limbo[bucket].push_back({ptr, deleter});
+    if (record.limbo[bucket].size() >= kAdvanceThreshold && tryAdvance()) {
+      reclaim(record, epoch_.load());
+    }
+  }
+
+  uint64_t epoch() const { return epoch_.load(); }
+
+ private:
+  epoch_domain() = default;
+
+  static constexpr uint64_t kIdle = ~uint64_t(0);
+  static constexpr int kBuckets = 3;
+  static constexpr size_t kAdvanceThreshold = 64;
+
+  struct Retired {
+    void *ptr;
+    deleter_type deleter;
+  };
+
+  struct alignas(64) Record {
+    std::atomic<uint64_t> epoch{kIdle};
+    std::atomic<bool> in_use{true};
+    Record *next = nullptr;
+    int nesting = 0;
+    vector<Retired> limbo[kBuckets];
+    uint64_t stamp[kBuckets] = {0, 0, 0};
+  };
+
+  // Hands the record back when its thread exits.
+  struct Owner {
+    Record *record = nullptr;
+    ~Owner() {
+      if (record != nullptr) {
+        record->in_use.store(false, std::memory_order_release);
+      }
+    }
+  };
+
+  std::atomic<uint64_t> epoch_{0};
+  std::atomic<Record *> records_{nullptr};
+
+  Record &localRecord() {
+    thread_local Owner owner;
+    if (owner.record == nullptr) {
+      owner.record = acquireRecord();
+    }
+    return *owner.record;
+  }
+
+  // Records are never unlinked, so the list can be walked without locks.
+  Record *acquireRecord() {
+    for (Record *record = records_.load(); record != nullptr;
+         record = record->next) {
+      bool expected = false;
+      if (record->in_use.compare_exchange_strong(expected, true)) {
+        return record;
+      }
+    }
+    Record *record = new Record;
+    record->next = records_.load();
+    while (!records_.compare_exchange_weak(record->next, record)) {
+    }
+    return record;
+  }
+
+  bool tryAdvance() {
+    uint64_t epoch = epoch_.load();
+    for (Record *record = records_.load(); record != nullptr;
+         record = record->next) {
+      uint64_t seen = record->epoch.load();
+      if (seen != kIdle && seen != epoch) {
+        return false;
+      }
+    }
+    return epoch_.compare_exchange_strong(epoch, epoch + 1);
+  }
+
+  void reclaim(Record &record, uint64_t epoch) {
+    for (int bucket = 0; bucket < kBuckets; bucket++) {
+      if (!record.limbo[bucket].empty() && record.stamp[bucket] + 2 <= epoch) {
+        freeBucket(record, bucket);
+      }
+    }
+  }
+
+  static void freeBucket(Record &record, int bucket) {
+    for (const Retired &retired : record.limbo[bucket]) {
+      retired.deleter(retired.ptr);
+    }
+    record.limbo[bucket].clear();
+  }
+};
+
+// Pins the calling thread for the guard's lifetime.
+class epoch_guard {
+ public:
+  epoch_guard() { epoch_domain::global().enter(); }
+  epoch_guard(const epoch_guard &) : epoch_guard() {}
+  epoch_guard &operator=(const epoch_guard &) { return *this; }
+  ~epoch_guard() { epoch_domain::global().leave(); }
+};
+
+}  // namespace s21
+
+#endif  //  SRC_S21_EPOCH_H_
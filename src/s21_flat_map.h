@@ -0,0 +1,151 @@
+#ifndef SRC_S21_FLAT_MAP_H_
+#define SRC_S21_FLAT_MAP_H_
+
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_flat_set.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Sorted-array map: keys and mapped values live in two parallel vectors so a
+// lookup only touches the key array.
+template <typename K, typename V>
+class flat_map {
+  template <bool IsConst>
+  class FlatIterator;
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<key_type, mapped_type>;
+  using reference = std::pair<const key_type &, mapped_type &>;
+  using const_reference = std::pair<const key_type &, const mapped_type &>;
+  using iterator = FlatIterator<false>;
+  using const_iterator = FlatIterator<true>;
+  using size_type = size_t;
+
+  flat_map() = default;
+  flat_map(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  flat_map(InputIt first, InputIt last);
+  flat_map(const flat_map &other) = default;
+  flat_map(flat_map &&other) noexcept;
+  ~flat_map() = default;
+  flat_map &operator=(const flat_map &other) = default;
+  flat_map &operator=(flat_map &&other) noexcept;
+
+  V &at(const K &key);
+  const V &at(const K &key) const;
+  V &operator[](const K &key);
+
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  bool empty() const;
+  size_type size() const;
+  size_type max_size();
+  void reserve(size_type size);
+  void shrink_to_fit();
+  memory_stats memory_usage() const;
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(const K &key, const V &obj);
+  std::pair<iterator, bool> insert_or_assign(const K &key, const V &obj);
+  template <typename InputIt>
+  void insert_range(InputIt first, InputIt last);
+  void erase(iterator pos);
+  size_type erase(const K &key);
+  void swap(flat_map &other);
+
+  iterator find(const K &key);
+  const_iterator find(const K &key) const;
+  bool contains(const K &key) const;
+  size_type count(const K &key) const;
+  iterator lower_bound(const K &key);
+  const_iterator lower_bound(const K &key) const;
+
+  const vector<K> &keys() const;
+  const vector<V> &values() const;
+
+ private:
+  vector<K> keys_;
+  vector<V> values_;
+
+  size_type lowerIndex(const K &key) const;
+  size_type findIndex(const K &key) const;
+  static void sortUnique(vector<K> &keys, vector<V> &values);
+};
+
+template <typename K, typename V>
+template <bool IsConst>
+class flat_map<K, V>::FlatIterator {
+  friend class flat_map;
+  using value_pointer = std::conditional_t<IsConst, const V *, V *>;
+
+ public:
+  using reference =
+      std::pair<const K &, std::conditional_t<IsConst, const V &, V &>>;
+
+  struct ArrowProxy {
+    reference pair;
+    const reference *operator->() const { return &pair; }
+  };
+
+  FlatIterator() : key_(nullptr), value_(nullptr) {}
+  FlatIterator(const K *key, value_pointer value) : key_(key), value_(value) {}
+  operator FlatIterator<true>() const
+    requires(!IsConst)
+  {
+    return {key_, value_};
+  }
+
+  reference operator*() const { return reference(*key_, *value_); }
+  ArrowProxy operator->() const { return ArrowProxy{**this}; }
+  const K &key() const { return *key_; }
+  auto &value() const { return *value_; }
+
+  FlatIterator &operator++() {
+    ++key_;
+    ++value_;
+    return *this;
+  }
+  FlatIterator operator++(int) {
+    FlatIterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  FlatIterator &operator--() {
+    --key_;
+    --value_;
+    return *this;
+  }
+  FlatIterator operator--(int) {
+    FlatIterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+  bool operator==(const FlatIterator &other) const {
+    return key_ == other.key_;
+  }
+  bool operator!=(const FlatIterator &other) const {
+    return key_ != other.key_;
+  }
+
+ private:
+  const K *key_;
+  value_pointer value_;
+};
+
+#include "s21_flat_map.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_FLAT_MAP_H_
@@ -0,0 +1,287 @@
+using namespace s21;
+
+template <typename K, typename V>
+flat_map<K, V>::flat_map(std::initializer_list<value_type> const &items)
+    : flat_map(items.begin(), items.end()) {}
+
+template <typename K, typename V>
+template <typename InputIt>
+flat_map<K, V>::flat_map(InputIt first, InputIt last) {
+  for (; first != last; ++first) {
+    keys_.push_back(first->first);
+    values_.push_back(first->second);
+  }
+  sortUnique(keys_, values_);
+}
+
+template <typename K, typename V>
+flat_map<K, V>::flat_map(flat_map &&other) noexcept {
+  swap(other);
+}
+
+template <typename K, typename V>
+flat_map<K, V> &flat_map<K, V>::operator=(flat_map &&other) noexcept {
+  if (this != &other) {
+    swap(other);
+    other.clear();
+  }
+  return *this;
+}
+
+template <typename K, typename V>
+void flat_map<K, V>::sortUnique(vector<K> &keys, vector<V> &values) {
+  vector<size_type> order(keys.size());
+  for (size_type i = 0; i < order.size(); i++) order[i] = i;
+  std::stable_sort(order.begin(), order.end(),
+                   [&keys](size_type a, size_type b) {
+                     return keys[a] < keys[b];
+                   });
+  vector<K> sorted_keys;
+  vector<V> sorted_values;
+  sorted_keys.reserve(keys.size());
+  sorted_values.reserve(values.size());
+  for (size_type i : order) {
+    if (sorted_keys.empty() || sorted_keys.back() < keys[i]) {
+      sorted_keys.push_back(keys[i]);
+      sorted_values.push_back(values[i]);
+    }
+  }
+  keys.swap(sorted_keys);
+  values.swap(sorted_values);
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::size_type flat_map<K, V>::lowerIndex(
+    const K &key) const {
+  return flat_lower_bound(keys_.data(), keys_.size(), key) - keys_.data();
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::size_type flat_map<K, V>::findIndex(
+    const K &key) const {
+  size_type index = lowerIndex(key);
+  return (index != keys_.size() && !(key < keys_[index])) ? index
+                                                           : keys_.size();
+}
+
+template <typename K, typename V>
+V &flat_map<K, V>::at(const K &key) {
+  size_type index = findIndex(key);
+  if (index == keys_.size()) {
+    throw std::out_of_range("Key not found");
+  }
+  return values_[index];
+}
+
+template <typename K, typename V>
+const V &flat_map<K, V>::at(const K &key) const {
+  size_type index = findIndex(key);
+  if (index == keys_.size()) {
+    throw std::out_of_range("Key not found");
+  }
+  return values_[index];
+}
+
+template <typename K, typename V>
+V &flat_map<K, V>::operator[](const K &key) {
+  return insert(key, V()).first.value();
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::iterator flat_map<K, V>::begin() {
+  return iterator(keys_.data(), values_.data());
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::iterator flat_map<K, V>::end() {
+  return iterator(keys_.data() + keys_.size(),
+                  values_.data() + values_.size());
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::const_iterator flat_map<K, V>::begin() const {
+  return const_iterator(keys_.data(), values_.data());
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::const_iterator flat_map<K, V>::end() const {
+  return const_iterator(keys_.data() + keys_.size(),
+                        values_.data() + values_.size());
+}
+
+template <typename K, typename V>
+bool flat_map<K, V>::empty() const {
+  return keys_.empty();
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::size_type flat_map<K, V>::size() const {
+  return keys_.size();
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::size_type flat_map<K, V>::max_size() {
+  return std::numeric_limits<size_type>::max() / (sizeof(K) + sizeof(V));
+}
+
+template <typename K, typename V>
+void flat_map<K, V>::reserve(size_type size) {
+  keys_.reserve(size);
+  values_.reserve(size);
+}
+
+template <typename K, typename V>
+void flat_map<K, V>::shrink_to_fit() {
+  keys_.shrink_to_fit();
+  values_.shrink_to_fit();
+}
+
+template <typename K, typename V>
+memory_stats flat_map<K, V>::memory_usage() const {
+  memory_stats stats = keys_.memory_usage();
+  stats += values_.memory_usage();
+  return stats;
+}
+
+template <typename K, typename V>
+void flat_map<K, V>::clear() {
+  keys_.clear();
+  values_.clear();
+}
+
+template <typename K, typename V>
+std::pair<typename flat_map<K, V>::iterator, bool> flat_map<K, V>::insert(
+    const value_type &value) {
+  return insert(value.first, value.second);
+}
+
+template <typename K, typename V>
+std::pair<typename flat_map<K, V>::iterator, bool> flat_map<K, V>::insert(
+    const K &key, const V &obj) {
+  size_type index = lowerIndex(key);
+  bool inserted = index == keys_.size() || key < keys_[index];
+  if (inserted) {
+    keys_.insert(keys_.begin() + index, key);
+    values_.insert(values_.begin() + index, obj);
+  }
+  return std::make_pair(iterator(keys_.data() + index, values_.data() + index),
+                        inserted);
+}
+
+template <typename K, typename V>
+std::pair<typename flat_map<K, V>::iterator, bool>
+flat_map<K, V>::insert_or_assign(const K &key, const V &obj) {
+  std::pair<iterator, bool> result = insert(key, obj);
+  if (!result.second) {
+    result.first.value() = obj;
+  }
+  return result;
+}
+
+template <typename K, typename V>
+template <typename InputIt>
+void flat_map<K, V>::insert_range(InputIt first, InputIt last) {
+  vector<K> incoming_keys;
+  vector<V> incoming_values;
+  for (; first != last; ++first) {
+    incoming_keys.push_back(first->first);
+    incoming_values.push_back(first->second);
+  }
+  sortUnique(incoming_keys, incoming_values);
+  vector<K> merged_keys;
+  vector<V> merged_values;
+  merged_keys.reserve(keys_.size() + incoming_keys.size());
+  merged_values.reserve(keys_.size() + incoming_keys.size());
+  size_type a = 0;
+  size_type b = 0;
+  while (a < keys_.size() && b < incoming_keys.size()) {
+    if (incoming_keys[b] < keys_[a]) {
+      merged_keys.push_back(incoming_keys[b]);
+      merged_values.push_back(incoming_values[b++]);
+    } else {
+      if (!(keys_[a] < incoming_keys[b])) ++b;
+      merged_keys.push_back(keys_[a]);
+      merged_values.push_back(values_[a++]);
+    }
+  }
+  for (; a < keys_.size(); ++a) {
+    merged_keys.push_back(keys_[a]);
+    merged_values.push_back(values_[a]);
+  }
+  for (; b < incoming_keys.size(); ++b) {
+    merged_keys.push_back(incoming_keys[b]);
+    merged_values.push_back(incoming_values[b]);
+  }
+  keys_.swap(merged_keys);
+  values_.swap(merged_values);
+}
+
+template <typename K, typename V>
+void flat_map<K, V>::erase(iterator pos) {
+  size_type index = pos.key_ - keys_.data();
+  keys_.erase(keys_.begin() + index);
+  values_.erase(values_.begin() + index);
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::size_type flat_map<K, V>::erase(const K &key) {
+  size_type index = findIndex(key);
+  if (index == keys_.size()) {
+    return 0;
+  }
+  keys_.erase(keys_.begin() + index);
+  values_.erase(values_.begin() + index);
+  return 1;
+}
+
+template <typename K, typename V>
+void flat_map<K, V>::swap(flat_map &other) {
+  keys_.swap(other.keys_);
+  values_.swap(other.values_);
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::iterator flat_map<K, V>::find(const K &key) {
+  size_type index = findIndex(key);
+  return iterator(keys_.data() + index, values_.data() + index);
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::const_iterator flat_map<K, V>::find(
+    const K &key) const {
+  size_type index = findIndex(key);
+  return const_iterator(keys_.data() + index, values_.data() + index);
+}
+
+template <typename K, typename V>
+bool flat_map<K, V>::contains(const K &key) const {
+  return findIndex(key) != keys_.size();
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::size_type flat_map<K, V>::count(const K &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::iterator flat_map<K, V>::lower_bound(const K &key) {
+  size_type index = lowerIndex(key);
+  return iterator(keys_.data() + index, values_.data() + index);
+}
+
+template <typename K, typename V>
+typename flat_map<K, V>::const_iterator flat_map<K, V>::lower_bound(
+    const K &key) const {
+  size_type index = lowerIndex(key);
+  return const_iterator(keys_.data() + index, values_.data() + index);
+}
+
+template <typename K, typename V>
+const vector<K> &flat_map<K, V>::keys() const {
+  return keys_;
+}
+
+template <typename K, typename V>
+const vector<V> &flat_map<K, V>::values() const {
+  return values_;
+}
@@ -0,0 +1,73 @@
+#ifndef SRC_S21_FLAT_SET_H_
+#define SRC_S21_FLAT_SET_H_
+
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Lower bound over a sorted array without a data-dependent branch in the
+// loop: the comparison result only selects the next base pointer.
+template <typename T, typename Key>
+const T *flat_lower_bound(const T *first, size_t n, const Key &key);
+
+template <typename T>
+class flat_set {
+ public:
+  using key_type = T;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = const T *;
+  using const_iterator = const T *;
+  using size_type = size_t;
+
+  flat_set() = default;
+  flat_set(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  flat_set(InputIt first, InputIt last);
+  flat_set(const flat_set &other) = default;
+  flat_set(flat_set &&other) noexcept;
+  ~flat_set() = default;
+  flat_set &operator=(const flat_set &other) = default;
+  flat_set &operator=(flat_set &&other) noexcept;
+
+  iterator begin() const;
+  iterator end() const;
+
+  bool empty() const;
+  size_type size() const;
+  size_type max_size();
+  size_type capacity() const;
+  void reserve(size_type size);
+  void shrink_to_fit();
+  memory_stats memory_usage() const;
+
+  void clear();
+  std::pair<iterator, bool> insert(const_reference value);
+  template <typename InputIt>
+  void insert_range(InputIt first, InputIt last);
+  void erase(iterator pos);
+  size_type erase(const_reference key);
+  void swap(flat_set &other);
+
+  iterator find(const_reference key) const;
+  bool contains(const_reference key) const;
+  size_type count(const_reference key) const;
+  iterator lower_bound(const_reference key) const;
+  iterator upper_bound(const_reference key) const;
+
+ private:
+  vector<T> keys_;
+
+  static void sortUnique(vector<T> &keys);
+};
+
+#include "s21_flat_set.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_FLAT_SET_H_
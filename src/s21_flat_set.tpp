@@ -0,0 +1,183 @@
+using namespace s21;
+
+template <typename T, typename Key>
+const T *flat_lower_bound(const T *first, size_t n, const Key &key) {
+  if (n == 0) {
+    return first;
+  }
+  while (n > 1) {
+    size_t half = n / 2;
+    first = (first[half - 1] < key) ? first + half : first;
+    n -= half;
+  }
+  return first + (*first < key);
+}
+
+template <typename T>
+flat_set<T>::flat_set(std::initializer_list<value_type> const &items)
+    : flat_set(items.begin(), items.end()) {}
+
+template <typename T>
+template <typename InputIt>
+flat_set<T>::flat_set(InputIt first, InputIt last) {
+  for (; first != last; ++first) {
+    keys_.push_back(*first);
+  }
+  sortUnique(keys_);
+}
+
+template <typename T>
+flat_set<T>::flat_set(flat_set &&other) noexcept {
+  keys_.swap(other.keys_);
+}
+
+template <typename T>
+flat_set<T> &flat_set<T>::operator=(flat_set &&other) noexcept {
+  if (this != &other) {
+    keys_.swap(other.keys_);
+    other.clear();
+  }
+  return *this;
+}
+
+template <typename T>
+void flat_set<T>::sortUnique(vector<T> &keys) {
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+template <typename T>
+typename flat_set<T>::iterator flat_set<T>::begin() const {
+  return keys_.begin();
+}
+
+template <typename T>
+typename flat_set<T>::iterator flat_set<T>::end() const {
+  return keys_.end();
+}
+
+template <typename T>
+bool flat_set<T>::empty() const {
+  return keys_.empty();
+}
+
+template <typename T>
+typename flat_set<T>::size_type flat_set<T>::size() const {
+  return keys_.size();
+}
+
+template <typename T>
+typename flat_set<T>::size_type flat_set<T>::max_size() {
+  return std::numeric_limits<size_type>::max() / sizeof(value_type);
+}
+
+template <typename T>
+typename flat_set<T>::size_type flat_set<T>::capacity() const {
+  return keys_.capacity();
+}
+
+template <typename T>
+void flat_set<T>::reserve(size_type size) {
+  keys_.reserve(size);
+}
+
+template <typename T>
+void flat_set<T>::shrink_to_fit() {
+  keys_.shrink_to_fit();
+}
+
+template <typename T>
+memory_stats flat_set<T>::memory_usage() const {
+  return keys_.memory_usage();
+}
+
+template <typename T>
+void flat_set<T>::clear() {
+  keys_.clear();
+}
+
+template <typename T>
+std::pair<typename flat_set<T>::iterator, bool> flat_set<T>::insert(
+    const_reference value) {
+  iterator pos = lower_bound(value);
+  if (pos != end() && !(value < *pos)) {
+    return std::make_pair(pos, false);
+  }
+  return std::make_pair(keys_.insert(keys_.begin() + (pos - begin()), value),
+                        true);
+}
+
+template <typename T>
+template <typename InputIt>
+void flat_set<T>::insert_range(InputIt first, InputIt last) {
+  vector<T> incoming;
+  for (; first != last; ++first) {
+    incoming.push_back(*first);
+  }
+  sortUnique(incoming);
+  vector<T> merged;
+  merged.reserve(keys_.size() + incoming.size());
+  const T *a = keys_.begin();
+  const T *b = incoming.begin();
+  while (a != keys_.end() && b != incoming.end()) {
+    if (*b < *a) {
+      merged.push_back(*b++);
+    } else {
+      if (!(*a < *b)) ++b;
+      merged.push_back(*a++);
+    }
+  }
+  for (; a != keys_.end(); ++a) merged.push_back(*a);
+  for (; b != incoming.end(); ++b) merged.push_back(*b);
+  keys_.swap(merged);
+}
+
+template <typename T>
+void flat_set<T>::erase(iterator pos) {
+  keys_.erase(keys_.begin() + (pos - begin()));
+}
+
+template <typename T>
+typename flat_set<T>::size_type flat_set<T>::erase(const_reference key) {
+  iterator pos = find(key);
+  if (pos == end()) {
+    return 0;
+  }
+  erase(pos);
+  return 1;
+}
+
+template <typename T>
+void flat_set<T>::swap(flat_set &other) {
+  keys_.swap(other.keys_);
+}
+
+template <typename T>
+typename flat_set<T>::iterator flat_set<T>::find(const_reference key) const {
+  iterator pos = lower_bound(key);
+  return (pos != end() && !(key < *pos)) ? pos : end();
+}
+
+template <typename T>
+bool flat_set<T>::contains(const_reference key) const {
+  return find(key) != end();
+}
+
+template <typename T>
+typename flat_set<T>::size_type flat_set<T>::count(
+    const_reference key) const {
+  return contains(key) ? 1 : 0;
+}
+
+template <typename T>
+typename flat_set<T>::iterator flat_set<T>::lower_bound(
+    const_reference key) const {
+  return flat_lower_bound(keys_.data(), keys_.size(), key);
+}
+
+template <typename T>
+typename flat_set<T>::iterator flat_set<T>::upper_bound(
+    const_reference key) const {
+  iterator pos = lower_bound(key);
+  return (pos != end() && !(key < *pos)) ? pos + 1 : pos;
+}
@@ -3,6 +3,12 @@
 #define SRC_S21_LIST_H_
 #include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_memory_stats.h"
+#include "s21_radix_sort.h"
+#include "s21_trace.h"
 
 namespace s21 {
 template <class T>
@@ -85,13 +91,29 @@ class list {
   void reverse();
   void unique();
   void sort();
+  // Stable LSD radix sort by the element, or by key(element), for the key
+  // types of s21_radix_sort.h. Nodes are relinked into 256 bucket chains
+  // per digit, so elements are never moved or copied.
+  void radix_sort()
+    requires radix_key<T>;
+  template <typename Key>
+  void radix_sort(Key key);
   void insertConst(const_iterator pos, const_reference value);
   void print();  // TODO delete
+  memory_stats memory_usage() const;
 
  private:
   size_t size_;
   Node *head_;
   Node *tail_;
+  [[no_unique_address]] memory_counter<memory_category::list> accounting_;
+  Node *createNode();
+  void destroyNode(Node *node);
+  static Node *cut(Node *node, size_type n);
+  static Node *mergeRuns(Node *a, Node *b);
+  void relinkPrev();
+  template <typename Bits>
+  void radixSortBy(Bits bits);
 };
 #include "s21_list.tpp"
 };      // namespace s21
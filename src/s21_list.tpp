@@ -1,10 +1,12 @@
 using namespace s21;
 
 template <class T>
-list<T>::list() : head_(nullptr), tail_(nullptr) {}
+list<T>::list() : size_(0), head_(nullptr), tail_(nullptr) {}
 
 template <class T>
-list<T>::list(size_type n) : size_(n), head_(nullptr), tail_(nullptr) {}
+list<T>::list(size_type n) : size_(0), head_(nullptr), tail_(nullptr) {
+  for (size_type i = 0; i < n; ++i) push_back(value_type());
+}
 
 template <class T>
 [[nodiscard]] list<T>::list(std::initializer_list<T> const &items)
@@ -28,18 +30,7 @@ list<T>::list(list &&other) : size_(0), head_(nullptr), tail_(nullptr) {
 
 template <class T>
 list<T>::~list() {
-  if (head_ != nullptr) {
-    Node *temp;
-    temp = head_;
-    while (temp != nullptr) {
-      head_->next = nullptr;
-      temp = head_->prev;
-      head_->prev = nullptr;
-      delete head_;
-      head_ = temp;
-    }
-    head_ = nullptr;
-  }
+  clear();
 };
 
 template <class T>
@@ -76,12 +67,18 @@ typename list<T>::const_iterator list<T>::beginConst() {
 
 template <class T>
 T list<T>::ListIterator::operator*() {
-  return iter_ ? iter_->data : 0;
+  if (iter_ == nullptr) {
+    throw std::runtime_error("Dereferencing null iterator");
+  }
+  return iter_->data;
 };
 
 template <class T>
 T list<T>::ListConstIterator::operator*() {
-  return iter_ ? iter_->data : 0;
+  if (iter_ == nullptr) {
+    throw std::runtime_error("Dereferencing null iterator");
+  }
+  return iter_->data;
 };
 
 template <class T>
@@ -137,7 +134,10 @@ typename list<T>::size_type list<T>::size() {
 
 template <class T>
 typename list<T>::size_type list<T>::max_size() {
-  return static_cast<size_type>(pow(2, sizeof(void *) * 8) / sizeof(list) - 1);
+  // The list's own fields, so the answer does not depend on whether
+  // memory accounting is compiled in.
+  const size_type footprint = sizeof(size_t) + 2 * sizeof(Node *);
+  return static_cast<size_type>(pow(2, sizeof(void *) * 8) / footprint - 1);
 };
 
 // List Modifiers
@@ -145,7 +145,7 @@ template <class T>
 void list<T>::clear() {
   while (head_) {
     tail_ = head_->next;
-    delete head_;
+    destroyNode(head_);
     head_ = tail_;
   }
   size_ = 0;
@@ -160,7 +160,7 @@ typename list<T>::iterator list<T>::insert(iterator pos,
     push_front(value);
   } else {
     ++size_;
-    Node *buf = new Node;
+    Node *buf = createNode();
     Node *it = pos.iter_;
     buf->data = value;
     buf->prev = it->prev;
@@ -180,7 +180,7 @@ void list<T>::insertConst(const_iterator pos, const_reference value) {
     push_front(value);
   } else {
     ++size_;
-    Node *buf = new Node;
+    Node *buf = createNode();
     Node *it = pos.iter_;
     buf->data = value;
     buf->prev = it->prev;
@@ -201,7 +201,7 @@ void list<T>::erase(iterator pos) {
     if (pos.iter_ == tail_) tail_ = pos.iter_->prev;
     if (pos.iter_->prev) pos.iter_->prev->next = pos.iter_->next;
     if (pos.iter_->next) pos.iter_->next->prev = pos.iter_->prev;
-    delete pos.iter_;
+    destroyNode(pos.iter_);
     pos.iter_ = nullptr;
   }
 };
@@ -209,7 +209,7 @@ void list<T>::erase(iterator pos) {
 template <class T>
 void list<T>::push_back(const_reference value) {
   size_++;
-  Node *buf = new Node;
+  Node *buf = createNode();
   buf->data = value;
   buf->prev = tail_;
   buf->next = nullptr;
@@ -227,16 +227,20 @@ void list<T>::pop_back() {
   if (tail_ != nullptr) {
     size_--;
     Node *buf = tail_->prev;
-    delete tail_;
+    destroyNode(tail_);
     tail_ = buf;
-    tail_->next = nullptr;
+    if (tail_ != nullptr) {
+      tail_->next = nullptr;
+    } else {
+      head_ = nullptr;
+    }
   };
 };
 
 template <class T>
 void list<T>::push_front(const_reference value) {
   size_++;
-  Node *buf = new Node;
+  Node *buf = createNode();
   buf->data = value;
   buf->prev = nullptr;
   buf->next = head_;
@@ -252,9 +256,13 @@ void list<T>::push_front(const_reference value) {
 template <class T>
 void list<T>::pop_front() {
   if (head_ != nullptr) {
+    Node *buf = head_;
     head_ = head_->next;
+    destroyNode(buf);
     if (head_ != nullptr) {
       head_->prev = nullptr;
+    } else {
+      tail_ = nullptr;
     }
     size_--;
   }
@@ -264,72 +272,214 @@ template <class T>
 void list<T>::swap(list &other) {
   std::swap(head_, other.head_);
   std::swap(tail_, other.tail_);
+  accounting_.exchange(other.accounting_, size_ * sizeof(Node),
+                       other.size_ * sizeof(Node));
   std::swap(size_, other.size_);
 };
 
+// Both lists are expected to be sorted, as with std::list::merge. Nodes
+// are relinked, never copied; on equal elements those of *this go first.
 template <class T>
 void list<T>::merge(list &other) {
-  const_iterator it = endConst();
-  this->splice(it, other);
-  sort();
-};
+  trace_scope trace(trace_op::list_merge);
+  if (this == &other || other.head_ == nullptr) {
+    return;
+  }
+  head_ = mergeRuns(head_, other.head_);
+  relinkPrev();
+  accounting_.adopted(other.size_ * sizeof(Node));
+  other.accounting_.released(other.size_ * sizeof(Node));
+  size_ += other.size_;
+  other.size_ = 0;
+  other.head_ = nullptr;
+  other.tail_ = nullptr;
+}
 
+// Moves every node of other in front of pos in constant time.
 template <class T>
 void list<T>::splice(const_iterator pos, list &other) {
-  iterator it = other.begin();
-  for (size_t i = 0; i < other.size(); ++i) {
-    insertConst(pos, *it);
-    ++it;
+  trace_scope trace(trace_op::list_splice);
+  if (this == &other || other.head_ == nullptr) {
+    return;
   }
-  other.clear();
-};
+  Node *before = (pos.iter_ != nullptr) ? pos.iter_->prev : tail_;
+  other.head_->prev = before;
+  other.tail_->next = pos.iter_;
+  if (before != nullptr) {
+    before->next = other.head_;
+  } else {
+    head_ = other.head_;
+  }
+  if (pos.iter_ != nullptr) {
+    pos.iter_->prev = other.tail_;
+  } else {
+    tail_ = other.tail_;
+  }
+  accounting_.adopted(other.size_ * sizeof(Node));
+  other.accounting_.released(other.size_ * sizeof(Node));
+  size_ += other.size_;
+  other.size_ = 0;
+  other.head_ = nullptr;
+  other.tail_ = nullptr;
+}
 
 template <class T>
 void list<T>::reverse() {
+  for (Node *node = head_; node != nullptr; node = node->prev) {
+    std::swap(node->prev, node->next);
+  }
+  std::swap(head_, tail_);
+}
+
+// Removes consecutive duplicates, keeping the first of each run.
+template <class T>
+void list<T>::unique() {
+  trace_scope trace(trace_op::list_unique);
   if (size_ < 2) {
     return;
   }
-  s21::list<T> tmp(0);
-  for (Node *it_i = head_; it_i != nullptr; it_i = it_i->next) {
-    tmp.push_front(it_i->data);
-  }
-  for (Node *it_i = head_, *it_j = tmp.head_; it_i != nullptr;
-       it_i = it_i->next, it_j = it_j->next) {
-    it_i->data = it_j->data;
+  Node *node = head_;
+  while (node->next != nullptr) {
+    trace_comparison();
+    if (node->next->data == node->data) {
+      Node *duplicate = node->next;
+      node->next = duplicate->next;
+      if (duplicate->next != nullptr) {
+        duplicate->next->prev = node;
+      } else {
+        tail_ = node;
+      }
+      destroyNode(duplicate);
+      size_--;
+    } else {
+      node = node->next;
+    }
   }
-};
+}
 
+// Stable bottom-up merge sort over the next links: runs of width 1, 2,
+// 4, ... are merged pairwise, so it takes O(n log n) comparisons and no
+// memory beyond the nodes. prev links are repaired in one pass at the end.
 template <class T>
-void list<T>::unique() {
+void list<T>::sort() {
+  trace_scope trace(trace_op::list_sort);
   if (size_ < 2) {
     return;
   }
-  for (iterator it_i = begin(); it_i != end(); ++it_i) {
-    iterator it_k = it_i;
-    ++it_k;
-    for (iterator it_j = it_k; it_j != end(); ++it_j) {
-      if (it_i.iter_->data == it_j.iter_->data) this->erase(it_j);
-    };
-  };
-};
+  for (size_type width = 1; width < size_; width *= 2) {
+    Node *rest = head_;
+    Node **tail = &head_;
+    while (rest != nullptr) {
+      Node *a = rest;
+      Node *b = cut(a, width);
+      rest = cut(b, width);
+      *tail = mergeRuns(a, b);
+      while (*tail != nullptr) {
+        tail = &(*tail)->next;
+      }
+    }
+  }
+  relinkPrev();
+}
 
 template <class T>
-void list<T>::sort() {
+void list<T>::radix_sort()
+  requires radix_key<T>
+{
+  radixSortBy([](const T &x) { return radix_detail::ordered(x); });
+}
+
+template <class T>
+template <typename Key>
+void list<T>::radix_sort(Key key) {
+  radixSortBy(
+      [&key](const T &x) { return radix_detail::ordered(key(x)); });
+}
+
+// A digit on which every key agrees is skipped; the bits that differ
+// anywhere are those set in some key ^ the first key.
+template <class T>
+template <typename Bits>
+void list<T>::radixSortBy(Bits bits) {
+  using namespace radix_detail;
+  using U = std::decay_t<std::invoke_result_t<Bits &, const T &>>;
+  constexpr int kPasses = sizeof(U) * 8 / kDigitBits;
+  trace_scope trace(trace_op::list_sort);
   if (size_ < 2) {
     return;
   }
-  value_type tmp;
-
-  for (Node *it_i = head_; it_i != nullptr; it_i = it_i->next) {
-    for (Node *it_j = head_; it_j != nullptr; it_j = it_j->next) {
-      if (it_j->data > it_i->data) {
-        tmp = it_j->data;
-        it_j->data = it_i->data;
-        it_i->data = tmp;
+  U first = bits(head_->data);
+  U differ = 0;
+  for (Node *node = head_->next; node != nullptr; node = node->next) {
+    differ |= bits(node->data) ^ first;
+  }
+  for (int pass = 0; pass < kPasses; pass++) {
+    if (digit(differ, pass) == 0) {
+      continue;
+    }
+    Node *heads[kBuckets] = {};
+    Node **tails[kBuckets];
+    for (size_t b = 0; b < kBuckets; b++) {
+      tails[b] = &heads[b];
+    }
+    for (Node *node = head_; node != nullptr; node = node->next) {
+      size_t b = digit(bits(node->data), pass);
+      *tails[b] = node;
+      tails[b] = &node->next;
+    }
+    Node **tail = &head_;
+    for (size_t b = 0; b < kBuckets; b++) {
+      if (heads[b] != nullptr) {
+        *tail = heads[b];
+        tail = tails[b];
       }
     }
+    *tail = nullptr;
   }
+  relinkPrev();
 }
+
+// Detaches the first n nodes of the chain starting at node and returns
+// what follows them.
+template <class T>
+typename list<T>::Node *list<T>::cut(Node *node, size_type n) {
+  for (size_type i = 1; node != nullptr && i < n; ++i) {
+    node = node->next;
+  }
+  if (node == nullptr) {
+    return nullptr;
+  }
+  Node *rest = node->next;
+  node->next = nullptr;
+  return rest;
+}
+
+// Merges two sorted chains linked through next; ties go to a.
+template <class T>
+typename list<T>::Node *list<T>::mergeRuns(Node *a, Node *b) {
+  Node *merged = nullptr;
+  Node **tail = &merged;
+  while (a != nullptr && b != nullptr) {
+    trace_comparison();
+    Node *&next = (b->data < a->data) ? b : a;
+    *tail = next;
+    tail = &next->next;
+    next = next->next;
+  }
+  *tail = (a != nullptr) ? a : b;
+  return merged;
+}
+
+template <class T>
+void list<T>::relinkPrev() {
+  Node *prev = nullptr;
+  for (Node *node = head_; node != nullptr; node = node->next) {
+    node->prev = prev;
+    prev = node;
+  }
+  tail_ = prev;
+}
+
 template <class T>
 void list<T>::print() {
   if (empty()) return;
@@ -339,4 +489,26 @@ void list<T>::print() {
     p = p->next;
   }
   std::cout << std::endl;
-}
\ No newline at end of file
+}
+
+template <class T>
+typename list<T>::Node *list<T>::createNode() {
+  Node *node = new Node;
+  accounting_.allocated(sizeof(Node));
+  return node;
+}
+
+template <class T>
+void list<T>::destroyNode(Node *node) {
+  accounting_.freed(sizeof(Node));
+  delete node;
+}
+
+template <class T>
+memory_stats list<T>::memory_usage() const {
+  memory_stats stats;
+  stats.live_bytes = size_ * sizeof(Node);
+  stats.nodes = size_;
+  accounting_.report(stats);
+  return stats;
+}
@@ -0,0 +1,105 @@
+#ifndef SRC_S21_LRU_CACHE_H_
+#define SRC_S21_LRU_CACHE_H_
+
+#include <functional>
+#include <utility>
+
+#include "s21_memory_stats.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Bounded cache that evicts the least recently used entry. Every entry is
+// a single node that is at once a hash-chain element and a link in the
+// recency list, so get, put and eviction are O(1) and cost one allocation
+// per entry.
+//
+// The bound is a total cost: by default every entry costs 1, which caps
+// the number of entries; a cost function (e.g. the value's byte size)
+// turns it into a byte budget. An entry costing more than the whole
+// capacity is evicted as soon as it is put.
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class lru_cache {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using size_type = size_t;
+  using cost_function = std::function<size_type(const K &, const V &)>;
+  using eviction_callback = std::function<void(const K &, V &)>;
+
+  struct stats_type {
+    size_type hits = 0;
+    size_type misses = 0;
+    size_type evictions = 0;
+  };
+
+  explicit lru_cache(size_type capacity);
+  lru_cache(size_type capacity, cost_function cost);
+  lru_cache(const lru_cache &) = delete;
+  lru_cache &operator=(const lru_cache &) = delete;
+  ~lru_cache();
+
+  // Returns the cached value and marks it most recently used, or nullptr.
+  // Counts a hit or a miss.
+  V *get(const K &key);
+  // Looks without touching recency or the counters.
+  const V *peek(const K &key) const;
+  bool contains(const K &key) const;
+  // Inserts or replaces the value, marks it most recently used and evicts
+  // from the cold end until the cost fits. Returns whether key was new.
+  bool put(const K &key, const V &value);
+  bool erase(const K &key);
+  void clear();
+
+  // Called with each entry pushed out by the capacity limit (not with
+  // entries removed by erase or clear) just before it is destroyed.
+  void set_eviction_callback(eviction_callback callback);
+
+  size_type size() const;
+  bool empty() const;
+  size_type cost() const;
+  size_type capacity() const;
+  stats_type stats() const;
+  void reset_stats();
+  // Entries plus the bucket array.
+  memory_stats memory_usage() const;
+
+ private:
+  struct Entry {
+    K key;
+    V value;
+    size_t hash;
+    size_type cost;
+    Entry *chain;
+    Entry *newer;
+    Entry *older;
+  };
+
+  vector<Entry *> buckets_;
+  Entry *newest_ = nullptr;
+  Entry *oldest_ = nullptr;
+  size_type size_ = 0;
+  size_type cost_ = 0;
+  size_type capacity_;
+  cost_function cost_of_;
+  eviction_callback on_evict_;
+  stats_type stats_;
+  Hash hash_;
+  KeyEqual equal_;
+  [[no_unique_address]] memory_counter<memory_category::lru_cache>
+      accounting_;
+
+  size_t hashOf(const K &key) const;
+  Entry **slot(const K &key, size_t hash) const;
+  void pushNewest(Entry *entry);
+  void unlinkRecency(Entry *entry);
+  void remove(Entry **link);
+  void evictToFit();
+  void rehash();
+};
+
+#include "s21_lru_cache.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_LRU_CACHE_H_
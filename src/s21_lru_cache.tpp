@@ -0,0 +1,222 @@
+using namespace s21;
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+lru_cache<K, V, Hash, KeyEqual>::lru_cache(size_type capacity)
+    : lru_cache(capacity, nullptr) {}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+lru_cache<K, V, Hash, KeyEqual>::lru_cache(size_type capacity,
+                                           cost_function cost)
+    : buckets_(8), capacity_(capacity), cost_of_(std::move(cost)) {}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+lru_cache<K, V, Hash, KeyEqual>::~lru_cache() {
+  clear();
+}
+
+// std::hash is the identity for integers, so keys that are multiples of
+// the bucket count would share one chain. The product moves every input
+// bit into the high half, which is folded back onto the low bits that
+// pick the bucket.
+template <typename K, typename V, typename Hash, typename KeyEqual>
+size_t lru_cache<K, V, Hash, KeyEqual>::hashOf(const K &key) const {
+  size_t hash = static_cast<size_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+  return hash ^ (hash >> 32);
+}
+
+// Returns the chain link that points at key's entry, or the null link at
+// the end of its chain.
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename lru_cache<K, V, Hash, KeyEqual>::Entry **
+lru_cache<K, V, Hash, KeyEqual>::slot(const K &key, size_t hash) const {
+  Entry **link =
+      const_cast<Entry **>(&buckets_[hash & (buckets_.size() - 1)]);
+  while (*link != nullptr &&
+         !((*link)->hash == hash && equal_((*link)->key, key))) {
+    link = &(*link)->chain;
+  }
+  return link;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void lru_cache<K, V, Hash, KeyEqual>::pushNewest(Entry *entry) {
+  entry->newer = nullptr;
+  entry->older = newest_;
+  if (newest_ != nullptr) {
+    newest_->newer = entry;
+  } else {
+    oldest_ = entry;
+  }
+  newest_ = entry;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void lru_cache<K, V, Hash, KeyEqual>::unlinkRecency(Entry *entry) {
+  (entry->newer ? entry->newer->older : newest_) = entry->older;
+  (entry->older ? entry->older->newer : oldest_) = entry->newer;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void lru_cache<K, V, Hash, KeyEqual>::remove(Entry **link) {
+  Entry *entry = *link;
+  *link = entry->chain;
+  unlinkRecency(entry);
+  cost_ -= entry->cost;
+  --size_;
+  accounting_.freed(sizeof(Entry));
+  delete entry;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void lru_cache<K, V, Hash, KeyEqual>::evictToFit() {
+  while (cost_ > capacity_ && oldest_ != nullptr) {
+    Entry *victim = oldest_;
+    if (on_evict_) {
+      on_evict_(victim->key, victim->value);
+    }
+    ++stats_.evictions;
+    remove(slot(victim->key, victim->hash));
+  }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void lru_cache<K, V, Hash, KeyEqual>::rehash() {
+  vector<Entry *> grown(buckets_.size() * 2);
+  for (Entry *entry = newest_; entry != nullptr; entry = entry->older) {
+    Entry *&head = grown[entry->hash & (grown.size() - 1)];
+    entry->chain = head;
+    head = entry;
+  }
+  buckets_.swap(grown);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+V *lru_cache<K, V, Hash, KeyEqual>::get(const K &key) {
+  Entry *entry = *slot(key, hashOf(key));
+  if (entry == nullptr) {
+    ++stats_.misses;
+    return nullptr;
+  }
+  ++stats_.hits;
+  if (entry != newest_) {
+    unlinkRecency(entry);
+    pushNewest(entry);
+  }
+  return &entry->value;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+const V *lru_cache<K, V, Hash, KeyEqual>::peek(const K &key) const {
+  Entry *entry = *slot(key, hashOf(key));
+  return entry ? &entry->value : nullptr;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool lru_cache<K, V, Hash, KeyEqual>::contains(const K &key) const {
+  return peek(key) != nullptr;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool lru_cache<K, V, Hash, KeyEqual>::put(const K &key, const V &value) {
+  size_t hash = hashOf(key);
+  size_type cost = cost_of_ ? cost_of_(key, value) : 1;
+  Entry **link = slot(key, hash);
+  bool inserted = *link == nullptr;
+  if (inserted) {
+    *link = new Entry{key, value, hash, cost, nullptr, nullptr, nullptr};
+    accounting_.allocated(sizeof(Entry));
+    pushNewest(*link);
+    ++size_;
+  } else {
+    Entry *entry = *link;
+    entry->value = value;
+    cost_ -= entry->cost;
+    entry->cost = cost;
+    if (entry != newest_) {
+      unlinkRecency(entry);
+      pushNewest(entry);
+    }
+  }
+  cost_ += cost;
+  evictToFit();
+  if (size_ > buckets_.size()) {
+    rehash();
+  }
+  return inserted;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool lru_cache<K, V, Hash, KeyEqual>::erase(const K &key) {
+  Entry **link = slot(key, hashOf(key));
+  if (*link == nullptr) {
+    return false;
+  }
+  remove(link);
+  return true;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void lru_cache<K, V, Hash, KeyEqual>::clear() {
+  while (newest_ != nullptr) {
+    Entry *entry = newest_;
+    newest_ = entry->older;
+    accounting_.freed(sizeof(Entry));
+    delete entry;
+  }
+  oldest_ = nullptr;
+  for (Entry *&head : buckets_) {
+    head = nullptr;
+  }
+  size_ = 0;
+  cost_ = 0;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void lru_cache<K, V, Hash, KeyEqual>::set_eviction_callback(
+    eviction_callback callback) {
+  on_evict_ = std::move(callback);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename lru_cache<K, V, Hash, KeyEqual>::size_type
+lru_cache<K, V, Hash, KeyEqual>::size() const {
+  return size_;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool lru_cache<K, V, Hash, KeyEqual>::empty() const {
+  return size_ == 0;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename lru_cache<K, V, Hash, KeyEqual>::size_type
+lru_cache<K, V, Hash, KeyEqual>::cost() const {
+  return cost_;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename lru_cache<K, V, Hash, KeyEqual>::size_type
+lru_cache<K, V, Hash, KeyEqual>::capacity() const {
+  return capacity_;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename lru_cache<K, V, Hash, KeyEqual>::stats_type
+lru_cache<K, V, Hash, KeyEqual>::stats() const {
+  return stats_;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void lru_cache<K, V, Hash, KeyEqual>::reset_stats() {
+  stats_ = stats_type();
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+memory_stats lru_cache<K, V, Hash, KeyEqual>::memory_usage() const {
+  memory_stats stats;
+  stats.live_bytes = size_ * sizeof(Entry);
+  stats.nodes = size_;
+  accounting_.report(stats);
+  stats += buckets_.memory_usage();
+  return stats;
+}
@@ -1,12 +1,29 @@
 #ifndef CPP2_S21_CONTAINERS_1_S21_MAP_H
 #define CPP2_S21_CONTAINERS_1_S21_MAP_H
 
+#include <bit>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "s21_memory_stats.h"
+#include "s21_rb_tree.h"
+#include "s21_serialize.h"
+#include "s21_trace.h"
+#include "s21_tree_compare.h"
 namespace s21 {
-template <typename K, typename V>
+template <typename K, typename V, typename Compare = std::less<>>
 class map {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<key_type, mapped_type>;
+  using size_type = size_t;
+  using key_compare = Compare;
+
  private:
   struct Node {
     K first;
@@ -14,81 +31,184 @@ class map {
     Node *left;
     Node *right;
     Node *parent;
+    bool red;
 
-    Node(K key, V value, Node *node)
-        : first(key),
-          second(value),
+    template <typename KeyArg, typename... Args>
+    Node(Node *node, KeyArg &&key, Args &&...args)
+        : first(std::forward<KeyArg>(key)),
+          second(std::forward<Args>(args)...),
           left(nullptr),
           right(nullptr),
-          parent(node) {}
+          parent(node),
+          red(false) {}
   };
 
-  using key_type = K;
-  using mapped_type = V;
-  using value_type = std::pair<key_type, mapped_type>;
-  using size_type = size_t;
-
   Node *root = nullptr;
-  Node *insert(Node *node, K key, V value, Node *parent);
-  Node *remove(Node *node, K key);
-  Node *search(Node *node, K key) const;
+  key_compare comp;
+  [[no_unique_address]] memory_counter<memory_category::map> accounting_;
+  template <typename... Args>
+  Node *createNode(Args &&...args);
+  void destroyNode(Node *node);
+  static void destroyDetached(Node *node);
+  template <typename Key>
+  Node *search(const Key &key) const;
+  template <typename Key>
+  Node *findSlot(const Key &key, Node *&parent, bool &left) const;
+  Node *attach(Node *node, Node *parent, bool left);
   void clear(Node *node);
-  int count(Node *node, K key);
-  int size(Node *node);
-  bool empty(Node *node);
-  Node *begin(Node *node);
-  Node *end(Node *node);
-  void copyTree(const Node *srcNode, Node *srcParent, Node *&destNode);
   int size_ = 0;
-  void updateParentPointers(Node *node);
+  void detach(Node *node);
+  void unlink(Node *node);
+  static Node *leftmost(Node *node);
+  static Node *rightmost(Node *node);
+  static Node *successor(Node *node);
+  static Node *predecessor(Node *node);
+
+  // Bulk helpers. A "list" is a chain of nodes linked through right.
+  static Node *flatten(Node *node);
+  Node *cloneList(Node *node);
+  bool isSorted(const Node *list) const;
+  Node *sortList(Node *&list, size_type n);
+  size_type dropDuplicates(Node *list);
 
  public:
+  class Iterator;
+  class node_type;
+  struct insert_return_type;
+
   map() : root(nullptr) {}
+  explicit map(const Compare &compare);
   map(map &&other) noexcept;
   map(std::initializer_list<value_type> initList);
+  template <typename InputIt>
+  map(InputIt first, InputIt last, const Compare &compare = Compare());
   map(const map &mp);
   ~map();
-  void insert(K key, V value);
-  void erase(K key);
-  bool contains(K key) const;
-  const V &operator[](K key) const;
-  V &at(K key);
-  V &at(K key, V value);
-  V &operator[](K key);
-  int count(K key);
-  int size();
-  size_type max_size();
-  bool empty();
-  Node *begin();
-  Node *end();
+  void insert(const K &key, const V &value);
+  void erase(const K &key);
+  bool contains(const K &key) const;
+  V &at(const K &key);
+  const V &at(const K &key) const;
+  V &operator[](const K &key);
+  V &operator[](K &&key);
+  int count(const K &key) const;
+  Iterator find(const K &key);
+  int size() const;
+  size_type max_size() const;
+  bool empty() const;
+  Iterator begin();
+  Iterator end();
+  Iterator begin() const;
+  Iterator end() const;
   void swap(map &other);
   void merge(map &other);
-  map<K, V> &operator=(map &&other) noexcept;
+  map &operator=(map &&other) noexcept;
+  key_compare key_comp() const;
+  memory_stats memory_usage() const;
+
+  // Diagnostics, both O(n). stats() describes the tree's shape; validate()
+  // checks key order, parent links, the red-black rules and size().
+  tree_stats stats() const;
+  bool validate() const;
+
+  // Binary snapshot in the format of s21_serialize.h. load() replaces the
+  // contents, linking the nodes into a balanced tree in O(n) when the keys
+  // arrive in order, as save() writes them; if it throws, the map is
+  // unchanged.
+  void save(std::ostream &out) const;
+  void load(std::istream &in);
 
+  // Cuts the elements into at most parts runs of similar length for
+  // walking from several threads: run i is [cuts[i], cuts[i + 1]), the
+  // first cut is begin() and the last end(). O(parts + height).
+  std::vector<Iterator> split(size_t parts) const;
+
+  // Heterogeneous lookup, available when key_compare is transparent.
+  template <typename Key>
+  bool contains(const Key &key) const
+    requires transparent_compare<key_compare>;
+  template <typename Key>
+  V &at(const Key &key)
+    requires transparent_compare<key_compare>;
+  template <typename Key>
+  const V &at(const Key &key) const
+    requires transparent_compare<key_compare>;
+  template <typename Key>
+  int count(const Key &key) const
+    requires transparent_compare<key_compare>;
+  template <typename Key>
+  Iterator find(const Key &key)
+    requires transparent_compare<key_compare>;
+  template <typename Key>
+  void erase(const Key &key)
+    requires transparent_compare<key_compare>;
+
+  // Bidirectional in-order iterator. end() is represented by a null node;
+  // the owning map is kept so that --end() can reach the last element.
   class Iterator {
    private:
+    friend class map;
     Node *current;
-    Node *treeRoot;
-    Node *findLeftmost(Node *node);
+    const map *owner;
 
    public:
-    Iterator(Node *root);
+    Iterator(Node *node, const map *tree);
+    bool operator==(const Iterator &other) const;
     bool operator!=(const Iterator &other) const;
-    Iterator &operator++(int);
-    Iterator &operator--(int);
+    Iterator &operator++();
+    Iterator operator++(int);
     Iterator &operator--();
+    Iterator operator--(int);
     const Node &operator*() const;
     const Node *operator->() const;
-    Iterator &operator=(const Iterator &other) const;
-
-   private:
-    Node *find(Node *node, const K &key);
   };
 
  public:
-  std::pair<typename map<K, V>::Iterator, bool> insert(const value_type &value);
+  std::pair<Iterator, bool> insert(const value_type &value);
   template <typename... Args>
-  std::pair<typename map<K, V>::Iterator, bool> emplace(Args &&...args);
+  std::pair<Iterator, bool> emplace(Args &&...args);
+
+  // Upserts. Both walk the tree once; try_emplace constructs the mapped
+  // value in place only when the key is absent.
+  template <typename... Args>
+  std::pair<Iterator, bool> try_emplace(const K &key, Args &&...args);
+  template <typename... Args>
+  std::pair<Iterator, bool> try_emplace(K &&key, Args &&...args);
+  template <typename M>
+  std::pair<Iterator, bool> insert_or_assign(const K &key, M &&obj);
+  template <typename M>
+  std::pair<Iterator, bool> insert_or_assign(K &&key, M &&obj);
+
+  // Node handles. extract unlinks a node and hands over ownership;
+  // inserting the handle relinks the same node, so entries move between
+  // maps without allocating or copying the key and value.
+  node_type extract(const K &key);
+  node_type extract(Iterator pos);
+  insert_return_type insert(node_type &&handle);
+
+  class node_type {
+   public:
+    node_type() : node(nullptr) {}
+    node_type(node_type &&other) noexcept;
+    node_type &operator=(node_type &&other) noexcept;
+    ~node_type();
+
+    bool empty() const;
+    explicit operator bool() const;
+    K &key() const;
+    V &mapped() const;
+
+   private:
+    friend class map;
+    explicit node_type(Node *owned) : node(owned) {}
+    Node *node;
+  };
+
+  struct insert_return_type {
+    Iterator position;
+    bool inserted;
+    node_type node;
+  };
 };
 
 #include "s21_map.tpp"
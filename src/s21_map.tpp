@@ -1,433 +1,832 @@
 using namespace s21;
 
-template <typename K, typename V>
-typename map<K, V>::Node *map<K, V>::insert(Node *node, K key, V value,
-                                            Node *parent) {
-  if (node == nullptr) {
-    size_++;
-    return new Node(key, value, parent);
-  }
-  if (key < node->first) {
-    node->left = insert(node->left, key, value, node);
-  } else if (key > node->first) {
-    node->right = insert(node->right, key, value, node);
+template <typename K, typename V, typename Compare>
+void map<K, V, Compare>::insert(const K &key, const V &value) {
+  insert_or_assign(key, value);
+}
 
-  } else {
-    node->second = value;
-  }
-  return node;
+template <typename K, typename V, typename Compare>
+void map<K, V, Compare>::detach(Node *node) {
+  rb_tree::erase(root, node);
+  node->left = nullptr;
+  node->right = nullptr;
+  node->parent = nullptr;
+  size_--;
 }
 
-template <typename K, typename V>
-void map<K, V>::insert(K key, V value) {
-  root = insert(root, key, value, nullptr);
+template <typename K, typename V, typename Compare>
+void map<K, V, Compare>::unlink(Node *node) {
+  detach(node);
+  destroyNode(node);
 }
 
-template <typename K, typename V>
-typename map<K, V>::Node *map<K, V>::remove(Node *node, K key) {
-  if (node == nullptr) {
-    return nullptr;
-  }
-  if (key == node->first) {
-    Node *temp;
-    if (node->left == nullptr && node->right == nullptr) {
-      delete node;
-      size_--;
-      return nullptr;
-    } else if (node->left == nullptr) {
-      temp = node->right;
-      delete node;
-      size_--;
-      return temp;
-    } else if (node->right == nullptr) {
-      temp = node->left;
-      delete node;
-      size_--;
-      return temp;
+template <typename K, typename V, typename Compare>
+void map<K, V, Compare>::erase(const K &key) {
+  trace_scope trace(trace_op::map_erase);
+  Node *node = search(key);
+  if (node != nullptr) {
+    unlink(node);
+  }
+}
+
+template <typename K, typename V, typename Compare>
+template <typename Key>
+typename map<K, V, Compare>::Node *map<K, V, Compare>::search(
+    const Key &key) const {
+  trace_scope trace(trace_op::map_lookup);
+  Node *node = root;
+  while (node != nullptr) {
+    trace_comparison();
+    int order = compare_keys(comp, key, node->first);
+    if (order < 0) {
+      node = node->left;
+    } else if (order > 0) {
+      node = node->right;
     } else {
-      temp = node->right;
-      while (temp->left != nullptr) {
-        temp = temp->left;
-      }
-      node->first = temp->first;
-      node->second = temp->second;
-      node->right = remove(node->right, temp->first);
       return node;
     }
-  } else if (key < node->first) {
-    node->left = remove(node->left, key);
-  } else {
-    node->right = remove(node->right, key);
   }
-  return node;
+  return nullptr;
+}
+
+template <typename K, typename V, typename Compare>
+template <typename Key>
+typename map<K, V, Compare>::Node *map<K, V, Compare>::findSlot(
+    const Key &key, Node *&parent, bool &left) const {
+  parent = nullptr;
+  left = false;
+  Node *node = root;
+  while (node != nullptr) {
+    parent = node;
+    trace_comparison();
+    int order = compare_keys(comp, key, node->first);
+    if (order == 0) {
+      return node;
+    }
+    left = order < 0;
+    node = left ? node->left : node->right;
+  }
+  return nullptr;
 }
 
-template <typename K, typename V>
-void map<K, V>::erase(K key) {
-  if (key == root->first) {
-    root = remove(root, key);
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Node *map<K, V, Compare>::attach(Node *node,
+                                                             Node *parent,
+                                                             bool left) {
+  node->parent = parent;
+  if (parent == nullptr) {
+    root = node;
+  } else if (left) {
+    parent->left = node;
   } else {
-    remove(root, key);
+    parent->right = node;
   }
+  rb_tree::insert_fixup(root, node);
+  size_++;
+  return node;
 }
 
-template <typename K, typename V>
-typename map<K, V>::Node *map<K, V>::search(Node *node, K key) const {
-  if (node == nullptr) {
-    return nullptr;
+template <typename K, typename V, typename Compare>
+map<K, V, Compare>::map(const Compare &compare)
+    : root(nullptr), comp(compare) {}
+
+template <typename K, typename V, typename Compare>
+map<K, V, Compare>::map(const map &other)
+    : root(nullptr), comp(other.comp) {
+  Node *list = cloneList(other.root);
+  root = rb_tree::build(list, other.size_);
+  size_ = other.size_;
+}
+
+template <typename K, typename V, typename Compare>
+map<K, V, Compare>::map(map &&other) noexcept
+    : root(nullptr), comp(other.comp) {
+  root = other.root;
+  size_ = other.size_;
+  other.accounting_.released(size_ * sizeof(Node));
+  accounting_.adopted(size_ * sizeof(Node));
+  other.root = nullptr;
+  other.size_ = 0;
+}
+
+template <typename K, typename V, typename Compare>
+map<K, V, Compare>::map(std::initializer_list<value_type> initList)
+    : map(initList.begin(), initList.end()) {}
+
+template <typename K, typename V, typename Compare>
+template <typename InputIt>
+map<K, V, Compare>::map(InputIt first, InputIt last, const Compare &compare)
+    : root(nullptr), comp(compare) {
+  Node *list = nullptr;
+  Node **tail = &list;
+  size_type n = 0;
+  for (; first != last; ++first, ++n) {
+    *tail = createNode(nullptr, first->first, first->second);
+    tail = &(*tail)->right;
   }
-  if (key < node->first) {
-    return search(node->left, key);
-  } else if (key > node->first) {
-    return search(node->right, key);
-  } else {
-    return node;
+  if (!isSorted(list)) {
+    list = sortList(list, n);
+  }
+  n = dropDuplicates(list);
+  root = rb_tree::build(list, n);
+  size_ = n;
+}
+
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Node *map<K, V, Compare>::flatten(Node *node) {
+  Node *list = nullptr;
+  node = rightmost(node);
+  while (node != nullptr) {
+    Node *prev = predecessor(node);
+    node->right = list;
+    list = node;
+    node = prev;
   }
+  return list;
 }
 
-template <typename K, typename V>
-map<K, V>::map(const map &other) : root(nullptr) {
-  if (other.root != nullptr) {
-    copyTree(other.root, nullptr, root);
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Node *map<K, V, Compare>::cloneList(
+    Node *node) {
+  Node *list = nullptr;
+  Node **tail = &list;
+  for (node = leftmost(node); node != nullptr; node = successor(node)) {
+    *tail = createNode(nullptr, node->first, node->second);
+    tail = &(*tail)->right;
   }
+  return list;
 }
 
-template <typename K, typename V>
-void map<K, V>::copyTree(const Node *srcNode, Node *srcParent,
-                         Node *&destNode) {
-  if (srcNode == nullptr) {
-    destNode = nullptr;
-    return;
+template <typename K, typename V, typename Compare>
+bool map<K, V, Compare>::isSorted(const Node *list) const {
+  for (; list != nullptr && list->right != nullptr; list = list->right) {
+    if (!comp(list->first, list->right->first)) {
+      return false;
+    }
   }
-  destNode = new Node(srcNode->first, srcNode->second, srcParent);
-  copyTree(srcNode->left, destNode, destNode->left);
-  copyTree(srcNode->right, destNode, destNode->right);
+  return true;
 }
 
-template <typename K, typename V>
-map<K, V>::map(map &&other) noexcept : root(nullptr) {
-  root = other.root;
-  other.root = nullptr;
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Node *map<K, V, Compare>::sortList(
+    Node *&list, size_type n) {
+  if (n <= 1) {
+    Node *node = list;
+    if (node != nullptr) {
+      list = node->right;
+      node->right = nullptr;
+    }
+    return node;
+  }
+  Node *a = sortList(list, n / 2);
+  Node *b = sortList(list, n - n / 2);
+  Node *merged = nullptr;
+  Node **tail = &merged;
+  while (a != nullptr && b != nullptr) {
+    Node *&next = comp(b->first, a->first) ? b : a;
+    *tail = next;
+    tail = &next->right;
+    next = next->right;
+  }
+  *tail = (a != nullptr) ? a : b;
+  return merged;
+}
+
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::size_type map<K, V, Compare>::dropDuplicates(
+    Node *list) {
+  size_type n = 0;
+  for (Node *node = list; node != nullptr; node = node->right) {
+    ++n;
+    while (node->right != nullptr && !comp(node->first, node->right->first)) {
+      Node *duplicate = node->right;
+      node->right = duplicate->right;
+      destroyNode(duplicate);
+    }
+  }
+  return n;
+}
+
+template <typename K, typename V, typename Compare>
+template <typename... Args>
+typename map<K, V, Compare>::Node *map<K, V, Compare>::createNode(
+    Args &&...args) {
+  Node *node = new Node(std::forward<Args>(args)...);
+  accounting_.allocated(sizeof(Node));
+  return node;
+}
+
+template <typename K, typename V, typename Compare>
+void map<K, V, Compare>::destroyNode(Node *node) {
+  accounting_.freed(sizeof(Node));
+  delete node;
 }
 
-template <typename K, typename V>
-map<K, V>::map(std::initializer_list<value_type> initList) : root(nullptr) {
-  for (const auto &pair : initList) {
-    insert(pair.first, pair.second);
+// Frees a node that left the tree through a handle and was never put back.
+template <typename K, typename V, typename Compare>
+void map<K, V, Compare>::destroyDetached(Node *node) {
+  if (node != nullptr) {
+    memory_counter<memory_category::map>::discarded(sizeof(Node));
+    delete node;
   }
 }
 
-template <typename K, typename V>
-map<K, V>::~map() {
+template <typename K, typename V, typename Compare>
+map<K, V, Compare>::~map() {
   clear(root);
   root = nullptr;
   size_ = 0;
 }
 
-template <typename K, typename V>
-void map<K, V>::clear(Node *node) {
+template <typename K, typename V, typename Compare>
+void map<K, V, Compare>::clear(Node *node) {
   if (node != nullptr) {
     clear(node->left);
     clear(node->right);
-    delete node;
+    destroyNode(node);
   }
 }
 
-template <typename K, typename V>
-bool map<K, V>::contains(K key) const {
-  return search(root, key) != nullptr;
+template <typename K, typename V, typename Compare>
+bool map<K, V, Compare>::contains(const K &key) const {
+  return search(key) != nullptr;
 }
 
-template <typename K, typename V>
-V &map<K, V>::at(K key) {
-  if (!(this->contains(key))) {
+template <typename K, typename V, typename Compare>
+V &map<K, V, Compare>::at(const K &key) {
+  Node *node = search(key);
+  if (node == nullptr) {
     throw std::out_of_range("Key not found");
-  } else {
-    Node *node = search(root, key);
-    return node->second;
   }
+  return node->second;
+}
+
+template <typename K, typename V, typename Compare>
+const V &map<K, V, Compare>::at(const K &key) const {
+  Node *node = search(key);
+  if (node == nullptr) {
+    throw std::out_of_range("Key not found");
+  }
+  return node->second;
+}
+
+template <typename K, typename V, typename Compare>
+V &map<K, V, Compare>::operator[](const K &key) {
+  trace_scope trace(trace_op::map_insert);
+  Node *parent;
+  bool left;
+  Node *node = findSlot(key, parent, left);
+  if (node == nullptr) {
+    node = attach(createNode(parent, key), parent, left);
+  }
+  return node->second;
 }
 
-template <typename K, typename V>
-V &map<K, V>::operator[](K key) {
-  return at(key);
+template <typename K, typename V, typename Compare>
+V &map<K, V, Compare>::operator[](K &&key) {
+  trace_scope trace(trace_op::map_insert);
+  Node *parent;
+  bool left;
+  Node *node = findSlot(key, parent, left);
+  if (node == nullptr) {
+    node = attach(createNode(parent, std::move(key)), parent, left);
+  }
+  return node->second;
+}
+
+template <typename K, typename V, typename Compare>
+int map<K, V, Compare>::count(const K &key) const {
+  return search(key) ? 1 : 0;
 }
 
-template <typename K, typename V>
-int map<K, V>::count(Node *node, K key) {
-  return search(node, key) ? 1 : 0;
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Iterator map<K, V, Compare>::find(const K &key) {
+  return Iterator(search(key), this);
 }
 
-template <typename K, typename V>
-int map<K, V>::count(K key) {
-  return count(root, key);
+template <typename K, typename V, typename Compare>
+template <typename Key>
+bool map<K, V, Compare>::contains(const Key &key) const
+  requires transparent_compare<key_compare>
+{
+  return search(key) != nullptr;
 }
 
-template <typename K, typename V>
-int map<K, V>::size(Node *node) {
-  int size_m = 0;
+template <typename K, typename V, typename Compare>
+template <typename Key>
+V &map<K, V, Compare>::at(const Key &key)
+  requires transparent_compare<key_compare>
+{
+  Node *node = search(key);
   if (node == nullptr) {
-    return 0;
+    throw std::out_of_range("Key not found");
   }
-  size_m += size(node->left);
-  size_m += size(node->right);
-  size_m++;
-  return size_m;
+  return node->second;
 }
 
-template <typename K, typename V>
-int map<K, V>::size() {
-  return size(root);
+template <typename K, typename V, typename Compare>
+template <typename Key>
+const V &map<K, V, Compare>::at(const Key &key) const
+  requires transparent_compare<key_compare>
+{
+  Node *node = search(key);
+  if (node == nullptr) {
+    throw std::out_of_range("Key not found");
+  }
+  return node->second;
 }
 
-template <typename K, typename V>
-typename s21::map<K, V>::size_type s21::map<K, V>::max_size() {
-  return std::numeric_limits<size_type>::max();
+template <typename K, typename V, typename Compare>
+template <typename Key>
+int map<K, V, Compare>::count(const Key &key) const
+  requires transparent_compare<key_compare>
+{
+  return search(key) ? 1 : 0;
 }
 
-template <typename K, typename V>
-bool map<K, V>::empty() {
-  return (root == nullptr) ? true : false;
+template <typename K, typename V, typename Compare>
+template <typename Key>
+typename map<K, V, Compare>::Iterator map<K, V, Compare>::find(const Key &key)
+  requires transparent_compare<key_compare>
+{
+  return Iterator(search(key), this);
 }
 
-template <typename K, typename V>
-void map<K, V>::swap(map &other) {
-  std::swap(root, other.root);
+template <typename K, typename V, typename Compare>
+template <typename Key>
+void map<K, V, Compare>::erase(const Key &key)
+  requires transparent_compare<key_compare>
+{
+  trace_scope trace(trace_op::map_erase);
+  Node *node = search(key);
+  if (node != nullptr) {
+    unlink(node);
+  }
 }
 
-template <typename K, typename V>
-void s21::map<K, V>::merge(map &other) {
-  s21::map<K, V>::Iterator it = other.begin();
-  for (int i = 0; i < other.size(); i++) {
-    insert(it->first, it->second);
-    it++;
-  }
-  other.~map();
+template <typename K, typename V, typename Compare>
+int map<K, V, Compare>::size() const {
+  return size_;
+}
+
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::size_type map<K, V, Compare>::max_size() const {
+  return std::numeric_limits<size_type>::max();
+}
+
+template <typename K, typename V, typename Compare>
+bool map<K, V, Compare>::empty() const {
+  return (root == nullptr) ? true : false;
 }
 
-template <typename K, typename V>
-map<K, V> &map<K, V>::operator=(map &&other) noexcept {
+template <typename K, typename V, typename Compare>
+void map<K, V, Compare>::swap(map &other) {
+  accounting_.exchange(other.accounting_, size_ * sizeof(Node),
+                       other.size_ * sizeof(Node));
+  std::swap(root, other.root);
+  std::swap(size_, other.size_);
+  std::swap(comp, other.comp);
+}
+
+// Nodes are relinked, never reallocated; keys already present here stay
+// behind in other, as with std::map. When other is small next to this
+// tree, m * log n < n, its nodes are moved over one at a time; otherwise
+// both trees are flattened into sorted lists, spliced together and
+// rebuilt balanced in O(n + m).
+template <typename K, typename V, typename Compare>
+void map<K, V, Compare>::merge(map &other) {
+  trace_scope trace(trace_op::map_merge);
+  if (this == &other || other.root == nullptr) {
+    return;
+  }
+  if (size_t(other.size_) * std::bit_width(size_t(size_)) < size_t(size_)) {
+    Node *node = leftmost(other.root);
+    while (node != nullptr) {
+      Node *next = successor(node);
+      Node *parent;
+      bool left;
+      if (findSlot(node->first, parent, left) == nullptr) {
+        other.detach(node);
+        other.accounting_.released(sizeof(Node));
+        attach(node, parent, left);
+        accounting_.adopted(sizeof(Node));
+      }
+      node = next;
+    }
+    return;
+  }
+  Node *a = flatten(root);
+  Node *b = flatten(other.root);
+  Node *merged = nullptr;
+  Node **tail = &merged;
+  Node *rest = nullptr;
+  Node **restTail = &rest;
+  size_type duplicates = 0;
+  while (a != nullptr && b != nullptr) {
+    trace_comparison();
+    int order = compare_keys(comp, a->first, b->first);
+    if (order == 0) {
+      *restTail = b;
+      restTail = &b->right;
+      b = b->right;
+      ++duplicates;
+    }
+    Node *&next = (order > 0) ? b : a;
+    *tail = next;
+    tail = &next->right;
+    next = next->right;
+  }
+  *tail = (a != nullptr) ? a : b;
+  *restTail = nullptr;
+  size_type moved = other.size_ - duplicates;
+  other.accounting_.released(moved * sizeof(Node));
+  accounting_.adopted(moved * sizeof(Node));
+  size_ += moved;
+  other.size_ = duplicates;
+  root = rb_tree::build(merged, size_);
+  other.root = rb_tree::build(rest, other.size_);
+}
+
+template <typename K, typename V, typename Compare>
+map<K, V, Compare> &map<K, V, Compare>::operator=(map &&other) noexcept {
   if (this != &other) {
     clear(root);
     root = other.root;
+    size_ = other.size_;
+    comp = other.comp;
+    other.accounting_.released(size_ * sizeof(Node));
+    accounting_.adopted(size_ * sizeof(Node));
     other.root = nullptr;
-    if (root != nullptr) {
-      root->parent = nullptr;
-      updateParentPointers(root);
-    }
+    other.size_ = 0;
   }
   return *this;
 }
 
-template <typename K, typename V>
-void map<K, V>::updateParentPointers(Node *node) {
-  if (node == nullptr) {
-    return;
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::key_compare map<K, V, Compare>::key_comp() const {
+  return comp;
+}
+
+template <typename K, typename V, typename Compare>
+memory_stats map<K, V, Compare>::memory_usage() const {
+  memory_stats stats;
+  stats.live_bytes = size_ * sizeof(Node);
+  stats.nodes = size_;
+  accounting_.report(stats);
+  return stats;
+}
+
+template <typename K, typename V, typename Compare>
+tree_stats map<K, V, Compare>::stats() const {
+  return rb_tree::measure(root);
+}
+
+template <typename K, typename V, typename Compare>
+bool map<K, V, Compare>::validate() const {
+  return size_ >= 0 &&
+         rb_tree::validate(root, size_, [this](const Node *a, const Node *b) {
+           return comp(a->first, b->first);
+         });
+}
+
+template <typename K, typename V, typename Compare>
+void map<K, V, Compare>::save(std::ostream &out) const {
+  serial_writer writer(out);
+  serial_detail::writeHeader(writer, 'm', size_, serial_detail::recordSize<K>(),
+                             serial_detail::recordSize<V>());
+  for (Node *node = leftmost(root); node != nullptr; node = successor(node)) {
+    writer.value(node->first);
+    writer.value(node->second);
   }
-  if (node->left != nullptr) {
-    node->left->parent = node;
-    updateParentPointers(node->left);
+  writer.finish();
+}
+
+template <typename K, typename V, typename Compare>
+void map<K, V, Compare>::load(std::istream &in) {
+  serial_reader reader(in);
+  uint64_t count = serial_detail::readHeader(
+      reader, 'm', serial_detail::recordSize<K>(),
+      serial_detail::recordSize<V>(), std::numeric_limits<int>::max());
+  Node *list = nullptr;
+  Node **tail = &list;
+  try {
+    for (uint64_t i = 0; i < count; i++) {
+      K key = reader.value<K>();
+      V value = reader.value<V>();
+      *tail = createNode(nullptr, std::move(key), std::move(value));
+      tail = &(*tail)->right;
+    }
+    reader.finish();
+  } catch (...) {
+    while (list != nullptr) {
+      destroyNode(std::exchange(list, list->right));
+    }
+    throw;
   }
-  if (node->right != nullptr) {
-    node->right->parent = node;
-    updateParentPointers(node->right);
+  if (!isSorted(list)) {
+    list = sortList(list, count);
+  }
+  size_type n = dropDuplicates(list);
+  clear(root);
+  root = rb_tree::build(list, n);
+  size_ = n;
+}
+
+template <typename K, typename V, typename Compare>
+std::vector<typename map<K, V, Compare>::Iterator> map<K, V, Compare>::split(
+    size_t parts) const {
+  std::vector<Iterator> cuts;
+  for (Node *node : rb_tree::split(root, parts)) {
+    cuts.push_back(Iterator(node, this));
   }
+  cuts.push_back(end());
+  return cuts;
 }
 
-template <typename K, typename V>
-typename map<K, V>::Node *map<K, V>::Iterator::findLeftmost(Node *node) {
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Node *map<K, V, Compare>::leftmost(Node *node) {
   while (node && node->left != nullptr) {
     node = node->left;
   }
   return node;
 }
 
-template <typename K, typename V>
-map<K, V>::Iterator::Iterator(s21::map<K, V>::Node *root)
-    : current(nullptr), treeRoot(root) {
-  current = root;
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Node *map<K, V, Compare>::rightmost(Node *node) {
+  while (node && node->right != nullptr) {
+    node = node->right;
+  }
+  return node;
 }
 
-template <typename K, typename V>
-bool map<K, V>::Iterator::operator!=(
-    const s21::map<K, V>::Iterator &other) const {
-  return current != other.current;
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Node *map<K, V, Compare>::successor(Node *node) {
+  if (node->right != nullptr) {
+    return leftmost(node->right);
+  }
+  Node *parent = node->parent;
+  while (parent != nullptr && node == parent->right) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
 }
 
-template <typename K, typename V>
-typename map<K, V>::Iterator &map<K, V>::Iterator::operator++(int) {
-  Node *prev = current;
-  if (current == nullptr) {
-    return *this;
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Node *map<K, V, Compare>::predecessor(Node *node) {
+  if (node->left != nullptr) {
+    return rightmost(node->left);
+  }
+  Node *parent = node->parent;
+  while (parent != nullptr && node == parent->left) {
+    node = parent;
+    parent = parent->parent;
   }
-  if (current->right && current->right != prev) {
-    current = current->right;
-    while (current->left != nullptr) current = current->left;
+  return parent;
+}
 
-  } else {
-    current = current->parent;
-    while (prev->first >= current->first) {
-      if (current->right && current->right != prev) {
-        current = current->right;
-        while (current->left != nullptr) current = current->left;
-      } else {
-        if (prev->first >= current->first) {
-          current = current->parent;
-        }
-        break;
-      }
-    }
+template <typename K, typename V, typename Compare>
+map<K, V, Compare>::Iterator::Iterator(Node *node, const map *tree)
+    : current(node), owner(tree) {}
+
+template <typename K, typename V, typename Compare>
+bool map<K, V, Compare>::Iterator::operator==(const Iterator &other) const {
+  return current == other.current;
+}
+
+template <typename K, typename V, typename Compare>
+bool map<K, V, Compare>::Iterator::operator!=(const Iterator &other) const {
+  return current != other.current;
+}
+
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Iterator &
+map<K, V, Compare>::Iterator::operator++() {
+  if (current != nullptr) {
+    current = successor(current);
   }
   return *this;
 }
 
-template <typename K, typename V>
-typename map<K, V>::Iterator &map<K, V>::Iterator::operator--() {
-  return operator--();
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Iterator
+map<K, V, Compare>::Iterator::operator++(int) {
+  Iterator tmp = *this;
+  ++*this;
+  return tmp;
 }
 
-template <typename K, typename V>
-typename map<K, V>::Iterator &map<K, V>::Iterator::operator--(int) {
-  Node *prev = current;
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Iterator &
+map<K, V, Compare>::Iterator::operator--() {
   if (current == nullptr) {
-    return *this;
-  }
-  if (current->left && current->left != prev) {
-    current = current->left;
-    while (current->right != nullptr) current = current->right;
+    current = rightmost(owner->root);
   } else {
-    current = current->parent;
-    while (prev->first <= current->first) {
-      if (current->left && current->left != prev) {
-        current = current->left;
-        while (current->right != nullptr) current = current->right;
-      } else {
-        while (prev->first <= current->first) {
-          current = current->parent;
-          if (current == nullptr) {
-            break;
-          }
-        }
-        break;
-      }
-    }
+    current = predecessor(current);
   }
   return *this;
 }
 
-template <typename K, typename V>
-const typename map<K, V>::Node &map<K, V>::Iterator::operator*() const {
-  if (map<K, V>::Iterator::current == nullptr) {
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Iterator
+map<K, V, Compare>::Iterator::operator--(int) {
+  Iterator tmp = *this;
+  --*this;
+  return tmp;
+}
+
+template <typename K, typename V, typename Compare>
+const typename map<K, V, Compare>::Node &
+map<K, V, Compare>::Iterator::operator*() const {
+  if (current == nullptr) {
     throw std::runtime_error("Dereferencing null iterator");
   }
-  return *map<K, V>::Iterator::current;
+  return *current;
 }
 
-template <typename K, typename V>
-const typename map<K, V>::Node *map<K, V>::Iterator::operator->() const {
+template <typename K, typename V, typename Compare>
+const typename map<K, V, Compare>::Node *
+map<K, V, Compare>::Iterator::operator->() const {
   return current;
 }
 
-template <typename K, typename V>
-typename map<K, V>::Node *map<K, V>::begin(Node *node) {
-  while (node && node->left) {
-    node = node->left;
-  }
-  return node;
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Iterator map<K, V, Compare>::begin() {
+  return Iterator(leftmost(root), this);
 }
 
-template <typename K, typename V>
-typename map<K, V>::Node *map<K, V>::begin() {
-  return begin(root);
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Iterator map<K, V, Compare>::end() {
+  return Iterator(nullptr, this);
 }
 
-template <typename K, typename V>
-typename map<K, V>::Node *map<K, V>::end(Node *node) {
-  while (node && node->right) {
-    node = node->right;
-  }
-  return node;
+// Iterator only hands out const access, so a const map can share it.
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Iterator map<K, V, Compare>::begin() const {
+  return Iterator(leftmost(root), this);
 }
 
-template <typename K, typename V>
-typename map<K, V>::Node *map<K, V>::end() {
-  return end(root);
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::Iterator map<K, V, Compare>::end() const {
+  return Iterator(nullptr, this);
 }
 
-template <typename K, typename V>
-typename map<K, V>::Iterator end() {
-  return map<K, V>::Iterator(nullptr);
+template <typename K, typename V, typename Compare>
+std::pair<typename map<K, V, Compare>::Iterator, bool>
+map<K, V, Compare>::insert(
+    const value_type &value) {
+  return try_emplace(value.first, value.second);
 }
 
-template <typename K, typename V>
-typename map<K, V>::Node map<K, V>::Iterator::*find(
-    typename map<K, V>::Node *node, const K &key) {
-  if (node == nullptr || node->first == key) {
-    return node;
+template <typename K, typename V, typename Compare>
+template <typename... Args>
+std::pair<typename map<K, V, Compare>::Iterator, bool>
+map<K, V, Compare>::emplace(
+    Args &&...args) {
+  value_type value(std::forward<Args>(args)...);
+  return try_emplace(std::move(value.first), std::move(value.second));
+}
+
+template <typename K, typename V, typename Compare>
+template <typename... Args>
+std::pair<typename map<K, V, Compare>::Iterator, bool>
+map<K, V, Compare>::try_emplace(
+    const K &key, Args &&...args) {
+  trace_scope trace(trace_op::map_insert);
+  Node *parent;
+  bool left;
+  Node *node = findSlot(key, parent, left);
+  if (node != nullptr) {
+    return std::make_pair(Iterator(node, this), false);
   }
-  if (key < node->first) {
-    return find(node->left, key);
-  } else {
-    return find(node->right, key);
+  node = createNode(parent, key, std::forward<Args>(args)...);
+  return std::make_pair(Iterator(attach(node, parent, left), this), true);
+}
+
+template <typename K, typename V, typename Compare>
+template <typename... Args>
+std::pair<typename map<K, V, Compare>::Iterator, bool>
+map<K, V, Compare>::try_emplace(
+    K &&key, Args &&...args) {
+  trace_scope trace(trace_op::map_insert);
+  Node *parent;
+  bool left;
+  Node *node = findSlot(key, parent, left);
+  if (node != nullptr) {
+    return std::make_pair(Iterator(node, this), false);
+  }
+  node = createNode(parent, std::move(key), std::forward<Args>(args)...);
+  return std::make_pair(Iterator(attach(node, parent, left), this), true);
+}
+
+template <typename K, typename V, typename Compare>
+template <typename M>
+std::pair<typename map<K, V, Compare>::Iterator, bool>
+map<K, V, Compare>::insert_or_assign(
+    const K &key, M &&obj) {
+  trace_scope trace(trace_op::map_insert);
+  Node *parent;
+  bool left;
+  Node *node = findSlot(key, parent, left);
+  if (node != nullptr) {
+    node->second = std::forward<M>(obj);
+    return std::make_pair(Iterator(node, this), false);
+  }
+  node = createNode(parent, key, std::forward<M>(obj));
+  return std::make_pair(Iterator(attach(node, parent, left), this), true);
+}
+
+template <typename K, typename V, typename Compare>
+template <typename M>
+std::pair<typename map<K, V, Compare>::Iterator, bool>
+map<K, V, Compare>::insert_or_assign(
+    K &&key, M &&obj) {
+  trace_scope trace(trace_op::map_insert);
+  Node *parent;
+  bool left;
+  Node *node = findSlot(key, parent, left);
+  if (node != nullptr) {
+    node->second = std::forward<M>(obj);
+    return std::make_pair(Iterator(node, this), false);
   }
+  node = createNode(parent, std::move(key), std::forward<M>(obj));
+  return std::make_pair(Iterator(attach(node, parent, left), this), true);
 }
 
-template <typename K, typename V>
-std::pair<typename map<K, V>::Iterator, bool> map<K, V>::insert(
-    const value_type &value) {
-  Node *parent = nullptr;
-  Node *current = root;
-  while (current != nullptr) {
-    parent = current;
-    if (value.first < current->first) {
-      current = current->left;
-    } else if (value.first > current->first) {
-      current = current->right;
-    } else {
-      return std::make_pair(Iterator(current), false);
-    }
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::node_type map<K, V, Compare>::extract(
+    const K &key) {
+  return extract(find(key));
+}
+
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::node_type map<K, V, Compare>::extract(
+    Iterator pos) {
+  if (pos.current == nullptr) {
+    return node_type();
   }
-  Node *newNode = new Node(value.first, value.second, parent);
-  if (parent == nullptr) {
-    root = newNode;
-  } else if (value.first < parent->first) {
-    parent->left = newNode;
-  } else {
-    parent->right = newNode;
+  detach(pos.current);
+  accounting_.released(sizeof(Node));
+  return node_type(pos.current);
+}
+
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::insert_return_type map<K, V, Compare>::insert(
+    node_type &&handle) {
+  trace_scope trace(trace_op::map_insert);
+  if (handle.empty()) {
+    return {end(), false, node_type()};
   }
-  return std::make_pair(Iterator(newNode), true);
+  Node *parent;
+  bool left;
+  Node *node = findSlot(handle.node->first, parent, left);
+  if (node != nullptr) {
+    return {Iterator(node, this), false, std::move(handle)};
+  }
+  node = attach(handle.node, parent, left);
+  accounting_.adopted(sizeof(Node));
+  handle.node = nullptr;
+  return {Iterator(node, this), true, node_type()};
 }
 
-template <typename K, typename V>
-template <typename... Args>
-std::pair<typename map<K, V>::Iterator, bool> map<K, V>::emplace(
-    Args &&...args) {
-  Node *newNode = new Node(std::forward<Args>(args)...);
-  if (root == nullptr) {
-    root = newNode;
-  } else {
-    Node *currentNode = root;
-    Node *parent = nullptr;
-    while (currentNode != nullptr) {
-      parent = currentNode;
-
-      if (newNode->key < currentNode->key) {
-        currentNode = currentNode->left;
-      } else if (newNode->key > currentNode->key) {
-        currentNode = currentNode->right;
-      } else {
-        delete newNode;
-        return std::make_pair(Iterator(currentNode), false);
-      }
-    }
-    if (newNode->key < parent->key) {
-      parent->left = newNode;
-    } else {
-      parent->right = newNode;
-    }
+template <typename K, typename V, typename Compare>
+map<K, V, Compare>::node_type::node_type(node_type &&other) noexcept
+    : node(other.node) {
+  other.node = nullptr;
+}
 
-    newNode->parent = parent;
+template <typename K, typename V, typename Compare>
+typename map<K, V, Compare>::node_type &
+map<K, V, Compare>::node_type::operator=(node_type &&other) noexcept {
+  if (this != &other) {
+    destroyDetached(node);
+    node = other.node;
+    other.node = nullptr;
   }
-  size_++;
-  return std::make_pair(Iterator(newNode), true);
+  return *this;
+}
+
+template <typename K, typename V, typename Compare>
+map<K, V, Compare>::node_type::~node_type() {
+  destroyDetached(node);
+}
+
+template <typename K, typename V, typename Compare>
+bool map<K, V, Compare>::node_type::empty() const {
+  return node == nullptr;
+}
+
+template <typename K, typename V, typename Compare>
+map<K, V, Compare>::node_type::operator bool() const {
+  return node != nullptr;
+}
+
+template <typename K, typename V, typename Compare>
+K &map<K, V, Compare>::node_type::key() const {
+  return node->first;
+}
+
+template <typename K, typename V, typename Compare>
+V &map<K, V, Compare>::node_type::mapped() const {
+  return node->second;
 }
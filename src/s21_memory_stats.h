@@ -0,0 +1,190 @@
+#ifndef SRC_S21_MEMORY_STATS_H_
+#define SRC_S21_MEMORY_STATS_H_
+
+#include <atomic>
+#include <cstddef>
+
+namespace s21 {
+
+// Heap footprint of one container, or of every container of one kind.
+//
+// live_bytes, nodes and slack_bytes describe what a container owns right
+// now and are worked out from its shape, so memory_usage() reports them in
+// every build. The call counts and peak_bytes have to be recorded at each
+// new and delete; that is compiled in only when S21_MEMORY_STATS is
+// defined, and without it those fields read zero. Bytes are payload bytes
+// (sizeof the node or element), not counting the allocator's own headers.
+struct memory_stats {
+  size_t live_bytes = 0;
+  size_t nodes = 0;          // nodes, entries and buffers currently owned
+  size_t slack_bytes = 0;    // owned bytes that hold no element
+  size_t peak_bytes = 0;     // highest live_bytes so far
+  size_t allocations = 0;    // calls to new
+  size_t deallocations = 0;  // calls to delete
+
+  // Adds up the parts of a container built from several. The sum of the
+  // parts' peaks is an upper bound on the peak of the whole.
+  memory_stats &operator+=(const memory_stats &other) {
+    live_bytes += other.live_bytes;
+    nodes += other.nodes;
+    slack_bytes += other.slack_bytes;
+    peak_bytes += other.peak_bytes;
+    allocations += other.allocations;
+    deallocations += other.deallocations;
+    return *this;
+  }
+};
+
+// Containers are grouped by the kind of storage they allocate. Adaptors
+// and containers built on vector (queue, stack, flat_*, static_*) report
+// under the container that does the allocating.
+enum class memory_category {
+  vector,
+  list,
+  map,
+  set,
+  lru_cache,
+  concurrent_map,
+};
+
+inline constexpr int kMemoryCategories = 6;
+
+namespace memory_stats_detail {
+
+// Process-wide counters for one category, or for all of them.
+struct alignas(64) Totals {
+  std::atomic<size_t> live{0};
+  std::atomic<size_t> peak{0};
+  std::atomic<size_t> allocations{0};
+  std::atomic<size_t> deallocations{0};
+
+  void allocated(size_t bytes) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    size_t now = live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t seen = peak.load(std::memory_order_relaxed);
+    while (seen < now &&
+           !peak.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {
+    }
+  }
+
+  void freed(size_t bytes) {
+    deallocations.fetch_add(1, std::memory_order_relaxed);
+    live.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+
+  memory_stats snapshot() const {
+    memory_stats stats;
+    stats.live_bytes = live.load(std::memory_order_relaxed);
+    stats.peak_bytes = peak.load(std::memory_order_relaxed);
+    stats.allocations = allocations.load(std::memory_order_relaxed);
+    stats.deallocations = deallocations.load(std::memory_order_relaxed);
+    stats.nodes = stats.allocations - stats.deallocations;
+    return stats;
+  }
+};
+
+// The last slot sums every category, so its peak is a true overall peak.
+inline Totals &totals(int slot) {
+  static Totals table[kMemoryCategories + 1];
+  return table[slot];
+}
+
+}  // namespace memory_stats_detail
+
+// Everything allocated and not yet freed by containers of one category.
+// slack_bytes is not tracked globally and is always zero here.
+inline memory_stats global_memory_stats(memory_category category) {
+  return memory_stats_detail::totals(static_cast<int>(category)).snapshot();
+}
+
+inline memory_stats global_memory_stats() {
+  return memory_stats_detail::totals(kMemoryCategories).snapshot();
+}
+
+// Per-instance bookkeeping, held by each container next to its storage.
+// allocated() and freed() stand for real calls to new and delete and are
+// mirrored into the global totals. adopted() and released() record
+// storage changing hands between containers (moves, swaps, node handles):
+// the bytes follow the storage, the call counts stay with the instance
+// that made the calls. A copied container starts with a clean history.
+#ifdef S21_MEMORY_STATS
+
+template <memory_category Category>
+class memory_counter {
+ public:
+  memory_counter() = default;
+  memory_counter(const memory_counter &) {}
+  memory_counter &operator=(const memory_counter &) { return *this; }
+
+  void allocated(size_t bytes) {
+    ++allocations_;
+    adopted(bytes);
+    global(static_cast<int>(Category)).allocated(bytes);
+    global(kMemoryCategories).allocated(bytes);
+  }
+
+  void freed(size_t bytes) {
+    ++deallocations_;
+    released(bytes);
+    discarded(bytes);
+  }
+
+  void adopted(size_t bytes) {
+    live_ += bytes;
+    if (live_ > peak_) {
+      peak_ = live_;
+    }
+  }
+
+  void released(size_t bytes) { live_ -= bytes; }
+
+  // Two containers trading their storage wholesale.
+  void exchange(memory_counter &other, size_t mine, size_t theirs) {
+    released(mine);
+    other.released(theirs);
+    adopted(theirs);
+    other.adopted(mine);
+  }
+
+  // A block freed after it left every container, e.g. by a node handle.
+  static void discarded(size_t bytes) {
+    global(static_cast<int>(Category)).freed(bytes);
+    global(kMemoryCategories).freed(bytes);
+  }
+
+  void report(memory_stats &stats) const {
+    stats.peak_bytes = peak_;
+    stats.allocations = allocations_;
+    stats.deallocations = deallocations_;
+  }
+
+ private:
+  static memory_stats_detail::Totals &global(int slot) {
+    return memory_stats_detail::totals(slot);
+  }
+
+  size_t live_ = 0;
+  size_t peak_ = 0;
+  size_t allocations_ = 0;
+  size_t deallocations_ = 0;
+};
+
+#else
+
+template <memory_category Category>
+class memory_counter {
+ public:
+  void allocated(size_t) {}
+  void freed(size_t) {}
+  void adopted(size_t) {}
+  void released(size_t) {}
+  void exchange(memory_counter &, size_t, size_t) {}
+  static void discarded(size_t) {}
+  void report(memory_stats &) const {}
+};
+
+#endif  // S21_MEMORY_STATS
+
+}  // namespace s21
+
+#endif  //  SRC_S21_MEMORY_STATS_H_
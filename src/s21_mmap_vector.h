@@ -0,0 +1,120 @@
+#ifndef SRC_S21_MMAP_VECTOR_H_
+#define SRC_S21_MMAP_VECTOR_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+enum class mmap_mode { read_only, read_write };
+
+// madvise hints for the mapped pages.
+enum class mmap_access { normal, sequential, random };
+
+// A vector of trivially copyable records stored in a file and mapped into
+// memory with mmap, so opening it costs the same for any size: pages are
+// read in on first touch and shared through the page cache with every
+// other process mapping the file. The file holds the records back to back
+// with no header, as written by fwrite.
+//
+// read_only maps the pages read-only; writing through data() or [] then
+// faults, and the calls that change the size throw std::logic_error.
+// read_write creates the file if it is missing. Growing extends the file
+// with ftruncate and the mapping with mremap, doubling the capacity, so
+// push_back is amortized O(1) like vector's. The file is cut back to
+// exactly size() records by flush() and on destruction; a process that
+// dies in between leaves up to capacity() - size() zero records at the
+// end. Pointers and iterators are invalidated by growth, as in vector.
+//
+// System call failures throw std::system_error.
+template <typename T>
+class mmap_vector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "mmap_vector stores records as raw bytes");
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = T *;
+  using const_iterator = const T *;
+  using size_type = size_t;
+
+  mmap_vector() = default;
+  explicit mmap_vector(const std::string &path,
+                       mmap_mode mode = mmap_mode::read_only);
+  mmap_vector(const mmap_vector &) = delete;
+  mmap_vector &operator=(const mmap_vector &) = delete;
+  mmap_vector(mmap_vector &&other) noexcept;
+  mmap_vector &operator=(mmap_vector &&other) noexcept;
+  ~mmap_vector();
+
+  bool is_open() const { return fd_ >= 0; }
+  bool writable() const { return mode_ == mmap_mode::read_write; }
+
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+  reference operator[](size_type pos) { return data_[pos]; }
+  const_reference operator[](size_type pos) const { return data_[pos]; }
+  reference front() { return data_[0]; }
+  const_reference front() const { return data_[0]; }
+  reference back() { return data_[size_ - 1]; }
+  const_reference back() const { return data_[size_ - 1]; }
+  T *data() { return data_; }
+  const T *data() const { return data_; }
+
+  iterator begin() { return data_; }
+  const_iterator begin() const { return data_; }
+  iterator end() { return data_ + size_; }
+  const_iterator end() const { return data_ + size_; }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type capacity() const { return capacity_; }
+  void reserve(size_type n);
+  // New records are zero.
+  void resize(size_type n);
+  void clear() { resize(0); }
+  void push_back(const_reference value);
+  void pop_back();
+
+  void advise(mmap_access access);
+  // Cuts the file to size() records and writes dirty pages back with
+  // msync, returning once they are on disk.
+  void flush();
+  // flush() for read_write, then unmaps and closes the file. Both happen
+  // even if the flush fails, and its error is rethrown.
+  void close();
+
+ private:
+  // Extends the file and the mapping to n records.
+  void grow(size_type n);
+  void requireWritable() const;
+  // Throws for the errno the failed call left.
+  [[noreturn]] void fail(const char *call) const;
+
+  std::string path_;
+  mmap_mode mode_ = mmap_mode::read_only;
+  int fd_ = -1;
+  T *data_ = nullptr;
+  size_t mapped_bytes_ = 0;
+  size_type size_ = 0;
+  size_type capacity_ = 0;
+};
+
+#include "s21_mmap_vector.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_MMAP_VECTOR_H_
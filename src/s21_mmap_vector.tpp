@@ -0,0 +1,225 @@
+using namespace s21;
+
+template <typename T>
+mmap_vector<T>::mmap_vector(const std::string &path, mmap_mode mode)
+    : path_(path), mode_(mode) {
+  int flags = writable() ? O_RDWR | O_CREAT : O_RDONLY;
+  fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+  if (fd_ < 0) {
+    fail("open");
+  }
+  try {
+    struct stat status;
+    if (fstat(fd_, &status) != 0) {
+      fail("fstat");
+    }
+    size_t bytes = static_cast<size_t>(status.st_size);
+    if (bytes % sizeof(T) != 0) {
+      throw std::runtime_error("mmap_vector: " + path +
+                               " is not a whole number of records");
+    }
+    if (bytes != 0) {
+      int protection = writable() ? PROT_READ | PROT_WRITE : PROT_READ;
+      void *mapped = mmap(nullptr, bytes, protection, MAP_SHARED, fd_, 0);
+      if (mapped == MAP_FAILED) {
+        fail("mmap");
+      }
+      data_ = static_cast<T *>(mapped);
+      mapped_bytes_ = bytes;
+    }
+    size_ = capacity_ = bytes / sizeof(T);
+  } catch (...) {
+    ::close(std::exchange(fd_, -1));
+    throw;
+  }
+}
+
+template <typename T>
+mmap_vector<T>::mmap_vector(mmap_vector &&other) noexcept
+    : path_(std::move(other.path_)),
+      mode_(other.mode_),
+      fd_(std::exchange(other.fd_, -1)),
+      data_(std::exchange(other.data_, nullptr)),
+      mapped_bytes_(std::exchange(other.mapped_bytes_, 0)),
+      size_(std::exchange(other.size_, 0)),
+      capacity_(std::exchange(other.capacity_, 0)) {}
+
+template <typename T>
+mmap_vector<T> &mmap_vector<T>::operator=(mmap_vector &&other) noexcept {
+  if (this != &other) {
+    try {
+      close();
+    } catch (const std::system_error &) {
+    }
+    path_ = std::move(other.path_);
+    mode_ = other.mode_;
+    fd_ = std::exchange(other.fd_, -1);
+    data_ = std::exchange(other.data_, nullptr);
+    mapped_bytes_ = std::exchange(other.mapped_bytes_, 0);
+    size_ = std::exchange(other.size_, 0);
+    capacity_ = std::exchange(other.capacity_, 0);
+  }
+  return *this;
+}
+
+// A destructor cannot report a failed flush; call close() to see it.
+template <typename T>
+mmap_vector<T>::~mmap_vector() {
+  try {
+    close();
+  } catch (const std::system_error &) {
+  }
+}
+
+template <typename T>
+typename mmap_vector<T>::reference mmap_vector<T>::at(size_type pos) {
+  if (pos >= size_) {
+    throw std::out_of_range("Index out of range");
+  }
+  return data_[pos];
+}
+
+template <typename T>
+typename mmap_vector<T>::const_reference mmap_vector<T>::at(
+    size_type pos) const {
+  if (pos >= size_) {
+    throw std::out_of_range("Index out of range");
+  }
+  return data_[pos];
+}
+
+template <typename T>
+void mmap_vector<T>::reserve(size_type n) {
+  requireWritable();
+  if (n > capacity_) {
+    grow(n);
+  }
+}
+
+// The file may hold stale records past size() (after pop_back, say), so
+// the new ones are cleared explicitly.
+template <typename T>
+void mmap_vector<T>::resize(size_type n) {
+  requireWritable();
+  if (n > capacity_) {
+    grow(n);
+  }
+  if (n > size_) {
+    std::memset(static_cast<void *>(data_ + size_), 0,
+                (n - size_) * sizeof(T));
+  }
+  size_ = n;
+}
+
+template <typename T>
+void mmap_vector<T>::push_back(const_reference value) {
+  if (size_ == capacity_) {
+    requireWritable();
+    grow(std::max<size_type>(2 * capacity_, 1));
+  }
+  data_[size_++] = value;
+}
+
+template <typename T>
+void mmap_vector<T>::pop_back() {
+  requireWritable();
+  --size_;
+}
+
+template <typename T>
+void mmap_vector<T>::advise(mmap_access access) {
+  if (mapped_bytes_ == 0) {
+    return;
+  }
+  int advice = access == mmap_access::sequential ? MADV_SEQUENTIAL
+               : access == mmap_access::random   ? MADV_RANDOM
+                                                 : MADV_NORMAL;
+  if (madvise(data_, mapped_bytes_, advice) != 0) {
+    fail("madvise");
+  }
+}
+
+// The mapping keeps its length: only whole pages past the end of the file
+// would fault, and nothing is read or written beyond capacity().
+template <typename T>
+void mmap_vector<T>::flush() {
+  if (!is_open() || !writable()) {
+    return;
+  }
+  if (ftruncate(fd_, static_cast<off_t>(size_ * sizeof(T))) != 0) {
+    fail("ftruncate");
+  }
+  capacity_ = size_;
+  if (size_ != 0 && msync(data_, size_ * sizeof(T), MS_SYNC) != 0) {
+    fail("msync");
+  }
+}
+
+// The mapping and the file are released even when flush() fails, and its
+// error is rethrown afterwards.
+template <typename T>
+void mmap_vector<T>::close() {
+  if (!is_open()) {
+    return;
+  }
+  std::exception_ptr error;
+  try {
+    flush();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  if (mapped_bytes_ != 0) {
+    munmap(data_, mapped_bytes_);
+  }
+  ::close(fd_);
+  fd_ = -1;
+  data_ = nullptr;
+  mapped_bytes_ = 0;
+  size_ = capacity_ = 0;
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+template <typename T>
+void mmap_vector<T>::grow(size_type n) {
+  constexpr int kProtection = PROT_READ | PROT_WRITE;
+  n = std::max(n, 2 * capacity_);
+  size_t bytes = n * sizeof(T);
+  if (ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+    fail("ftruncate");
+  }
+  void *mapped;
+  if (mapped_bytes_ == 0) {
+    mapped = mmap(nullptr, bytes, kProtection, MAP_SHARED, fd_, 0);
+  } else if (bytes <= mapped_bytes_) {
+    // Shrunk by flush() and now regrowing within the old mapping.
+    mapped = data_;
+  } else {
+#ifdef __linux__
+    mapped = mremap(data_, mapped_bytes_, bytes, MREMAP_MAYMOVE);
+#else
+    munmap(data_, mapped_bytes_);
+    mapped = mmap(nullptr, bytes, kProtection, MAP_SHARED, fd_, 0);
+#endif
+  }
+  if (mapped == MAP_FAILED) {
+    fail("mmap");
+  }
+  data_ = static_cast<T *>(mapped);
+  mapped_bytes_ = std::max(mapped_bytes_, bytes);
+  capacity_ = n;
+}
+
+template <typename T>
+void mmap_vector<T>::requireWritable() const {
+  if (!is_open() || !writable()) {
+    throw std::logic_error("mmap_vector: not open for writing");
+  }
+}
+
+template <typename T>
+void mmap_vector<T>::fail(const char *call) const {
+  throw std::system_error(errno, std::generic_category(),
+                          std::string("mmap_vector: ") + call + " " + path_);
+}
@@ -0,0 +1,352 @@
+#ifndef SRC_S21_PARALLEL_H_
+#define SRC_S21_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_map.h"
+#include "s21_set.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Parallel algorithms: sort, transform, reduce and for_each over vectors,
+// and for_each and reduce over maps and sets, whose trees are cut into
+// runs of subtrees with split().
+//
+// The work runs on a thread_pool. Every worker keeps a deque of tasks,
+// taking the newest from its back and, when it runs dry, stealing the
+// oldest from the front of another's. A thread waiting on a task_group runs
+// queued tasks rather than blocking, so a task may itself start tasks and
+// wait for them. Each algorithm has an overload taking the pool first; the
+// others use thread_pool::shared(). Inputs too small to be worth splitting
+// are handled on the calling thread.
+namespace par {
+
+class thread_pool {
+ public:
+  // workers threads of its own; 0 leaves all the work to the thread that
+  // waits on a task group.
+  explicit thread_pool(unsigned workers);
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+  // Joins the workers; no task group may still be waiting on the pool.
+  ~thread_pool();
+
+  // One thread per hardware thread, counting the one that waits.
+  static thread_pool &shared();
+
+  // Threads running tasks while one waits on a group: workers + 1.
+  unsigned concurrency() const {
+    return static_cast<unsigned>(threads_.size()) + 1;
+  }
+
+ private:
+  friend class task_group;
+
+  using Task = std::function<void()>;
+
+  struct alignas(64) Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  // The pool and queue of the calling thread, if it is a worker.
+  struct Worker {
+    const thread_pool *pool = nullptr;
+    size_t queue = 0;
+  };
+  static Worker &current() {
+    static thread_local Worker worker;
+    return worker;
+  }
+
+  // Workers use their own queue; other threads share the last one.
+  size_t ownQueue() const {
+    return current().pool == this ? current().queue : queues_.size() - 1;
+  }
+  void push(Task task);
+  bool take(size_t own, Task &task);
+  bool runOne();
+  void work(size_t own);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<size_t> queued_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+};
+
+// A set of tasks to wait for together.
+class task_group {
+ public:
+  explicit task_group(thread_pool &pool = thread_pool::shared())
+      : pool_(pool) {}
+  task_group(const task_group &) = delete;
+  task_group &operator=(const task_group &) = delete;
+  // Waits for the tasks still running, dropping any exception.
+  ~task_group() { finish(); }
+
+  template <typename F>
+  void run(F &&f);
+  // Returns once every task has finished, running queued tasks meanwhile,
+  // and rethrows the first exception one of them threw.
+  void wait();
+
+ private:
+  void finish();
+
+  thread_pool &pool_;
+  std::atomic<size_t> pending_{0};
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+};
+
+// Elements are handed out in runs of consecutive ones, several per thread,
+// and f is called concurrently on different elements.
+template <typename T, typename F>
+void for_each(thread_pool &pool, vector<T> &v, F f);
+template <typename T, typename F>
+void for_each(vector<T> &v, F f);
+
+// A vector of f(v[i]); the result type must be default-constructible.
+template <typename T, typename F>
+auto transform(thread_pool &pool, const vector<T> &v, F f)
+    -> vector<std::decay_t<std::invoke_result_t<F &, const T &>>>;
+template <typename T, typename F>
+auto transform(const vector<T> &v, F f)
+    -> vector<std::decay_t<std::invoke_result_t<F &, const T &>>>;
+
+// op can stand in for combine only when it takes two U as they are: the
+// elements are U, or op is a transparent function object such as
+// std::plus<>. An op(long, int) handed two partial sums would narrow one
+// of them, so such an op needs an explicit combine.
+template <typename Op, typename U, typename Element>
+concept combines_as_op =
+    std::same_as<Element, U> || requires { typename Op::is_transparent; };
+
+// Folds each run from identity with op(U, element), then folds the run
+// results in order with combine(U, U), op by default (see combines_as_op).
+// identity must leave a value unchanged (0 for +, 1 for *), and op and
+// combine must be associative; they need not be commutative.
+template <typename T, typename U, typename Op>
+  requires combines_as_op<Op, U, T>
+U reduce(thread_pool &pool, const vector<T> &v, U identity, Op op);
+template <typename T, typename U, typename Op, typename Combine>
+U reduce(thread_pool &pool, const vector<T> &v, U identity, Op op,
+         Combine combine);
+template <typename T, typename U, typename Op>
+  requires combines_as_op<Op, U, T>
+U reduce(const vector<T> &v, U identity, Op op);
+template <typename T, typename U, typename Op, typename Combine>
+U reduce(const vector<T> &v, U identity, Op op, Combine combine);
+
+// Not stable, like std::sort. Runs are sorted with std::sort, one task
+// each, then merged pairwise with every merge cut into pieces of equal
+// output length, so the last merges still use every thread. Takes a
+// buffer of v.size() default-constructed elements.
+template <typename T, typename Compare = std::less<>>
+void sort(thread_pool &pool, vector<T> &v, Compare comp = Compare());
+template <typename T, typename Compare = std::less<>>
+void sort(vector<T> &v, Compare comp = Compare());
+
+// map and set: elements are visited through const iterators.
+template <typename Tree>
+concept splittable = requires(const Tree &tree) {
+  tree.split(size_t(1));
+  tree.size();
+};
+
+template <splittable Tree, typename F>
+void for_each(thread_pool &pool, const Tree &tree, F f);
+template <splittable Tree, typename F>
+void for_each(const Tree &tree, F f);
+
+// What a tree's const iterator yields.
+template <typename Tree>
+using element_of =
+    std::remove_cvref_t<decltype(*std::declval<const Tree &>().begin())>;
+
+template <splittable Tree, typename U, typename Op>
+  requires combines_as_op<Op, U, element_of<Tree>>
+U reduce(thread_pool &pool, const Tree &tree, U identity, Op op);
+template <splittable Tree, typename U, typename Op, typename Combine>
+U reduce(thread_pool &pool, const Tree &tree, U identity, Op op,
+         Combine combine);
+template <splittable Tree, typename U, typename Op>
+  requires combines_as_op<Op, U, element_of<Tree>>
+U reduce(const Tree &tree, U identity, Op op);
+template <splittable Tree, typename U, typename Op, typename Combine>
+U reduce(const Tree &tree, U identity, Op op, Combine combine);
+
+namespace detail {
+
+// Below this many elements per task, splitting costs more than it saves.
+constexpr size_t kMinGrain = size_t(1) << 12;
+constexpr size_t kMinSortRun = size_t(1) << 14;
+
+// Enough pieces of n elements to keep every thread busy while some finish
+// early, but none smaller than grain.
+inline size_t pieces(const thread_pool &pool, size_t n, size_t grain) {
+  if (pool.concurrency() == 1) {
+    return 1;
+  }
+  return std::clamp<size_t>(n / grain, 1, pool.concurrency() * 4);
+}
+
+// Calls body(0) on this thread and body(1) .. body(count - 1) as tasks.
+template <typename Body>
+void runEach(thread_pool &pool, size_t count, const Body &body);
+
+// Calls body(begin, end) for pieces(pool, n, grain) ranges covering [0, n).
+template <typename Body>
+void forEachPiece(thread_pool &pool, size_t n, size_t grain,
+                  const Body &body);
+
+template <typename T, typename Compare>
+size_t mergeSplit(const T *a, size_t a_size, const T *b, size_t b_size,
+                  size_t k, const Compare &comp);
+
+}  // namespace detail
+
+inline thread_pool::thread_pool(unsigned workers) {
+  for (unsigned i = 0; i <= workers; i++) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (unsigned i = 0; i < workers; i++) {
+    threads_.emplace_back(&thread_pool::work, this, i);
+  }
+}
+
+inline thread_pool::~thread_pool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &thread : threads_) {
+    thread.join();
+  }
+}
+
+inline thread_pool &thread_pool::shared() {
+  static thread_pool pool(std::max(std::thread::hardware_concurrency(), 1u) -
+                          1);
+  return pool;
+}
+
+inline void thread_pool::push(Task task) {
+  Queue &queue = *queues_[ownQueue()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  queued_.fetch_add(1);
+  // Taken so that a worker between its last look and its wait cannot miss
+  // the notification.
+  { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+  wake_.notify_one();
+}
+
+inline bool thread_pool::take(size_t own, Task &task) {
+  if (queued_.load() == 0) {
+    return false;
+  }
+  for (size_t i = 0; i < queues_.size(); i++) {
+    Queue &queue = *queues_[(own + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    queued_.fetch_sub(1);
+    return true;
+  }
+  return false;
+}
+
+inline bool thread_pool::runOne() {
+  Task task;
+  if (!take(ownQueue(), task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+inline void thread_pool::work(size_t own) {
+  current() = Worker{this, own};
+  Task task;
+  while (true) {
+    if (take(own, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    wake_.wait(lock, [this] { return stopping_ || queued_.load() != 0; });
+    if (stopping_ && queued_.load() == 0) {
+      return;
+    }
+  }
+}
+
+template <typename F>
+void task_group::run(F &&f) {
+  pending_.fetch_add(1);
+  pool_.push([this, f = std::forward<F>(f)]() mutable {
+    try {
+      f();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+    // The group may be gone as soon as this reaches zero.
+    pending_.fetch_sub(1, std::memory_order_release);
+  });
+}
+
+inline void task_group::wait() {
+  finish();
+  std::exception_ptr error;
+  std::swap(error, error_);
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+inline void task_group::finish() {
+  while (pending_.load(std::memory_order_acquire) != 0) {
+    if (!pool_.runOne()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+}  // namespace par
+
+#include "s21_parallel.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_PARALLEL_H_
@@ -0,0 +1,245 @@
+using namespace s21;
+
+template <typename Body>
+void par::detail::runEach(thread_pool &pool, size_t count, const Body &body) {
+  if (count == 0) {
+    return;
+  }
+  task_group group(pool);
+  for (size_t i = 1; i < count; i++) {
+    group.run([&body, i] { body(i); });
+  }
+  body(0);
+  group.wait();
+}
+
+template <typename Body>
+void par::detail::forEachPiece(thread_pool &pool, size_t n, size_t grain,
+                               const Body &body) {
+  size_t count = pieces(pool, n, grain);
+  runEach(pool, count, [&body, n, count](size_t i) {
+    body(n * i / count, n * (i + 1) / count);
+  });
+}
+
+// How many of the first k elements of the stable merge of a and b come from
+// a: the least i with b[k - i - 1] < a[i], found by binary search.
+template <typename T, typename Compare>
+size_t par::detail::mergeSplit(const T *a, size_t a_size, const T *b,
+                               size_t b_size, size_t k,
+                               const Compare &comp) {
+  size_t low = (k > b_size) ? k - b_size : 0;
+  size_t high = std::min(k, a_size);
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    if (comp(b[k - middle - 1], a[middle])) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+  return low;
+}
+
+template <typename T, typename F>
+void par::for_each(thread_pool &pool, vector<T> &v, F f) {
+  T *data = v.data();
+  detail::forEachPiece(pool, v.size(), detail::kMinGrain,
+                       [data, &f](size_t begin, size_t end) {
+                         for (size_t i = begin; i < end; i++) f(data[i]);
+                       });
+}
+
+template <typename T, typename F>
+void par::for_each(vector<T> &v, F f) {
+  par::for_each(thread_pool::shared(), v, std::move(f));
+}
+
+template <typename T, typename F>
+auto par::transform(thread_pool &pool, const vector<T> &v, F f)
+    -> vector<std::decay_t<std::invoke_result_t<F &, const T &>>> {
+  using U = std::decay_t<std::invoke_result_t<F &, const T &>>;
+  vector<U> out(v.size());
+  const T *in = v.data();
+  U *to = out.data();
+  detail::forEachPiece(pool, v.size(), detail::kMinGrain,
+                       [in, to, &f](size_t begin, size_t end) {
+                         for (size_t i = begin; i < end; i++) to[i] = f(in[i]);
+                       });
+  return out;
+}
+
+template <typename T, typename F>
+auto par::transform(const vector<T> &v, F f)
+    -> vector<std::decay_t<std::invoke_result_t<F &, const T &>>> {
+  return par::transform(thread_pool::shared(), v, std::move(f));
+}
+
+template <typename T, typename U, typename Op>
+  requires par::combines_as_op<Op, U, T>
+U par::reduce(thread_pool &pool, const vector<T> &v, U identity, Op op) {
+  return par::reduce(pool, v, std::move(identity), op, op);
+}
+
+template <typename T, typename U, typename Op, typename Combine>
+U par::reduce(thread_pool &pool, const vector<T> &v, U identity, Op op,
+              Combine combine) {
+  size_t count = detail::pieces(pool, v.size(), detail::kMinGrain);
+  std::vector<U> partial(count, identity);
+  const T *data = v.data();
+  size_t n = v.size();
+  detail::runEach(pool, count, [&](size_t i) {
+    U folded = identity;
+    for (size_t j = n * i / count; j < n * (i + 1) / count; j++) {
+      folded = op(std::move(folded), data[j]);
+    }
+    partial[i] = std::move(folded);
+  });
+  U result = std::move(partial[0]);
+  for (size_t i = 1; i < count; i++) {
+    result = combine(std::move(result), std::move(partial[i]));
+  }
+  return result;
+}
+
+template <typename T, typename U, typename Op>
+  requires par::combines_as_op<Op, U, T>
+U par::reduce(const vector<T> &v, U identity, Op op) {
+  return par::reduce(thread_pool::shared(), v, std::move(identity), op, op);
+}
+
+template <typename T, typename U, typename Op, typename Combine>
+U par::reduce(const vector<T> &v, U identity, Op op, Combine combine) {
+  return par::reduce(thread_pool::shared(), v, std::move(identity), op,
+                     combine);
+}
+
+template <typename T, typename Compare>
+void par::sort(thread_pool &pool, vector<T> &v, Compare comp) {
+  size_t n = v.size();
+  size_t runs = detail::pieces(pool, n, detail::kMinSortRun);
+  if (runs == 1) {
+    std::sort(v.begin(), v.end(), comp);
+    return;
+  }
+  std::vector<size_t> bounds(runs + 1);
+  for (size_t i = 0; i <= runs; i++) {
+    bounds[i] = n * i / runs;
+  }
+  T *from = v.data();
+  detail::runEach(pool, runs, [&](size_t i) {
+    std::sort(from + bounds[i], from + bounds[i + 1], comp);
+  });
+
+  // Each round merges runs 2r and 2r + 1 (or moves a last odd one across)
+  // from one array into the other, in pieces of about n / runs elements.
+  // A piece starts where the merge path crosses its first output position;
+  // all of them are found before any element is moved.
+  struct Piece {
+    size_t begin, middle, end;  // of the two runs
+    size_t k, k_end;            // output positions, from begin
+    size_t i, i_end;            // the elements taken from the first run
+  };
+  vector<T> buffer(n);
+  T *to = buffer.data();
+  size_t length = std::max(detail::kMinSortRun, n / runs);
+  while (runs > 1) {
+    std::vector<size_t> merged;
+    std::vector<Piece> work;
+    for (size_t r = 0; r < runs; r += 2) {
+      size_t begin = bounds[r];
+      size_t middle = bounds[std::min(r + 1, runs)];
+      size_t end = bounds[std::min(r + 2, runs)];
+      merged.push_back(begin);
+      size_t i = 0;
+      for (size_t k = 0; k < end - begin; k += length) {
+        size_t k_end = std::min(k + length, end - begin);
+        size_t i_end =
+            detail::mergeSplit(from + begin, middle - begin, from + middle,
+                               end - middle, k_end, comp);
+        work.push_back(Piece{begin, middle, end, k, k_end, i, i_end});
+        i = i_end;
+      }
+    }
+    merged.push_back(n);
+    detail::runEach(pool, work.size(), [&](size_t w) {
+      const Piece &p = work[w];
+      T *a = from + p.begin;
+      T *b = from + p.middle;
+      std::merge(std::make_move_iterator(a + p.i),
+                 std::make_move_iterator(a + p.i_end),
+                 std::make_move_iterator(b + (p.k - p.i)),
+                 std::make_move_iterator(b + (p.k_end - p.i_end)),
+                 to + p.begin + p.k, comp);
+    });
+    bounds.swap(merged);
+    runs = bounds.size() - 1;
+    std::swap(from, to);
+  }
+  if (from != v.data()) {
+    T *data = v.data();
+    detail::forEachPiece(pool, n, detail::kMinGrain,
+                         [from, data](size_t begin, size_t end) {
+                           std::move(from + begin, from + end, data + begin);
+                         });
+  }
+}
+
+template <typename T, typename Compare>
+void par::sort(vector<T> &v, Compare comp) {
+  par::sort(thread_pool::shared(), v, std::move(comp));
+}
+
+template <par::splittable Tree, typename F>
+void par::for_each(thread_pool &pool, const Tree &tree, F f) {
+  auto cuts = tree.split(detail::pieces(pool, tree.size(), detail::kMinGrain));
+  detail::runEach(pool, cuts.size() - 1, [&cuts, &f](size_t i) {
+    for (auto it = cuts[i]; it != cuts[i + 1]; ++it) f(*it);
+  });
+}
+
+template <par::splittable Tree, typename F>
+void par::for_each(const Tree &tree, F f) {
+  par::for_each(thread_pool::shared(), tree, std::move(f));
+}
+
+template <par::splittable Tree, typename U, typename Op>
+  requires par::combines_as_op<Op, U, par::element_of<Tree>>
+U par::reduce(thread_pool &pool, const Tree &tree, U identity, Op op) {
+  return par::reduce(pool, tree, std::move(identity), op, op);
+}
+
+template <par::splittable Tree, typename U, typename Op, typename Combine>
+U par::reduce(thread_pool &pool, const Tree &tree, U identity, Op op,
+              Combine combine) {
+  auto cuts = tree.split(detail::pieces(pool, tree.size(), detail::kMinGrain));
+  size_t count = cuts.size() - 1;
+  if (count == 0) {
+    return identity;
+  }
+  std::vector<U> partial(count, identity);
+  detail::runEach(pool, count, [&](size_t i) {
+    U folded = identity;
+    for (auto it = cuts[i]; it != cuts[i + 1]; ++it) {
+      folded = op(std::move(folded), *it);
+    }
+    partial[i] = std::move(folded);
+  });
+  U result = std::move(partial[0]);
+  for (size_t i = 1; i < count; i++) {
+    result = combine(std::move(result), std::move(partial[i]));
+  }
+  return result;
+}
+
+template <par::splittable Tree, typename U, typename Op>
+  requires par::combines_as_op<Op, U, par::element_of<Tree>>
+U par::reduce(const Tree &tree, U identity, Op op) {
+  return par::reduce(thread_pool::shared(), tree, std::move(identity), op, op);
+}
+
+template <par::splittable Tree, typename U, typename Op, typename Combine>
+U par::reduce(const Tree &tree, U identity, Op op, Combine combine) {
+  return par::reduce(thread_pool::shared(), tree, std::move(identity), op,
+                combine);
+}
@@ -0,0 +1,183 @@
+#ifndef SRC_S21_PERF_COUNTERS_H_
+#define SRC_S21_PERF_COUNTERS_H_
+
+#include <cstdint>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace s21 {
+
+// Hardware event counts for the calling thread, for the benchmarks.
+//
+// Each event is opened on its own through Linux perf_event_open, counting
+// user space only so that the default perf_event_paranoid setting allows
+// it. An event the kernel or the machine does not offer (virtual machines
+// often offer none) is left out and reads zero; unavailable_reason() says
+// why. When the PMU has fewer counters than events the kernel time-shares
+// them, and read() scales each count up to the whole time it was enabled.
+enum class perf_event {
+  cycles,
+  instructions,
+  l1d_misses,
+  llc_misses,
+  branch_misses,
+  dtlb_misses,
+};
+
+inline constexpr int kPerfEvents = 6;
+
+inline const char *perf_event_name(perf_event event) {
+  static const char *const names[kPerfEvents] = {
+      "cycles",     "instructions",  "L1d_misses",
+      "LLC_misses", "branch_misses", "dTLB_misses",
+  };
+  return names[static_cast<int>(event)];
+}
+
+class perf_counters {
+ public:
+  perf_counters() {
+    for (int event = 0; event < kPerfEvents; event++) {
+      fds_[event] = open(perf_event(event));
+    }
+  }
+  perf_counters(const perf_counters &) = delete;
+  perf_counters &operator=(const perf_counters &) = delete;
+
+  ~perf_counters() {
+#ifdef __linux__
+    for (int fd : fds_) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+#endif
+  }
+
+  // Whether at least one event could be opened.
+  bool available() const {
+    for (int fd : fds_) {
+      if (fd >= 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool available(perf_event event) const {
+    return fds_[static_cast<int>(event)] >= 0;
+  }
+
+  // The first failure, e.g. "cycles: No such file or directory"; empty
+  // when every event opened.
+  const std::string &unavailable_reason() const { return reason_; }
+
+  // Counts accumulate over every start()..stop() span until reset().
+  void start() { control(Request::enable); }
+  void stop() { control(Request::disable); }
+  void reset() { control(Request::reset); }
+
+  uint64_t read(perf_event event) const {
+#ifdef __linux__
+    int fd = fds_[static_cast<int>(event)];
+    uint64_t values[3];  // count, time enabled, time running
+    if (fd < 0 || ::read(fd, values, sizeof(values)) != sizeof(values) ||
+        values[2] == 0) {
+      return 0;
+    }
+    if (values[2] == values[1]) {
+      return values[0];
+    }
+    return static_cast<uint64_t>(static_cast<double>(values[0]) * values[1] /
+                                 values[2]);
+#else
+    (void)event;
+    return 0;
+#endif
+  }
+
+ private:
+  enum class Request { enable, disable, reset };
+
+#ifdef __linux__
+  int open(perf_event event) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    constexpr uint64_t kReadMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    switch (event) {
+      case perf_event::cycles:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+      case perf_event::instructions:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+      case perf_event::l1d_misses:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_L1D | kReadMiss;
+        break;
+      case perf_event::llc_misses:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+      case perf_event::branch_misses:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+      case perf_event::dtlb_misses:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | kReadMiss;
+        break;
+    }
+    int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1,
+                                      PERF_FLAG_FD_CLOEXEC));
+    if (fd < 0 && reason_.empty()) {
+      reason_ = std::string(perf_event_name(event)) + ": " +
+                std::strerror(errno);
+    }
+    return fd;
+  }
+
+  void control(Request request) {
+    unsigned long code = request == Request::enable    ? PERF_EVENT_IOC_ENABLE
+                         : request == Request::disable ? PERF_EVENT_IOC_DISABLE
+                                                       : PERF_EVENT_IOC_RESET;
+    for (int fd : fds_) {
+      if (fd >= 0) {
+        ioctl(fd, code, 0);
+      }
+    }
+  }
+#else
+  int open(perf_event) {
+    reason_ = "perf_event_open is Linux-only";
+    return -1;
+  }
+
+  void control(Request) {}
+#endif
+
+  int fds_[kPerfEvents];
+  std::string reason_;
+};
+
+}  // namespace s21
+
+#endif  //  SRC_S21_PERF_COUNTERS_H_
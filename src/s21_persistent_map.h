@@ -0,0 +1,133 @@
+#ifndef SRC_S21_PERSISTENT_MAP_H_
+#define SRC_S21_PERSISTENT_MAP_H_
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_tree_compare.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Ordered map whose versions share structure. Nodes are immutable and
+// reference counted; an update copies only the nodes on the path from the
+// root to the change (O(log n) of them, the tree is AVL balanced) and
+// leaves every other node shared with older versions. Copying or taking a
+// snapshot() is O(1). A snapshot never observes later updates, so readers
+// may keep one on another thread while the owner keeps writing; the
+// reference counts are atomic. To hand new versions to running readers,
+// publish them through an atomic_root.
+template <typename K, typename V, typename Compare = std::less<>>
+class persistent_map {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<key_type, mapped_type>;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+ private:
+  struct Node;
+  using NodePtr = std::shared_ptr<const Node>;
+
+  struct Node {
+    K first;
+    V second;
+    NodePtr left;
+    NodePtr right;
+    int height;
+
+    Node(const K &key, const V &value, NodePtr l, NodePtr r);
+  };
+
+  NodePtr root;
+  size_type size_ = 0;
+  key_compare comp;
+
+  static int height(const NodePtr &node);
+  static NodePtr balance(const K &key, const V &value, NodePtr left,
+                         NodePtr right);
+  static NodePtr removeMin(const NodePtr &node, const Node *&min);
+  NodePtr insert(const NodePtr &node, const K &key, const V &value,
+                 bool assign, bool &inserted) const;
+  NodePtr erase(const NodePtr &node, const K &key, bool &erased) const;
+  const Node *search(const K &key) const;
+
+ public:
+  class ConstIterator;
+  class atomic_root;
+
+  persistent_map() = default;
+  explicit persistent_map(const Compare &compare);
+  persistent_map(std::initializer_list<value_type> const &items);
+
+  persistent_map snapshot() const;
+
+  bool insert(const value_type &value);
+  bool insert(const K &key, const V &value);
+  bool insert_or_assign(const K &key, const V &value);
+  size_type erase(const K &key);
+  void clear();
+  void swap(persistent_map &other);
+
+  const V &at(const K &key) const;
+  const V *find(const K &key) const;
+  bool contains(const K &key) const;
+  size_type count(const K &key) const;
+
+  size_type size() const;
+  bool empty() const;
+  key_compare key_comp() const;
+
+  ConstIterator begin() const;
+  ConstIterator end() const;
+
+  // Forward in-order iterator. Nodes carry no parent pointers (a node may
+  // sit in several versions), so the path from the root is kept on a
+  // stack. It stays valid as long as the version it came from is alive.
+  class ConstIterator {
+   public:
+    ConstIterator() = default;
+    bool operator==(const ConstIterator &other) const;
+    bool operator!=(const ConstIterator &other) const;
+    ConstIterator &operator++();
+    ConstIterator operator++(int);
+    const Node &operator*() const;
+    const Node *operator->() const;
+
+   private:
+    friend class persistent_map;
+    explicit ConstIterator(const Node *root);
+    void descendLeft(const Node *node);
+    vector<const Node *> path;
+  };
+
+  // The current version of a map shared between threads. A writer builds
+  // the next version on its own copy and publish()es it; readers load() the
+  // latest one and walk it without any lock, however many versions are
+  // published meanwhile. Both are O(1): a version is only a root pointer
+  // and a size, so neither ever waits on tree work.
+  class atomic_root {
+   public:
+    atomic_root();
+    explicit atomic_root(persistent_map version);
+    atomic_root(const atomic_root &) = delete;
+    atomic_root &operator=(const atomic_root &) = delete;
+
+    void publish(persistent_map version);
+    persistent_map load() const;
+
+   private:
+    std::atomic<std::shared_ptr<const persistent_map>> current;
+  };
+};
+
+#include "s21_persistent_map.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_PERSISTENT_MAP_H_
@@ -0,0 +1,353 @@
+using namespace s21;
+
+template <typename K, typename V, typename Compare>
+persistent_map<K, V, Compare>::Node::Node(const K &key, const V &value,
+                                          NodePtr l, NodePtr r)
+    : first(key),
+      second(value),
+      left(std::move(l)),
+      right(std::move(r)),
+      height(1 + std::max(persistent_map::height(left),
+                          persistent_map::height(right))) {}
+
+template <typename K, typename V, typename Compare>
+persistent_map<K, V, Compare>::persistent_map(const Compare &compare)
+    : comp(compare) {}
+
+template <typename K, typename V, typename Compare>
+persistent_map<K, V, Compare>::persistent_map(
+    std::initializer_list<value_type> const &items) {
+  for (const value_type &item : items) {
+    insert(item);
+  }
+}
+
+template <typename K, typename V, typename Compare>
+persistent_map<K, V, Compare> persistent_map<K, V, Compare>::snapshot() const {
+  return *this;
+}
+
+template <typename K, typename V, typename Compare>
+persistent_map<K, V, Compare>::atomic_root::atomic_root()
+    : atomic_root(persistent_map()) {}
+
+template <typename K, typename V, typename Compare>
+persistent_map<K, V, Compare>::atomic_root::atomic_root(
+    persistent_map version)
+    : current(std::make_shared<const persistent_map>(std::move(version))) {}
+
+// The release store pairs with load()'s acquire, so a reader that sees the
+// new version also sees every node the writer built for it.
+template <typename K, typename V, typename Compare>
+void persistent_map<K, V, Compare>::atomic_root::publish(
+    persistent_map version) {
+  current.store(std::make_shared<const persistent_map>(std::move(version)),
+                std::memory_order_release);
+}
+
+template <typename K, typename V, typename Compare>
+persistent_map<K, V, Compare> persistent_map<K, V, Compare>::atomic_root::load()
+    const {
+  return *current.load(std::memory_order_acquire);
+}
+
+template <typename K, typename V, typename Compare>
+int persistent_map<K, V, Compare>::height(const NodePtr &node) {
+  return node ? node->height : 0;
+}
+
+// Builds the node (key, value, left, right), rotating once or twice when
+// the two subtrees differ in height by two. Every node it creates is new;
+// the subtrees it is given are shared as they are.
+template <typename K, typename V, typename Compare>
+typename persistent_map<K, V, Compare>::NodePtr
+persistent_map<K, V, Compare>::balance(const K &key, const V &value,
+                                       NodePtr left, NodePtr right) {
+  int hl = height(left);
+  int hr = height(right);
+  if (hl > hr + 1) {
+    if (height(left->left) >= height(left->right)) {
+      return std::make_shared<const Node>(
+          left->first, left->second, left->left,
+          std::make_shared<const Node>(key, value, left->right, right));
+    }
+    const Node *pivot = left->right.get();
+    return std::make_shared<const Node>(
+        pivot->first, pivot->second,
+        std::make_shared<const Node>(left->first, left->second, left->left,
+                                     pivot->left),
+        std::make_shared<const Node>(key, value, pivot->right, right));
+  }
+  if (hr > hl + 1) {
+    if (height(right->right) >= height(right->left)) {
+      return std::make_shared<const Node>(
+          right->first, right->second,
+          std::make_shared<const Node>(key, value, left, right->left),
+          right->right);
+    }
+    const Node *pivot = right->left.get();
+    return std::make_shared<const Node>(
+        pivot->first, pivot->second,
+        std::make_shared<const Node>(key, value, left, pivot->left),
+        std::make_shared<const Node>(right->first, right->second,
+                                     pivot->right, right->right));
+  }
+  return std::make_shared<const Node>(key, value, std::move(left),
+                                      std::move(right));
+}
+
+// Returns the subtree without its smallest node, which is reported through
+// min. The caller keeps the old subtree alive, so min stays valid.
+template <typename K, typename V, typename Compare>
+typename persistent_map<K, V, Compare>::NodePtr
+persistent_map<K, V, Compare>::removeMin(const NodePtr &node,
+                                         const Node *&min) {
+  if (!node->left) {
+    min = node.get();
+    return node->right;
+  }
+  return balance(node->first, node->second, removeMin(node->left, min),
+                 node->right);
+}
+
+// Returns the new subtree, or node itself when nothing changed, so an
+// insert of an existing key copies nothing.
+template <typename K, typename V, typename Compare>
+typename persistent_map<K, V, Compare>::NodePtr
+persistent_map<K, V, Compare>::insert(const NodePtr &node, const K &key,
+                                      const V &value, bool assign,
+                                      bool &inserted) const {
+  if (!node) {
+    inserted = true;
+    return std::make_shared<const Node>(key, value, nullptr, nullptr);
+  }
+  int order = compare_keys(comp, key, node->first);
+  if (order == 0) {
+    inserted = false;
+    if (!assign) {
+      return node;
+    }
+    return std::make_shared<const Node>(node->first, value, node->left,
+                                        node->right);
+  }
+  if (order < 0) {
+    NodePtr left = insert(node->left, key, value, assign, inserted);
+    if (left == node->left) {
+      return node;
+    }
+    return balance(node->first, node->second, std::move(left), node->right);
+  }
+  NodePtr right = insert(node->right, key, value, assign, inserted);
+  if (right == node->right) {
+    return node;
+  }
+  return balance(node->first, node->second, node->left, std::move(right));
+}
+
+template <typename K, typename V, typename Compare>
+typename persistent_map<K, V, Compare>::NodePtr
+persistent_map<K, V, Compare>::erase(const NodePtr &node, const K &key,
+                                     bool &erased) const {
+  if (!node) {
+    erased = false;
+    return node;
+  }
+  int order = compare_keys(comp, key, node->first);
+  if (order < 0) {
+    NodePtr left = erase(node->left, key, erased);
+    return erased ? balance(node->first, node->second, std::move(left),
+                            node->right)
+                  : node;
+  }
+  if (order > 0) {
+    NodePtr right = erase(node->right, key, erased);
+    return erased ? balance(node->first, node->second, node->left,
+                            std::move(right))
+                  : node;
+  }
+  erased = true;
+  if (!node->left) {
+    return node->right;
+  }
+  if (!node->right) {
+    return node->left;
+  }
+  const Node *min = nullptr;
+  NodePtr right = removeMin(node->right, min);
+  return balance(min->first, min->second, node->left, std::move(right));
+}
+
+template <typename K, typename V, typename Compare>
+const typename persistent_map<K, V, Compare>::Node *
+persistent_map<K, V, Compare>::search(const K &key) const {
+  const Node *node = root.get();
+  while (node != nullptr) {
+    int order = compare_keys(comp, key, node->first);
+    if (order == 0) {
+      break;
+    }
+    node = (order < 0) ? node->left.get() : node->right.get();
+  }
+  return node;
+}
+
+template <typename K, typename V, typename Compare>
+bool persistent_map<K, V, Compare>::insert(const value_type &value) {
+  return insert(value.first, value.second);
+}
+
+template <typename K, typename V, typename Compare>
+bool persistent_map<K, V, Compare>::insert(const K &key, const V &value) {
+  bool inserted = false;
+  root = insert(root, key, value, false, inserted);
+  size_ += inserted;
+  return inserted;
+}
+
+template <typename K, typename V, typename Compare>
+bool persistent_map<K, V, Compare>::insert_or_assign(const K &key,
+                                                     const V &value) {
+  bool inserted = false;
+  root = insert(root, key, value, true, inserted);
+  size_ += inserted;
+  return inserted;
+}
+
+template <typename K, typename V, typename Compare>
+typename persistent_map<K, V, Compare>::size_type
+persistent_map<K, V, Compare>::erase(const K &key) {
+  bool erased = false;
+  root = erase(root, key, erased);
+  size_ -= erased;
+  return erased ? 1 : 0;
+}
+
+template <typename K, typename V, typename Compare>
+void persistent_map<K, V, Compare>::clear() {
+  root.reset();
+  size_ = 0;
+}
+
+template <typename K, typename V, typename Compare>
+void persistent_map<K, V, Compare>::swap(persistent_map &other) {
+  std::swap(root, other.root);
+  std::swap(size_, other.size_);
+  std::swap(comp, other.comp);
+}
+
+template <typename K, typename V, typename Compare>
+const V &persistent_map<K, V, Compare>::at(const K &key) const {
+  const Node *node = search(key);
+  if (node == nullptr) {
+    throw std::out_of_range("Key not found");
+  }
+  return node->second;
+}
+
+template <typename K, typename V, typename Compare>
+const V *persistent_map<K, V, Compare>::find(const K &key) const {
+  const Node *node = search(key);
+  return node ? &node->second : nullptr;
+}
+
+template <typename K, typename V, typename Compare>
+bool persistent_map<K, V, Compare>::contains(const K &key) const {
+  return search(key) != nullptr;
+}
+
+template <typename K, typename V, typename Compare>
+typename persistent_map<K, V, Compare>::size_type
+persistent_map<K, V, Compare>::count(const K &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+template <typename K, typename V, typename Compare>
+typename persistent_map<K, V, Compare>::size_type
+persistent_map<K, V, Compare>::size() const {
+  return size_;
+}
+
+template <typename K, typename V, typename Compare>
+bool persistent_map<K, V, Compare>::empty() const {
+  return size_ == 0;
+}
+
+template <typename K, typename V, typename Compare>
+typename persistent_map<K, V, Compare>::key_compare
+persistent_map<K, V, Compare>::key_comp() const {
+  return comp;
+}
+
+template <typename K, typename V, typename Compare>
+typename persistent_map<K, V, Compare>::ConstIterator
+persistent_map<K, V, Compare>::begin() const {
+  return ConstIterator(root.get());
+}
+
+template <typename K, typename V, typename Compare>
+typename persistent_map<K, V, Compare>::ConstIterator
+persistent_map<K, V, Compare>::end() const {
+  return ConstIterator();
+}
+
+template <typename K, typename V, typename Compare>
+persistent_map<K, V, Compare>::ConstIterator::ConstIterator(const Node *root) {
+  descendLeft(root);
+}
+
+template <typename K, typename V, typename Compare>
+void persistent_map<K, V, Compare>::ConstIterator::descendLeft(
+    const Node *node) {
+  for (; node != nullptr; node = node->left.get()) {
+    path.push_back(node);
+  }
+}
+
+template <typename K, typename V, typename Compare>
+bool persistent_map<K, V, Compare>::ConstIterator::operator==(
+    const ConstIterator &other) const {
+  if (path.empty() || other.path.empty()) {
+    return path.empty() == other.path.empty();
+  }
+  return path.back() == other.path.back();
+}
+
+template <typename K, typename V, typename Compare>
+bool persistent_map<K, V, Compare>::ConstIterator::operator!=(
+    const ConstIterator &other) const {
+  return !(*this == other);
+}
+
+template <typename K, typename V, typename Compare>
+typename persistent_map<K, V, Compare>::ConstIterator &
+persistent_map<K, V, Compare>::ConstIterator::operator++() {
+  if (!path.empty()) {
+    const Node *node = path.back();
+    path.pop_back();
+    descendLeft(node->right.get());
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename Compare>
+typename persistent_map<K, V, Compare>::ConstIterator
+persistent_map<K, V, Compare>::ConstIterator::operator++(int) {
+  ConstIterator tmp = *this;
+  ++*this;
+  return tmp;
+}
+
+template <typename K, typename V, typename Compare>
+const typename persistent_map<K, V, Compare>::Node &
+persistent_map<K, V, Compare>::ConstIterator::operator*() const {
+  if (path.empty()) {
+    throw std::runtime_error("Dereferencing null iterator");
+  }
+  return *path.back();
+}
+
+template <typename K, typename V, typename Compare>
+const typename persistent_map<K, V, Compare>::Node *
+persistent_map<K, V, Compare>::ConstIterator::operator->() const {
+  return &**this;
+}
@@ -26,6 +26,7 @@ class queue {
   void push(const_reference value) { queue_.push_back(value); };
   void pop() { queue_.pop_front(); };
   void swap(queue &other) { queue_.swap(other.queue_); };
+  memory_stats memory_usage() const { return queue_.memory_usage(); };
 
  private:
   list<T> queue_;
@@ -0,0 +1,99 @@
+#ifndef SRC_S21_RADIX_SORT_H_
+#define SRC_S21_RADIX_SORT_H_
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+#include "s21_vector.h"
+
+namespace s21 {
+
+// LSD radix sort on 8-bit digits, least significant first: one pass to
+// count every digit of every key, then one stable scatter per digit into
+// the other of two buffers. A digit all keys share is skipped, so small
+// values in wide types cost fewer passes. O(n * sizeof(key)) with no
+// comparisons; stable, so equal keys keep their order.
+//
+// Keys are integers other than bool, and IEEE float and double, ordered as
+// by <, except that -0.0 sorts before 0.0 and NaNs go to the ends by their
+// sign bit. Structs are sorted by a key extracted from each element; when
+// they are wider than the key and a 32-bit index, those pairs are sorted
+// instead and each element is moved once, into its final place.
+// list::radix_sort relinks nodes into buckets instead of moving elements.
+template <typename K>
+concept radix_key =
+    (std::is_integral_v<K> && !std::is_same_v<K, bool>) ||
+    (std::is_floating_point_v<K> && std::numeric_limits<K>::is_iec559 &&
+     (sizeof(K) == 4 || sizeof(K) == 8));
+
+// The buffer holds v.size() default-constructed elements.
+template <radix_key T>
+void radix_sort(vector<T> &v);
+template <typename T, typename Key>
+  requires radix_key<std::decay_t<std::invoke_result_t<Key &, const T &>>>
+void radix_sort(vector<T> &v, Key key);
+
+namespace radix_detail {
+
+constexpr int kDigitBits = 8;
+constexpr size_t kBuckets = size_t(1) << kDigitBits;
+// Below this, clearing the counts costs more than a comparison sort.
+constexpr size_t kMinElements = 64;
+// How far ahead the scatter prefetches its destination slot.
+constexpr size_t kPrefetchDistance = 16;
+
+template <typename K>
+using bits_type = std::conditional_t<
+    sizeof(K) == 1, uint8_t,
+    std::conditional_t<
+        sizeof(K) == 2, uint16_t,
+        std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>>>;
+
+// The key as an unsigned integer that orders the same way: signed integers
+// have their sign bit flipped; negative floats have every bit flipped, so
+// that larger magnitudes come first, and other floats just the sign bit.
+template <radix_key K>
+bits_type<K> ordered(K key) {
+  using U = bits_type<K>;
+  constexpr U kSign = U(1) << (sizeof(U) * 8 - 1);
+  if constexpr (std::is_floating_point_v<K>) {
+    U bits = std::bit_cast<U>(key);
+    return (bits & kSign) ? U(~bits) : U(bits | kSign);
+  } else if constexpr (std::is_signed_v<K>) {
+    return U(key) ^ kSign;
+  } else {
+    return key;
+  }
+}
+
+template <typename U>
+size_t digit(U bits, int pass) {
+  return size_t(bits >> (pass * kDigitBits)) & (kBuckets - 1);
+}
+
+// What sortIndirect sorts in place of a wide element.
+template <typename U>
+struct entry {
+  U key;
+  uint32_t index;
+};
+
+// Sorts v by bits(element), an unsigned integer.
+template <typename T, typename Bits>
+void sortBy(vector<T> &v, Bits bits);
+template <typename T, typename Bits>
+void sortIndirect(vector<T> &v, Bits bits);
+// sortIndirect for elements wider than an entry, else sortBy.
+template <typename T, typename Bits>
+void sort(vector<T> &v, Bits bits);
+
+}  // namespace radix_detail
+
+#include "s21_radix_sort.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_RADIX_SORT_H_
@@ -0,0 +1,95 @@
+using namespace s21;
+
+template <typename T, typename Bits>
+void radix_detail::sortBy(vector<T> &v, Bits bits) {
+  using U = std::decay_t<std::invoke_result_t<Bits &, const T &>>;
+  constexpr int kPasses = sizeof(U) * 8 / kDigitBits;
+  size_t n = v.size();
+  if (n < kMinElements) {
+    std::stable_sort(v.begin(), v.end(), [&bits](const T &a, const T &b) {
+      return bits(a) < bits(b);
+    });
+    return;
+  }
+  size_t counts[kPasses][kBuckets] = {};
+  for (size_t i = 0; i < n; i++) {
+    U key = bits(v[i]);
+    for (int pass = 0; pass < kPasses; pass++) {
+      ++counts[pass][digit(key, pass)];
+    }
+  }
+
+  vector<T> buffer(n);
+  T *from = v.data();
+  T *to = buffer.data();
+  for (int pass = 0; pass < kPasses; pass++) {
+    const size_t *count = counts[pass];
+    if (count[digit(bits(from[0]), pass)] == n) {
+      continue;
+    }
+    size_t offset[kBuckets];
+    size_t total = 0;
+    for (size_t b = 0; b < kBuckets; b++) {
+      offset[b] = total;
+      total += count[b];
+    }
+    // Writes go to up to 256 places at once; fetching the slot of an
+    // element a little ahead hides some of the misses.
+    size_t i = 0;
+    for (; i + kPrefetchDistance < n; i++) {
+#if defined(__GNUC__)
+      __builtin_prefetch(
+          to + offset[digit(bits(from[i + kPrefetchDistance]), pass)], 1);
+#endif
+      to[offset[digit(bits(from[i]), pass)]++] = std::move(from[i]);
+    }
+    for (; i < n; i++) {
+      to[offset[digit(bits(from[i]), pass)]++] = std::move(from[i]);
+    }
+    std::swap(from, to);
+  }
+  if (from != v.data()) {
+    v.swap(buffer);
+  }
+}
+
+// The (key, index) pairs are sorted instead of the elements, which are
+// then gathered into place in one pass.
+template <typename T, typename Bits>
+void radix_detail::sortIndirect(vector<T> &v, Bits bits) {
+  using U = std::decay_t<std::invoke_result_t<Bits &, const T &>>;
+  using Entry = entry<U>;
+  vector<Entry> entries(v.size());
+  for (size_t i = 0; i < v.size(); i++) {
+    entries[i] = Entry{bits(v[i]), static_cast<uint32_t>(i)};
+  }
+  sortBy(entries, [](const Entry &item) { return item.key; });
+  vector<T> sorted(v.size());
+  for (size_t i = 0; i < v.size(); i++) {
+    sorted[i] = std::move(v[entries[i].index]);
+  }
+  v.swap(sorted);
+}
+
+template <typename T, typename Bits>
+void radix_detail::sort(vector<T> &v, Bits bits) {
+  using U = std::decay_t<std::invoke_result_t<Bits &, const T &>>;
+  if (sizeof(T) > sizeof(entry<U>) && v.size() >= kMinElements &&
+      v.size() <= std::numeric_limits<uint32_t>::max()) {
+    sortIndirect(v, bits);
+  } else {
+    sortBy(v, bits);
+  }
+}
+
+template <radix_key T>
+void radix_sort(vector<T> &v) {
+  radix_detail::sortBy(v, [](T x) { return radix_detail::ordered(x); });
+}
+
+template <typename T, typename Key>
+  requires radix_key<std::decay_t<std::invoke_result_t<Key &, const T &>>>
+void radix_sort(vector<T> &v, Key key) {
+  radix_detail::sort(
+      v, [&key](const T &x) { return radix_detail::ordered(key(x)); });
+}
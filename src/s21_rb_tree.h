@@ -0,0 +1,376 @@
+#ifndef SRC_S21_RB_TREE_H_
+#define SRC_S21_RB_TREE_H_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Shape of a map or set, for spotting degenerate trees. Depths count edges
+// from the root, so the root is at depth 0 and a tree of height h has
+// nodes down to depth h - 1.
+struct tree_stats {
+  size_t size = 0;
+  size_t height = 0;  // nodes on the longest root-to-leaf path
+  size_t max_depth = 0;
+  double average_depth = 0;
+  // height over the least height possible for size nodes: 1 for a perfectly
+  // balanced tree; a red-black tree never exceeds 2.
+  double balance = 0;
+  std::vector<size_t> depth_histogram;  // [d] = nodes at depth d
+};
+
+// Red-black balancing shared by map and set. Each tree keeps its own node
+// type; a node only needs left, right and parent links and a bool red, and
+// null children count as black. Nothing here compares keys: the tree finds
+// the slot for a new node and links it in as a leaf before calling
+// insert_fixup, and hands erase a node that is already known to be in it.
+// Every path from the root to a null link then holds the same number of
+// black nodes and no red node has a red child, which bounds the depth by
+// 2 * log2(n + 1).
+namespace rb_tree {
+
+template <typename Node>
+bool is_red(const Node *node) {
+  return node != nullptr && node->red;
+}
+
+// Puts child where node hangs from its parent (or at the root).
+template <typename Node>
+void replace(Node *&root, Node *node, Node *child) {
+  if (node->parent == nullptr) {
+    root = child;
+  } else if (node == node->parent->left) {
+    node->parent->left = child;
+  } else {
+    node->parent->right = child;
+  }
+  if (child != nullptr) {
+    child->parent = node->parent;
+  }
+}
+
+template <typename Node>
+void rotate_left(Node *&root, Node *node) {
+  Node *pivot = node->right;
+  node->right = pivot->left;
+  if (pivot->left != nullptr) {
+    pivot->left->parent = node;
+  }
+  replace(root, node, pivot);
+  pivot->left = node;
+  node->parent = pivot;
+}
+
+template <typename Node>
+void rotate_right(Node *&root, Node *node) {
+  Node *pivot = node->left;
+  node->left = pivot->right;
+  if (pivot->right != nullptr) {
+    pivot->right->parent = node;
+  }
+  replace(root, node, pivot);
+  pivot->right = node;
+  node->parent = pivot;
+}
+
+// node has just been linked in as a leaf.
+template <typename Node>
+void insert_fixup(Node *&root, Node *node) {
+  node->red = true;
+  while (is_red(node->parent)) {
+    Node *parent = node->parent;
+    Node *grandparent = parent->parent;
+    bool onLeft = parent == grandparent->left;
+    Node *uncle = onLeft ? grandparent->right : grandparent->left;
+    if (is_red(uncle)) {
+      parent->red = false;
+      uncle->red = false;
+      grandparent->red = true;
+      node = grandparent;
+      continue;
+    }
+    if (onLeft && node == parent->right) {
+      rotate_left(root, parent);
+      parent = node;
+    } else if (!onLeft && node == parent->left) {
+      rotate_right(root, parent);
+      parent = node;
+    }
+    parent->red = false;
+    grandparent->red = true;
+    if (onLeft) {
+      rotate_right(root, grandparent);
+    } else {
+      rotate_left(root, grandparent);
+    }
+    break;
+  }
+  root->red = false;
+}
+
+// One black node was removed from the paths through node, a child of
+// parent; node may be null.
+template <typename Node>
+void erase_fixup(Node *&root, Node *node, Node *parent) {
+  while (node != root && !is_red(node)) {
+    bool onLeft = node == parent->left;
+    Node *sibling = onLeft ? parent->right : parent->left;
+    if (sibling->red) {
+      sibling->red = false;
+      parent->red = true;
+      if (onLeft) {
+        rotate_left(root, parent);
+        sibling = parent->right;
+      } else {
+        rotate_right(root, parent);
+        sibling = parent->left;
+      }
+    }
+    if (!is_red(sibling->left) && !is_red(sibling->right)) {
+      sibling->red = true;
+      node = parent;
+      parent = node->parent;
+      continue;
+    }
+    if (onLeft && !is_red(sibling->right)) {
+      sibling->left->red = false;
+      sibling->red = true;
+      rotate_right(root, sibling);
+      sibling = parent->right;
+    } else if (!onLeft && !is_red(sibling->left)) {
+      sibling->right->red = false;
+      sibling->red = true;
+      rotate_left(root, sibling);
+      sibling = parent->left;
+    }
+    sibling->red = parent->red;
+    parent->red = false;
+    if (onLeft) {
+      sibling->right->red = false;
+      rotate_left(root, parent);
+    } else {
+      sibling->left->red = false;
+      rotate_right(root, parent);
+    }
+    node = root;
+  }
+  if (node != nullptr) {
+    node->red = false;
+  }
+}
+
+// Unlinks node and rebalances. node's own links are left as they were.
+template <typename Node>
+void erase(Node *&root, Node *node) {
+  Node *child;
+  Node *parent;
+  bool removedRed;
+  if (node->left == nullptr || node->right == nullptr) {
+    child = (node->left != nullptr) ? node->left : node->right;
+    parent = node->parent;
+    removedRed = node->red;
+    replace(root, node, child);
+  } else {
+    // The successor takes node's place and colour; the tree loses a node
+    // where the successor used to be.
+    Node *next = node->right;
+    while (next->left != nullptr) {
+      next = next->left;
+    }
+    child = next->right;
+    removedRed = next->red;
+    if (next->parent == node) {
+      parent = next;
+    } else {
+      parent = next->parent;
+      replace(root, next, child);
+      next->right = node->right;
+      next->right->parent = next;
+    }
+    replace(root, node, next);
+    next->left = node->left;
+    next->left->parent = next;
+    next->red = node->red;
+  }
+  if (!removedRed) {
+    erase_fixup(root, child, parent);
+  }
+}
+
+template <typename Node>
+Node *build(Node *&list, size_t n, Node *parent, int depth, int redDepth) {
+  if (n == 0) {
+    return nullptr;
+  }
+  Node *left = build(list, n / 2, static_cast<Node *>(nullptr), depth + 1,
+                     redDepth);
+  Node *node = list;
+  list = list->right;
+  node->parent = parent;
+  node->left = left;
+  node->red = depth == redDepth;
+  if (left != nullptr) {
+    left->parent = node;
+  }
+  node->right = build(list, n - n / 2 - 1, node, depth + 1, redDepth);
+  return node;
+}
+
+// Builds a tree from the first n nodes of a list chained through right,
+// consuming them. The two halves under every node differ by at most one
+// node, so all null links lie on the two bottom levels; painting the
+// deepest level red and the rest black gives every path the same black
+// count.
+template <typename Node>
+Node *build(Node *&list, size_t n) {
+  Node *root = build(list, n, static_cast<Node *>(nullptr), 0,
+                     static_cast<int>(std::bit_width(n)) - 1);
+  if (root != nullptr) {
+    root->red = false;
+  }
+  return root;
+}
+
+template <typename Node>
+tree_stats measure(const Node *root) {
+  tree_stats stats;
+  size_t depthSum = 0;
+  std::vector<std::pair<const Node *, size_t>> pending;
+  if (root != nullptr) {
+    pending.emplace_back(root, 0);
+  }
+  while (!pending.empty()) {
+    auto [node, depth] = pending.back();
+    pending.pop_back();
+    if (stats.depth_histogram.size() <= depth) {
+      stats.depth_histogram.resize(depth + 1);
+    }
+    ++stats.depth_histogram[depth];
+    ++stats.size;
+    depthSum += depth;
+    if (node->left != nullptr) {
+      pending.emplace_back(node->left, depth + 1);
+    }
+    if (node->right != nullptr) {
+      pending.emplace_back(node->right, depth + 1);
+    }
+  }
+  stats.height = stats.depth_histogram.size();
+  if (stats.size != 0) {
+    stats.max_depth = stats.height - 1;
+    stats.average_depth = static_cast<double>(depthSum) / stats.size;
+    stats.balance = static_cast<double>(stats.height) /
+                    static_cast<double>(std::bit_width(stats.size));
+  }
+  return stats;
+}
+
+// At most parts nodes, in key order, that cut the tree into runs of
+// similar length: the first is the leftmost node and each run goes up to
+// the next. They are taken from the shallowest level with parts nodes (or
+// the widest level there is), so finding them costs O(parts + height).
+template <typename Node>
+std::vector<Node *> split(Node *root, size_t parts) {
+  std::vector<Node *> level;
+  if (root != nullptr && parts != 0) {
+    level.push_back(root);
+  }
+  while (level.size() < parts) {
+    std::vector<Node *> next;
+    for (Node *node : level) {
+      if (node->left != nullptr) {
+        next.push_back(node->left);
+      }
+      if (node->right != nullptr) {
+        next.push_back(node->right);
+      }
+    }
+    if (next.size() <= level.size()) {
+      break;
+    }
+    level.swap(next);
+  }
+  std::vector<Node *> cuts;
+  size_t count = std::min(parts, level.size());
+  for (size_t i = 0; i < count; i++) {
+    cuts.push_back(level[i * level.size() / count]);
+  }
+  if (!cuts.empty()) {
+    while (cuts[0]->left != nullptr) {
+      cuts[0] = cuts[0]->left;
+    }
+  }
+  return cuts;
+}
+
+// Checks, in one in-order walk, that keys are strictly increasing under
+// less(a, b), every child points back at its parent, the red-black rules
+// hold and there are exactly size nodes. A walk that finds more nodes than
+// size stops, so a corrupted tree with a cycle fails instead of hanging.
+template <typename Node, typename Less>
+bool validate(const Node *root, size_t size, Less less) {
+  if (root == nullptr) {
+    return size == 0;
+  }
+  if (root->parent != nullptr || root->red) {
+    return false;
+  }
+  // Black nodes from the root down to (and including) the node on top.
+  std::vector<std::pair<const Node *, size_t>> path;
+  size_t leafBlacks = 0;
+  bool sawLeaf = false;
+  auto nullLink = [&](size_t blacks) {
+    if (!sawLeaf) {
+      sawLeaf = true;
+      leafBlacks = blacks;
+    }
+    return blacks == leafBlacks;
+  };
+  const Node *previous = nullptr;
+  size_t count = 0;
+  const Node *node = root;
+  size_t blacks = 0;
+  while (node != nullptr || !path.empty()) {
+    while (node != nullptr) {
+      blacks += !node->red;
+      path.emplace_back(node, blacks);
+      const Node *left = node->left;
+      if (left == nullptr) {
+        if (!nullLink(blacks)) {
+          return false;
+        }
+      } else if (left->parent != node || (node->red && left->red)) {
+        return false;
+      }
+      node = left;
+    }
+    auto [current, currentBlacks] = path.back();
+    path.pop_back();
+    if (++count > size ||
+        (previous != nullptr && !less(previous, current))) {
+      return false;
+    }
+    previous = current;
+    const Node *right = current->right;
+    if (right == nullptr) {
+      if (!nullLink(currentBlacks)) {
+        return false;
+      }
+    } else if (right->parent != current || (current->red && right->red)) {
+      return false;
+    }
+    node = right;
+    blacks = currentBlacks;
+  }
+  return count == size;
+}
+
+}  // namespace rb_tree
+
+}  // namespace s21
+
+#endif  //  SRC_S21_RB_TREE_H_
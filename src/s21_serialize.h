@@ -0,0 +1,281 @@
+#ifndef SRC_S21_SERIALIZE_H_
+#define SRC_S21_SERIALIZE_H_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace s21 {
+
+// Binary format of map::save and set::save, in the machine's byte order:
+//
+//   header   "s21" + 'm' or 's', uint32 version, uint64 count,
+//            uint32 key size, uint32 value size (0 for a set)
+//   records  count keys (and values) in key order, each through
+//            serializer<T>
+//   checksum uint64 over the header and the records
+//
+// A size in the header is sizeof(T) for types stored as raw bytes and 0
+// for others, so that loading into a map of different types fails at once
+// rather than reading garbage. Loading checks the magic, version, sizes
+// and checksum and throws std::runtime_error on a mismatch, a short read
+// or a count larger than the container can hold.
+//
+// serializer<T> is the customization point: trivially copyable types are
+// copied as raw bytes, and std::string is written as a uint64 length and
+// the characters. Other types need a specialization with
+//   static void write(serial_writer &out, const T &value);
+//   static T read(serial_reader &in);
+template <typename T>
+struct serializer;
+
+// Streaming hash of the bytes it is fed, in 8-byte words, so the result
+// does not depend on how the bytes are split between calls. Each step is a
+// bijection of the state, so any change to a single word is detected.
+class checksum {
+ public:
+  void update(const void *data, size_t n) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    total_ += n;
+    while (n != 0 && pending_ != 0) {
+      word_[pending_++] = *bytes++;
+      --n;
+      if (pending_ == 8) {
+        mix(load(word_));
+        pending_ = 0;
+      }
+    }
+    for (; n >= 8; n -= 8, bytes += 8) {
+      mix(load(bytes));
+    }
+    std::memcpy(word_, bytes, n);
+    pending_ = n;
+  }
+
+  uint64_t value() const {
+    checksum copy = *this;
+    std::memset(copy.word_ + copy.pending_, 0, 8 - copy.pending_);
+    copy.mix(load(copy.word_));
+    copy.mix(total_);
+    return copy.state_;
+  }
+
+ private:
+  static uint64_t load(const unsigned char *bytes) {
+    uint64_t word;
+    std::memcpy(&word, bytes, 8);
+    return word;
+  }
+  void mix(uint64_t word) {
+    state_ = std::rotl((state_ ^ word) * 0x100000001b3ull, 29);
+  }
+
+  uint64_t state_ = 0xcbf29ce484222325ull;
+  uint64_t total_ = 0;
+  unsigned char word_[8] = {};
+  size_t pending_ = 0;
+};
+
+// Buffers writes to a stream in large blocks and checksums them.
+class serial_writer {
+ public:
+  explicit serial_writer(std::ostream &out) : out_(out) {
+    buffer_.reserve(kBufferSize);
+  }
+
+  void bytes(const void *data, size_t n) {
+    sum_.update(data, n);
+    append(data, n);
+  }
+  template <typename T>
+  void value(const T &value) {
+    serializer<T>::write(*this, value);
+  }
+  // Appends the checksum and flushes.
+  void finish() {
+    uint64_t sum = sum_.value();
+    append(&sum, sizeof(sum));
+    drain();
+    out_.flush();
+    if (!out_) {
+      throw std::runtime_error("s21 serialization: write failed");
+    }
+  }
+
+ private:
+  static constexpr size_t kBufferSize = size_t(1) << 16;
+
+  void append(const void *data, size_t n) {
+    const char *bytes = static_cast<const char *>(data);
+    if (buffer_.size() + n > kBufferSize) {
+      drain();
+    }
+    if (n >= kBufferSize) {
+      out_.write(bytes, static_cast<std::streamsize>(n));
+    } else {
+      buffer_.insert(buffer_.end(), bytes, bytes + n);
+    }
+  }
+  void drain() {
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+  }
+
+  std::ostream &out_;
+  std::vector<char> buffer_;
+  checksum sum_;
+};
+
+// Reads a stream in large blocks and checksums what is consumed. finish()
+// seeks back over what was read past the end, so several snapshots can
+// follow one another in a file; on a stream that cannot seek they are lost.
+class serial_reader {
+ public:
+  explicit serial_reader(std::istream &in) : in_(in), buffer_(kBufferSize) {}
+
+  void bytes(void *data, size_t n) {
+    take(data, n);
+    sum_.update(data, n);
+  }
+  template <typename T>
+  T value() {
+    return serializer<T>::read(*this);
+  }
+  // Reads the stored checksum and compares it with the bytes consumed.
+  void finish() {
+    uint64_t stored;
+    take(&stored, sizeof(stored));
+    if (stored != sum_.value()) {
+      throw std::runtime_error("s21 serialization: checksum mismatch");
+    }
+    if (begin_ != end_) {
+      in_.clear();
+      in_.seekg(-static_cast<std::streamoff>(end_ - begin_), std::ios::cur);
+      begin_ = end_;
+    }
+  }
+
+ private:
+  static constexpr size_t kBufferSize = size_t(1) << 16;
+
+  void take(void *data, size_t n) {
+    char *out = static_cast<char *>(data);
+    while (n != 0) {
+      if (begin_ == end_ && !refill()) {
+        throw std::runtime_error("s21 serialization: unexpected end of data");
+      }
+      size_t chunk = std::min(n, end_ - begin_);
+      std::memcpy(out, buffer_.data() + begin_, chunk);
+      begin_ += chunk;
+      out += chunk;
+      n -= chunk;
+    }
+  }
+  bool refill() {
+    in_.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    begin_ = 0;
+    end_ = static_cast<size_t>(in_.gcount());
+    return end_ != 0;
+  }
+
+  std::istream &in_;
+  std::vector<char> buffer_;
+  size_t begin_ = 0;
+  size_t end_ = 0;
+  checksum sum_;
+};
+
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+struct serializer<T> {
+  static void write(serial_writer &out, const T &value) {
+    out.bytes(&value, sizeof(T));
+  }
+  static T read(serial_reader &in) {
+    std::array<std::byte, sizeof(T)> raw;
+    in.bytes(raw.data(), sizeof(T));
+    return std::bit_cast<T>(raw);
+  }
+};
+
+template <>
+struct serializer<std::string> {
+  static void write(serial_writer &out, const std::string &value) {
+    out.value<uint64_t>(value.size());
+    out.bytes(value.data(), value.size());
+  }
+  // The length is not checked until the checksum is, so the string grows
+  // only as its bytes arrive: a corrupt length runs into the end of the
+  // data instead of allocating it up front.
+  static std::string read(serial_reader &in) {
+    constexpr size_t kChunk = size_t(1) << 16;
+    uint64_t length = in.value<uint64_t>();
+    std::string value;
+    while (value.size() < length) {
+      size_t start = value.size();
+      size_t n =
+          static_cast<size_t>(std::min<uint64_t>(kChunk, length - start));
+      value.resize(start + n);
+      in.bytes(value.data() + start, n);
+    }
+    return value;
+  }
+};
+
+namespace serial_detail {
+
+constexpr uint32_t kVersion = 1;
+
+// The size recorded for T: sizeof(T) when stored as raw bytes, else 0.
+template <typename T>
+constexpr uint32_t recordSize() {
+  return std::is_trivially_copyable_v<T> ? sizeof(T) : 0;
+}
+
+inline void writeHeader(serial_writer &out, char kind, uint64_t count,
+                        uint32_t key_size, uint32_t value_size) {
+  const char magic[4] = {'s', '2', '1', kind};
+  out.bytes(magic, sizeof(magic));
+  out.value(kVersion);
+  out.value(count);
+  out.value(key_size);
+  out.value(value_size);
+}
+
+// Returns the count, which is at most max_count.
+inline uint64_t readHeader(serial_reader &in, char kind, uint32_t key_size,
+                           uint32_t value_size, uint64_t max_count) {
+  char magic[4];
+  in.bytes(magic, sizeof(magic));
+  if (std::memcmp(magic, "s21", 3) != 0 || magic[3] != kind) {
+    throw std::runtime_error("s21 serialization: not a saved " +
+                             std::string(kind == 'm' ? "map" : "set"));
+  }
+  if (in.value<uint32_t>() != kVersion) {
+    throw std::runtime_error("s21 serialization: unsupported version");
+  }
+  uint64_t count = in.value<uint64_t>();
+  if (count > max_count) {
+    throw std::runtime_error("s21 serialization: too many elements");
+  }
+  if (in.value<uint32_t>() != key_size ||
+      in.value<uint32_t>() != value_size) {
+    throw std::runtime_error("s21 serialization: saved with other types");
+  }
+  return count;
+}
+
+}  // namespace serial_detail
+
+}  // namespace s21
+
+#endif  //  SRC_S21_SERIALIZE_H_
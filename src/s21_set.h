@@ -1,10 +1,23 @@
+#ifndef SRC_S21_SET_H_
+#define SRC_S21_SET_H_
+
+#include <bit>
+#include <functional>
 #include <initializer_list>
 #include <iostream>
+#include <limits>
 #include <utility>
+#include <vector>
+
+#include "s21_memory_stats.h"
+#include "s21_rb_tree.h"
+#include "s21_serialize.h"
+#include "s21_trace.h"
+#include "s21_tree_compare.h"
 
 namespace s21 {
 
-template <typename T>
+template <typename T, typename Compare = std::less<>>
 class set {
  private:
   struct Node {
@@ -12,24 +25,49 @@ class set {
     Node *left;
     Node *right;
     Node *parent;
+    bool red;
     Node(const T &val, Node *parentNode)
-        : value(val), left(nullptr), right(nullptr), parent(parentNode) {}
+        : value(val),
+          left(nullptr),
+          right(nullptr),
+          parent(parentNode),
+          red(false) {}
   };
 
   Node *root = nullptr;
   int size_ = 0;
+  Compare comp;
+  [[no_unique_address]] memory_counter<memory_category::set> accounting_;
+  Node *createNode(const T &value, Node *parent);
+  void destroyNode(Node *node);
+  static void destroyDetached(Node *node);
   static Node *findLeftmost(Node *node);
   static Node *findRightmost(Node *node);
-  Node *insert(Node *node, const T &value, Node *parent);
-  Node *remove(Node *node, const T &value);
+  static Node *successor(Node *node);
+  static Node *predecessor(Node *node);
   Node *find(Node *node, const T &value) const;
+  Node *findSlot(const T &value, Node *&parent, bool &left) const;
+  Node *attach(Node *node, Node *parent, bool left);
+  void detach(Node *node);
+  void unlink(Node *node);
   void clear(Node *node);
 
+  // Bulk helpers. A "list" is a chain of nodes linked through right.
+  static Node *flatten(Node *node);
+  Node *cloneList(Node *node);
+  bool isSorted(const Node *list) const;
+  Node *sortList(Node *&list, int n);
+  int dropDuplicates(Node *list);
+
  public:
   using value_type = T;
+  using key_compare = Compare;
 
   set() = default;
+  explicit set(const Compare &compare);
   set(std::initializer_list<T> const &items);
+  template <typename InputIt>
+  set(InputIt first, InputIt last, const Compare &compare = Compare());
   set(const set &other);
   set(set &&other) noexcept;
   ~set();
@@ -44,51 +82,112 @@ class set {
   void swap(set &other);
   void merge(set &other);
   bool empty() const;
+  key_compare key_comp() const;
+  memory_stats memory_usage() const;
+
+  // Diagnostics, both O(n). stats() describes the tree's shape; validate()
+  // checks value order, parent links, the red-black rules and size().
+  tree_stats stats() const;
+  bool validate() const;
+
+  // Binary snapshot in the format of s21_serialize.h. load() replaces the
+  // contents, linking the nodes into a balanced tree in O(n) when the keys
+  // arrive in order, as save() writes them; if it throws, the set is
+  // unchanged.
+  void save(std::ostream &out) const;
+  void load(std::istream &in);
 
   class Iterator;
   class ConstIterator;
+  class node_type;
+  struct insert_return_type;
 
   Iterator begin();
   Iterator end();
   Iterator find(const T &value);
   ConstIterator begin() const;
   ConstIterator end() const;
+
+  // Cuts the elements into at most parts runs of similar length for
+  // walking from several threads: run i is [cuts[i], cuts[i + 1]), the
+  // first cut is begin() and the last end(). O(parts + height).
+  std::vector<ConstIterator> split(size_t parts) const;
+
+  // Node handles: extract unlinks a node and hands over ownership,
+  // inserting the handle relinks that same node without copying the value.
+  node_type extract(const T &value);
+  node_type extract(Iterator pos);
+  insert_return_type insert(node_type &&handle);
 };
 
-template <typename T>
-class set<T>::Iterator {
+// In-order iterators. end() is a null node; the owning set is kept so that
+// --end() can step back onto the largest element.
+template <typename T, typename Compare>
+class set<T, Compare>::Iterator {
  private:
+  friend class set;
   Node *current;
-  Node *treeRoot;
+  const set *owner;
 
  public:
-  Iterator(Node *root);
+  Iterator(Node *node, const set *tree);
+  bool operator==(const Iterator &other) const;
   bool operator!=(const Iterator &other) const;
   Iterator &operator++();
+  Iterator operator++(int);
   Iterator &operator--();
+  Iterator operator--(int);
   const T &operator*() const;
   const T *operator->() const;
 
-  operator ConstIterator() const { return ConstIterator(current, treeRoot); }
+  operator ConstIterator() const { return ConstIterator(current, owner); }
 };
 
-template <typename T>
-class set<T>::ConstIterator {
+template <typename T, typename Compare>
+class set<T, Compare>::ConstIterator {
  private:
-  Node *current;
-  Node *treeRoot;
+  const Node *current;
+  const set *owner;
 
  public:
-  ConstIterator(Node *root);
-  ConstIterator(const Node *root);
-  ConstIterator(Node *root, Node *treeRoot);
+  ConstIterator(const Node *node, const set *tree);
+  bool operator==(const ConstIterator &other) const;
   bool operator!=(const ConstIterator &other) const;
   ConstIterator &operator++();
+  ConstIterator operator++(int);
   ConstIterator &operator--();
+  ConstIterator operator--(int);
   const T &operator*() const;
   const T *operator->() const;
 };
 
+template <typename T, typename Compare>
+class set<T, Compare>::node_type {
+ public:
+  node_type() : node(nullptr) {}
+  node_type(node_type &&other) noexcept;
+  node_type &operator=(node_type &&other) noexcept;
+  ~node_type();
+
+  bool empty() const;
+  explicit operator bool() const;
+  T &value() const;
+
+ private:
+  friend class set;
+  explicit node_type(Node *owned) : node(owned) {}
+  Node *node;
+};
+
+template <typename T, typename Compare>
+struct set<T, Compare>::insert_return_type {
+  Iterator position;
+  bool inserted;
+  node_type node;
+};
+
 #include "s21_set.tpp"
 
 }  // namespace s21
+
+#endif  //  SRC_S21_SET_H_
@@ -1,176 +1,445 @@
 using namespace s21;
 
-template <typename T>
-typename set<T>::Node *set<T>::insert(Node *node, const T &value,
-                                      Node *parent) {
-  if (node == nullptr) {
-    node = new Node(value, parent);
-    ++size_;
-  } else if (value < node->value) {
-    node->left = insert(node->left, value, node);
-  } else if (value > node->value) {
-    node->right = insert(node->right, value, node);
-  }
+template <typename T, typename Compare>
+typename set<T, Compare>::Node *set<T, Compare>::createNode(const T &value,
+                                                            Node *parent) {
+  Node *node = new Node(value, parent);
+  accounting_.allocated(sizeof(Node));
   return node;
 }
 
-template <typename T>
-typename set<T>::Node *set<T>::remove(Node *node, const T &value) {
-  if (node == nullptr) {
-    return nullptr;
-  } else if (value < node->value) {
-    node->left = remove(node->left, value);
-  } else if (value > node->value) {
-    node->right = remove(node->right, value);
-  } else {
-    if (node->left == nullptr && node->right == nullptr) {
-      delete node;
-      node = nullptr;
-      --size_;
-    } else if (node->left == nullptr) {
-      Node *temp = node;
-      node = node->right;
-      node->parent = temp->parent;
-      delete temp;
-      --size_;
-    } else if (node->right == nullptr) {
-      Node *temp = node;
-      node = node->left;
-      node->parent = temp->parent;
-      delete temp;
-      --size_;
-    } else {
-      Node *successor = findLeftmost(node->right);
-      node->value = successor->value;
-      node->right = remove(node->right, successor->value);
+template <typename T, typename Compare>
+void set<T, Compare>::destroyNode(Node *node) {
+  accounting_.freed(sizeof(Node));
+  delete node;
+}
+
+// Frees a node that left the tree through a handle and was never put back.
+template <typename T, typename Compare>
+void set<T, Compare>::destroyDetached(Node *node) {
+  if (node != nullptr) {
+    memory_counter<memory_category::set>::discarded(sizeof(Node));
+    delete node;
+  }
+}
+
+template <typename T, typename Compare>
+void set<T, Compare>::detach(Node *node) {
+  rb_tree::erase(root, node);
+  node->left = nullptr;
+  node->right = nullptr;
+  node->parent = nullptr;
+  --size_;
+}
+
+template <typename T, typename Compare>
+void set<T, Compare>::unlink(Node *node) {
+  detach(node);
+  destroyNode(node);
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::Node *set<T, Compare>::find(Node *node,
+                                                      const T &value) const {
+  trace_scope trace(trace_op::set_lookup);
+  while (node != nullptr) {
+    trace_comparison();
+    int order = compare_keys(comp, value, node->value);
+    if (order == 0) {
+      break;
     }
+    node = (order < 0) ? node->left : node->right;
   }
   return node;
 }
 
-template <typename T>
-typename set<T>::Node *set<T>::find(Node *node, const T &value) const {
-  if (node == nullptr || node->value == value) {
-    return node;
-  } else if (value < node->value) {
-    return find(node->left, value);
+template <typename T, typename Compare>
+typename set<T, Compare>::Node *set<T, Compare>::findSlot(const T &value,
+                                                          Node *&parent,
+                                                          bool &left) const {
+  parent = nullptr;
+  left = false;
+  Node *node = root;
+  while (node != nullptr) {
+    parent = node;
+    trace_comparison();
+    int order = compare_keys(comp, value, node->value);
+    if (order == 0) {
+      return node;
+    }
+    left = order < 0;
+    node = left ? node->left : node->right;
+  }
+  return nullptr;
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::Node *set<T, Compare>::attach(Node *node,
+                                                        Node *parent,
+                                                        bool left) {
+  node->parent = parent;
+  if (parent == nullptr) {
+    root = node;
+  } else if (left) {
+    parent->left = node;
   } else {
-    return find(node->right, value);
+    parent->right = node;
   }
+  rb_tree::insert_fixup(root, node);
+  ++size_;
+  return node;
 }
 
-template <typename T>
-void set<T>::swap(set &other) {
+template <typename T, typename Compare>
+void set<T, Compare>::swap(set &other) {
+  accounting_.exchange(other.accounting_, size_ * sizeof(Node),
+                       other.size_ * sizeof(Node));
   std::swap(root, other.root);
   std::swap(size_, other.size_);
+  std::swap(comp, other.comp);
+}
+
+// Nodes are relinked, never reallocated; values already present here stay
+// behind in other, as with std::set. When other is small next to this
+// tree, m * log n < n, its nodes are moved over one at a time; otherwise
+// both trees are flattened into sorted lists, spliced together and
+// rebuilt balanced in O(n + m).
+template <typename T, typename Compare>
+void set<T, Compare>::merge(set &other) {
+  trace_scope trace(trace_op::set_merge);
+  if (this == &other || other.root == nullptr) {
+    return;
+  }
+  if (size_t(other.size_) * std::bit_width(size_t(size_)) < size_t(size_)) {
+    Node *node = findLeftmost(other.root);
+    while (node != nullptr) {
+      Node *next = successor(node);
+      Node *parent;
+      bool left;
+      if (findSlot(node->value, parent, left) == nullptr) {
+        other.detach(node);
+        other.accounting_.released(sizeof(Node));
+        attach(node, parent, left);
+        accounting_.adopted(sizeof(Node));
+      }
+      node = next;
+    }
+    return;
+  }
+  Node *a = flatten(root);
+  Node *b = flatten(other.root);
+  Node *merged = nullptr;
+  Node **tail = &merged;
+  Node *rest = nullptr;
+  Node **restTail = &rest;
+  int duplicates = 0;
+  while (a != nullptr && b != nullptr) {
+    trace_comparison();
+    int order = compare_keys(comp, a->value, b->value);
+    if (order == 0) {
+      *restTail = b;
+      restTail = &b->right;
+      b = b->right;
+      ++duplicates;
+    }
+    Node *&next = (order > 0) ? b : a;
+    *tail = next;
+    tail = &next->right;
+    next = next->right;
+  }
+  *tail = (a != nullptr) ? a : b;
+  *restTail = nullptr;
+  int moved = other.size_ - duplicates;
+  other.accounting_.released(moved * sizeof(Node));
+  accounting_.adopted(moved * sizeof(Node));
+  size_ += moved;
+  other.size_ = duplicates;
+  root = rb_tree::build(merged, size_);
+  other.root = rb_tree::build(rest, other.size_);
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::Node *set<T, Compare>::flatten(Node *node) {
+  Node *list = nullptr;
+  node = findRightmost(node);
+  while (node != nullptr) {
+    Node *prev = predecessor(node);
+    node->right = list;
+    list = node;
+    node = prev;
+  }
+  return list;
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::Node *set<T, Compare>::cloneList(Node *node) {
+  Node *list = nullptr;
+  Node **tail = &list;
+  for (node = findLeftmost(node); node != nullptr; node = successor(node)) {
+    *tail = createNode(node->value, nullptr);
+    tail = &(*tail)->right;
+  }
+  return list;
 }
 
-template <typename T>
-void set<T>::merge(set &other) {
-  set<T>::Iterator it = other.begin();
-  for (int i = 0; i < other.size(); i++) {
-    insert(*it);
-    ++it;
+template <typename T, typename Compare>
+bool set<T, Compare>::isSorted(const Node *list) const {
+  for (; list != nullptr && list->right != nullptr; list = list->right) {
+    if (!comp(list->value, list->right->value)) {
+      return false;
+    }
   }
-  other.clear();
+  return true;
 }
 
-template <typename T>
-void set<T>::clear(Node *node) {
+template <typename T, typename Compare>
+typename set<T, Compare>::Node *set<T, Compare>::sortList(Node *&list,
+                                                          int n) {
+  if (n <= 1) {
+    Node *node = list;
+    if (node != nullptr) {
+      list = node->right;
+      node->right = nullptr;
+    }
+    return node;
+  }
+  Node *a = sortList(list, n / 2);
+  Node *b = sortList(list, n - n / 2);
+  Node *merged = nullptr;
+  Node **tail = &merged;
+  while (a != nullptr && b != nullptr) {
+    Node *&next = comp(b->value, a->value) ? b : a;
+    *tail = next;
+    tail = &next->right;
+    next = next->right;
+  }
+  *tail = (a != nullptr) ? a : b;
+  return merged;
+}
+
+template <typename T, typename Compare>
+int set<T, Compare>::dropDuplicates(Node *list) {
+  int n = 0;
+  for (Node *node = list; node != nullptr; node = node->right) {
+    ++n;
+    while (node->right != nullptr && !comp(node->value, node->right->value)) {
+      Node *duplicate = node->right;
+      node->right = duplicate->right;
+      destroyNode(duplicate);
+    }
+  }
+  return n;
+}
+
+template <typename T, typename Compare>
+void set<T, Compare>::clear(Node *node) {
   if (node != nullptr) {
     clear(node->left);
     clear(node->right);
-    delete node;
+    destroyNode(node);
   }
 }
 
-template <typename T>
-set<T>::set(std::initializer_list<T> const &items) : set() {
-  for (const T &item : items) {
-    insert(item);
+template <typename T, typename Compare>
+set<T, Compare>::set(std::initializer_list<T> const &items)
+    : set(items.begin(), items.end()) {}
+
+template <typename T, typename Compare>
+template <typename InputIt>
+set<T, Compare>::set(InputIt first, InputIt last, const Compare &compare)
+    : comp(compare) {
+  Node *list = nullptr;
+  Node **tail = &list;
+  int n = 0;
+  for (; first != last; ++first, ++n) {
+    *tail = createNode(*first, nullptr);
+    tail = &(*tail)->right;
   }
+  if (!isSorted(list)) {
+    list = sortList(list, n);
+  }
+  size_ = dropDuplicates(list);
+  root = rb_tree::build(list, size_);
 }
 
-template <typename T>
-set<T>::set(const set &other) : set() {
-  for (const T &item : other) {
-    insert(item);
-  }
+template <typename T, typename Compare>
+set<T, Compare>::set(const Compare &compare) : comp(compare) {}
+
+template <typename T, typename Compare>
+set<T, Compare>::set(const set &other) : set(other.comp) {
+  Node *list = cloneList(other.root);
+  root = rb_tree::build(list, other.size_);
+  size_ = other.size_;
 }
 
-template <typename T>
-set<T>::set(set &&other) noexcept : root(other.root), size_(other.size_) {
+template <typename T, typename Compare>
+set<T, Compare>::set(set &&other) noexcept
+    : root(other.root), size_(other.size_), comp(other.comp) {
+  other.accounting_.released(size_ * sizeof(Node));
+  accounting_.adopted(size_ * sizeof(Node));
   other.root = nullptr;
   other.size_ = 0;
 }
 
-template <typename T>
-set<T>::~set() {
+template <typename T, typename Compare>
+set<T, Compare>::~set() {
   clear();
 }
 
-template <typename T>
-set<T> &set<T>::operator=(const set &other) {
+template <typename T, typename Compare>
+set<T, Compare> &set<T, Compare>::operator=(const set &other) {
   if (this != &other) {
     clear();
-    for (const T &item : other) {
-      insert(item);
-    }
+    comp = other.comp;
+    Node *list = cloneList(other.root);
+    root = rb_tree::build(list, other.size_);
+    size_ = other.size_;
   }
   return *this;
 }
 
-template <typename T>
-set<T> &set<T>::operator=(set &&other) noexcept {
+template <typename T, typename Compare>
+set<T, Compare> &set<T, Compare>::operator=(set &&other) noexcept {
   if (this != &other) {
     clear();
     root = other.root;
     size_ = other.size_;
+    comp = other.comp;
+    other.accounting_.released(size_ * sizeof(Node));
+    accounting_.adopted(size_ * sizeof(Node));
     other.root = nullptr;
     other.size_ = 0;
   }
   return *this;
 }
 
-template <typename T>
-void set<T>::insert(const T &value) {
-  root = insert(root, value, nullptr);
+template <typename T, typename Compare>
+void set<T, Compare>::insert(const T &value) {
+  trace_scope trace(trace_op::set_insert);
+  Node *parent;
+  bool left;
+  if (findSlot(value, parent, left) == nullptr) {
+    attach(createNode(value, parent), parent, left);
+  }
 }
 
-template <typename T>
-void set<T>::erase(const T &value) {
-  root = remove(root, value);
+template <typename T, typename Compare>
+void set<T, Compare>::erase(const T &value) {
+  trace_scope trace(trace_op::set_erase);
+  Node *node = find(root, value);
+  if (node != nullptr) {
+    unlink(node);
+  }
 }
 
-template <typename T>
-bool set<T>::contains(const T &value) const {
+template <typename T, typename Compare>
+bool set<T, Compare>::contains(const T &value) const {
   return find(root, value) != nullptr;
 }
 
-template <typename T>
-int set<T>::count(const T &value) const {
+template <typename T, typename Compare>
+int set<T, Compare>::count(const T &value) const {
   return contains(value) ? 1 : 0;
 }
 
-template <typename T>
-void set<T>::clear() {
+template <typename T, typename Compare>
+void set<T, Compare>::clear() {
   clear(root);
   root = nullptr;
   size_ = 0;
 }
 
-template <typename T>
-int set<T>::size() const {
+template <typename T, typename Compare>
+int set<T, Compare>::size() const {
   return size_;
 }
 
-template <typename T>
-bool set<T>::empty() const {
+template <typename T, typename Compare>
+bool set<T, Compare>::empty() const {
   return size_ == 0;
 }
 
-template <typename T>
-typename set<T>::Node *set<T>::findRightmost(Node *node) {
+template <typename T, typename Compare>
+typename set<T, Compare>::key_compare set<T, Compare>::key_comp() const {
+  return comp;
+}
+
+template <typename T, typename Compare>
+memory_stats set<T, Compare>::memory_usage() const {
+  memory_stats stats;
+  stats.live_bytes = size_ * sizeof(Node);
+  stats.nodes = size_;
+  accounting_.report(stats);
+  return stats;
+}
+
+template <typename T, typename Compare>
+tree_stats set<T, Compare>::stats() const {
+  return rb_tree::measure(root);
+}
+
+template <typename T, typename Compare>
+bool set<T, Compare>::validate() const {
+  return size_ >= 0 &&
+         rb_tree::validate(root, size_, [this](const Node *a, const Node *b) {
+           return comp(a->value, b->value);
+         });
+}
+
+template <typename T, typename Compare>
+void set<T, Compare>::save(std::ostream &out) const {
+  serial_writer writer(out);
+  serial_detail::writeHeader(writer, 's', size_, serial_detail::recordSize<T>(),
+                             0);
+  for (Node *node = findLeftmost(root); node != nullptr;
+       node = successor(node)) {
+    writer.value(node->value);
+  }
+  writer.finish();
+}
+
+template <typename T, typename Compare>
+void set<T, Compare>::load(std::istream &in) {
+  serial_reader reader(in);
+  uint64_t count = serial_detail::readHeader(
+      reader, 's', serial_detail::recordSize<T>(), 0,
+      std::numeric_limits<int>::max());
+  Node *list = nullptr;
+  Node **tail = &list;
+  try {
+    for (uint64_t i = 0; i < count; i++) {
+      *tail = createNode(reader.value<T>(), nullptr);
+      tail = &(*tail)->right;
+    }
+    reader.finish();
+  } catch (...) {
+    while (list != nullptr) {
+      destroyNode(std::exchange(list, list->right));
+    }
+    throw;
+  }
+  if (!isSorted(list)) {
+    list = sortList(list, static_cast<int>(count));
+  }
+  int n = dropDuplicates(list);
+  clear();
+  root = rb_tree::build(list, n);
+  size_ = n;
+}
+
+template <typename T, typename Compare>
+std::vector<typename set<T, Compare>::ConstIterator> set<T, Compare>::split(
+    size_t parts) const {
+  std::vector<ConstIterator> cuts;
+  for (Node *node : rb_tree::split(root, parts)) {
+    cuts.push_back(ConstIterator(node, this));
+  }
+  cuts.push_back(end());
+  return cuts;
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::Node *set<T, Compare>::findRightmost(Node *node) {
   if (node == nullptr) {
     return nullptr;
   }
@@ -180,8 +449,8 @@ typename set<T>::Node *set<T>::findRightmost(Node *node) {
   return node;
 }
 
-template <typename T>
-typename set<T>::Node *set<T>::findLeftmost(Node *node) {
+template <typename T, typename Compare>
+typename set<T, Compare>::Node *set<T, Compare>::findLeftmost(Node *node) {
   if (node == nullptr) {
     return nullptr;
   }
@@ -191,158 +460,242 @@ typename set<T>::Node *set<T>::findLeftmost(Node *node) {
   return node;
 }
 
-template <typename T>
-typename set<T>::Iterator set<T>::begin() {
-  return Iterator(findLeftmost(root));
+template <typename T, typename Compare>
+typename set<T, Compare>::Node *set<T, Compare>::successor(Node *node) {
+  if (node->right != nullptr) {
+    return findLeftmost(node->right);
+  }
+  Node *parent = node->parent;
+  while (parent != nullptr && node == parent->right) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::Node *set<T, Compare>::predecessor(Node *node) {
+  if (node->left != nullptr) {
+    return findRightmost(node->left);
+  }
+  Node *parent = node->parent;
+  while (parent != nullptr && node == parent->left) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::Iterator set<T, Compare>::begin() {
+  return Iterator(findLeftmost(root), this);
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::Iterator set<T, Compare>::end() {
+  return Iterator(nullptr, this);
 }
 
-template <typename T>
-typename set<T>::Iterator set<T>::end() {
-  return Iterator(findRightmost(root));
+template <typename T, typename Compare>
+typename set<T, Compare>::ConstIterator set<T, Compare>::begin() const {
+  return ConstIterator(findLeftmost(root), this);
 }
 
-template <typename T>
-typename set<T>::ConstIterator set<T>::begin() const {
-  return ConstIterator(findLeftmost(root));
+template <typename T, typename Compare>
+typename set<T, Compare>::ConstIterator set<T, Compare>::end() const {
+  return ConstIterator(nullptr, this);
 }
 
-template <typename T>
-typename set<T>::ConstIterator set<T>::end() const {
-  return ConstIterator(nullptr, root);
+template <typename T, typename Compare>
+typename set<T, Compare>::Iterator set<T, Compare>::find(const T &value) {
+  return Iterator(find(root, value), this);
 }
 
-template <typename T>
-set<T>::Iterator::Iterator(Node *root)
-    : current(findLeftmost(root)), treeRoot(root) {}
+template <typename T, typename Compare>
+set<T, Compare>::Iterator::Iterator(Node *node, const set *tree)
+    : current(node), owner(tree) {}
+
+template <typename T, typename Compare>
+bool set<T, Compare>::Iterator::operator==(const Iterator &other) const {
+  return current == other.current;
+}
 
-template <typename T>
-bool set<T>::Iterator::operator!=(const Iterator &other) const {
+template <typename T, typename Compare>
+bool set<T, Compare>::Iterator::operator!=(const Iterator &other) const {
   return current != other.current;
 }
 
-template <typename T>
-typename set<T>::Iterator &set<T>::Iterator::operator++() {
-  if (current == nullptr) {
-    current = findLeftmost(treeRoot);
-  } else if (current->right != nullptr) {
-    current = findLeftmost(current->right);
-  } else {
-    while (current != nullptr && current->parent != nullptr &&
-           current == current->parent->right) {
-      current = current->parent;
-    }
-    if (current == nullptr) {
-      return *this;
-    }
-    current = current->parent;
+template <typename T, typename Compare>
+typename set<T, Compare>::Iterator &set<T, Compare>::Iterator::operator++() {
+  if (current != nullptr) {
+    current = successor(current);
   }
   return *this;
 }
 
-template <typename T>
-typename set<T>::Iterator set<T>::find(const T &value) {
-  Node *node = find(root, value);
-  return Iterator(node);
+template <typename T, typename Compare>
+typename set<T, Compare>::Iterator set<T, Compare>::Iterator::operator++(int) {
+  Iterator tmp = *this;
+  ++*this;
+  return tmp;
 }
 
-template <typename T>
-typename set<T>::Iterator &set<T>::Iterator::operator--() {
-  Node *prev = current;
+template <typename T, typename Compare>
+typename set<T, Compare>::Iterator &set<T, Compare>::Iterator::operator--() {
   if (current == nullptr) {
-    return *this;
-  }
-  if (current->left && current->left != prev) {
-    current = current->left;
-    while (current->right != nullptr) current = current->right;
+    current = findRightmost(owner->root);
   } else {
-    current = current->parent;
-    while (prev->value <= current->value) {
-      if (current->left && current->left != prev) {
-        current = current->left;
-        while (current->right != nullptr) current = current->right;
-      } else {
-        while (prev->value <= current->value) {
-          current = current->parent;
-          if (current == nullptr) {
-            break;
-          }
-        }
-        break;
-      }
-    }
+    current = predecessor(current);
   }
   return *this;
 }
 
-template <typename T>
-const T &set<T>::Iterator::operator*() const {
+template <typename T, typename Compare>
+typename set<T, Compare>::Iterator set<T, Compare>::Iterator::operator--(int) {
+  Iterator tmp = *this;
+  --*this;
+  return tmp;
+}
+
+template <typename T, typename Compare>
+const T &set<T, Compare>::Iterator::operator*() const {
   return current->value;
 }
 
-template <typename T>
-const T *set<T>::Iterator::operator->() const {
+template <typename T, typename Compare>
+const T *set<T, Compare>::Iterator::operator->() const {
   return &(current->value);
 }
 
-template <typename T>
-set<T>::ConstIterator::ConstIterator(Node *root)
-    : current(findLeftmost(root)), treeRoot(root) {}
-
-template <typename T>
-set<T>::ConstIterator::ConstIterator(const Node *root)
-    : current(findLeftmost(const_cast<Node *>(root))),
-      treeRoot(const_cast<Node *>(root)) {}
+template <typename T, typename Compare>
+set<T, Compare>::ConstIterator::ConstIterator(const Node *node, const set *tree)
+    : current(node), owner(tree) {}
 
-template <typename T>
-set<T>::ConstIterator::ConstIterator(Node *current, Node *treeRoot)
-    : current(current), treeRoot(treeRoot) {}
+template <typename T, typename Compare>
+bool set<T, Compare>::ConstIterator::operator==(
+    const ConstIterator &other) const {
+  return current == other.current;
+}
 
-template <typename T>
-bool set<T>::ConstIterator::operator!=(const ConstIterator &other) const {
+template <typename T, typename Compare>
+bool set<T, Compare>::ConstIterator::operator!=(
+    const ConstIterator &other) const {
   return current != other.current;
 }
 
-template <typename T>
-typename set<T>::ConstIterator &set<T>::ConstIterator::operator++() {
-  if (current == nullptr) {
-    current = findLeftmost(const_cast<Node *>(treeRoot));
-  } else if (current->right != nullptr) {
-    current = findLeftmost(const_cast<Node *>(current->right));
-  } else {
-    while (current != nullptr && current->parent != nullptr &&
-           current == current->parent->right) {
-      current = current->parent;
-    }
-    if (current == nullptr) {
-      return *this;
-    }
-    current = current->parent;
+template <typename T, typename Compare>
+typename set<T, Compare>::ConstIterator &
+set<T, Compare>::ConstIterator::operator++() {
+  if (current != nullptr) {
+    current = successor(const_cast<Node *>(current));
   }
   return *this;
 }
 
-template <typename T>
-typename set<T>::ConstIterator &set<T>::ConstIterator::operator--() {
+template <typename T, typename Compare>
+typename set<T, Compare>::ConstIterator
+set<T, Compare>::ConstIterator::operator++(int) {
+  ConstIterator tmp = *this;
+  ++*this;
+  return tmp;
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::ConstIterator &
+set<T, Compare>::ConstIterator::operator--() {
   if (current == nullptr) {
-    current = findRightmost(const_cast<Node *>(treeRoot));
-  } else if (current->left != nullptr) {
-    current = findRightmost(const_cast<Node *>(current->left));
+    current = findRightmost(owner->root);
   } else {
-    const Node *prev = current;
-    while (current != nullptr && current->left == prev) {
-      prev = current;
-      current = current->parent;
-    }
+    current = predecessor(const_cast<Node *>(current));
   }
   return *this;
 }
 
-template <typename T>
-const T &set<T>::ConstIterator::operator*() const {
+template <typename T, typename Compare>
+typename set<T, Compare>::ConstIterator
+set<T, Compare>::ConstIterator::operator--(int) {
+  ConstIterator tmp = *this;
+  --*this;
+  return tmp;
+}
+
+template <typename T, typename Compare>
+const T &set<T, Compare>::ConstIterator::operator*() const {
   return current->value;
 }
 
-template <typename T>
-const T *set<T>::ConstIterator::operator->() const {
+template <typename T, typename Compare>
+const T *set<T, Compare>::ConstIterator::operator->() const {
   return &(current->value);
 }
+
+template <typename T, typename Compare>
+typename set<T, Compare>::node_type set<T, Compare>::extract(const T &value) {
+  return extract(find(value));
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::node_type set<T, Compare>::extract(Iterator pos) {
+  if (pos.current == nullptr) {
+    return node_type();
+  }
+  detach(pos.current);
+  accounting_.released(sizeof(Node));
+  return node_type(pos.current);
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::insert_return_type set<T, Compare>::insert(
+    node_type &&handle) {
+  trace_scope trace(trace_op::set_insert);
+  if (handle.empty()) {
+    return {end(), false, node_type()};
+  }
+  Node *parent;
+  bool left;
+  Node *node = findSlot(handle.node->value, parent, left);
+  if (node != nullptr) {
+    return {Iterator(node, this), false, std::move(handle)};
+  }
+  node = attach(handle.node, parent, left);
+  accounting_.adopted(sizeof(Node));
+  handle.node = nullptr;
+  return {Iterator(node, this), true, node_type()};
+}
+
+template <typename T, typename Compare>
+set<T, Compare>::node_type::node_type(node_type &&other) noexcept
+    : node(other.node) {
+  other.node = nullptr;
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::node_type &set<T, Compare>::node_type::operator=(
+    node_type &&other) noexcept {
+  if (this != &other) {
+    destroyDetached(node);
+    node = other.node;
+    other.node = nullptr;
+  }
+  return *this;
+}
+
+template <typename T, typename Compare>
+set<T, Compare>::node_type::~node_type() {
+  destroyDetached(node);
+}
+
+template <typename T, typename Compare>
+bool set<T, Compare>::node_type::empty() const {
+  return node == nullptr;
+}
+
+template <typename T, typename Compare>
+set<T, Compare>::node_type::operator bool() const {
+  return node != nullptr;
+}
+
+template <typename T, typename Compare>
+T &set<T, Compare>::node_type::value() const {
+  return node->value;
+}
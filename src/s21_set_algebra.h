@@ -0,0 +1,100 @@
+#ifndef SRC_S21_SET_ALGEBRA_H_
+#define SRC_S21_SET_ALGEBRA_H_
+
+#include <algorithm>
+#include <thread>
+
+#include "s21_map.h"
+#include "s21_set.h"
+#include "s21_tree_compare.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Set algebra over ordered containers. Each operation is one merge walk
+// over both inputs in key order; the result comes out sorted, so the
+// output set is linked into a balanced tree in linear time. Passing
+// threads > 1 splits the key space into that many ranges and walks them
+// concurrently; small inputs stay on one thread.
+// The map overloads work on the key sets and return a set of keys.
+
+template <typename T, typename Compare>
+set<T, Compare> set_union(const set<T, Compare> &a, const set<T, Compare> &b,
+                          unsigned threads = 1);
+template <typename T, typename Compare>
+set<T, Compare> set_intersection(const set<T, Compare> &a,
+                                 const set<T, Compare> &b,
+                                 unsigned threads = 1);
+template <typename T, typename Compare>
+set<T, Compare> set_difference(const set<T, Compare> &a,
+                               const set<T, Compare> &b,
+                               unsigned threads = 1);
+template <typename T, typename Compare>
+set<T, Compare> set_symmetric_difference(const set<T, Compare> &a,
+                                         const set<T, Compare> &b,
+                                         unsigned threads = 1);
+
+template <typename K, typename V1, typename V2, typename Compare>
+set<K, Compare> set_union(const map<K, V1, Compare> &a,
+                          const map<K, V2, Compare> &b, unsigned threads = 1);
+template <typename K, typename V1, typename V2, typename Compare>
+set<K, Compare> set_intersection(const map<K, V1, Compare> &a,
+                                 const map<K, V2, Compare> &b,
+                                 unsigned threads = 1);
+template <typename K, typename V1, typename V2, typename Compare>
+set<K, Compare> set_difference(const map<K, V1, Compare> &a,
+                               const map<K, V2, Compare> &b,
+                               unsigned threads = 1);
+template <typename K, typename V1, typename V2, typename Compare>
+set<K, Compare> set_symmetric_difference(const map<K, V1, Compare> &a,
+                                         const map<K, V2, Compare> &b,
+                                         unsigned threads = 1);
+
+namespace set_algebra_detail {
+
+enum class Operation { kUnion, kIntersection, kDifference, kSymmetric };
+
+// Below this many keys per thread the walk is cheaper than starting one.
+constexpr size_t kMinKeysPerThread = size_t(1) << 14;
+
+template <typename K>
+using KeyList = vector<const K *>;
+
+// Feeds a sequence of key pointers to a range constructor.
+template <typename K>
+class KeyIterator {
+ public:
+  explicit KeyIterator(const K *const *position) : position_(position) {}
+  const K &operator*() const { return **position_; }
+  KeyIterator &operator++() {
+    ++position_;
+    return *this;
+  }
+  bool operator!=(const KeyIterator &other) const {
+    return position_ != other.position_;
+  }
+
+ private:
+  const K *const *position_;
+};
+
+template <typename T, typename Compare>
+KeyList<T> keysOf(const set<T, Compare> &source);
+template <typename K, typename V, typename Compare>
+KeyList<K> keysOf(const map<K, V, Compare> &source);
+
+template <typename K, typename Compare>
+void walk(Operation operation, const K *const *a, const K *const *a_end,
+          const K *const *b, const K *const *b_end, const Compare &comp,
+          KeyList<K> &out);
+template <typename K, typename Compare>
+set<K, Compare> combine(Operation operation, const KeyList<K> &a,
+                        const KeyList<K> &b, const Compare &comp,
+                        unsigned threads);
+
+}  // namespace set_algebra_detail
+
+#include "s21_set_algebra.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_SET_ALGEBRA_H_
@@ -0,0 +1,173 @@
+using namespace s21;
+
+template <typename T, typename Compare>
+set_algebra_detail::KeyList<T> set_algebra_detail::keysOf(
+    const set<T, Compare> &source) {
+  KeyList<T> keys;
+  keys.reserve(source.size());
+  for (auto it = source.begin(); it != source.end(); ++it) {
+    keys.push_back(&*it);
+  }
+  return keys;
+}
+
+template <typename K, typename V, typename Compare>
+set_algebra_detail::KeyList<K> set_algebra_detail::keysOf(
+    const map<K, V, Compare> &source) {
+  KeyList<K> keys;
+  keys.reserve(source.size());
+  for (auto it = source.begin(); it != source.end(); ++it) {
+    keys.push_back(&it->first);
+  }
+  return keys;
+}
+
+template <typename K, typename Compare>
+void set_algebra_detail::walk(Operation operation, const K *const *a,
+                              const K *const *a_end, const K *const *b,
+                              const K *const *b_end, const Compare &comp,
+                              KeyList<K> &out) {
+  bool keep_a = operation != Operation::kIntersection;
+  bool keep_b =
+      operation == Operation::kUnion || operation == Operation::kSymmetric;
+  bool keep_common =
+      operation == Operation::kUnion || operation == Operation::kIntersection;
+  while (a != a_end && b != b_end) {
+    int order = compare_keys(comp, **a, **b);
+    if (order < 0) {
+      if (keep_a) out.push_back(*a);
+      ++a;
+    } else if (order > 0) {
+      if (keep_b) out.push_back(*b);
+      ++b;
+    } else {
+      if (keep_common) out.push_back(*a);
+      ++a;
+      ++b;
+    }
+  }
+  for (; keep_a && a != a_end; ++a) out.push_back(*a);
+  for (; keep_b && b != b_end; ++b) out.push_back(*b);
+}
+
+// Pivots are taken evenly from the longer input and located in both inputs
+// by binary search, so every thread owns one contiguous key range and the
+// per-thread outputs concatenate in order.
+template <typename K, typename Compare>
+set<K, Compare> set_algebra_detail::combine(Operation operation,
+                                            const KeyList<K> &a,
+                                            const KeyList<K> &b,
+                                            const Compare &comp,
+                                            unsigned threads) {
+  const KeyList<K> &longer = (a.size() < b.size()) ? b : a;
+  size_t chunks = std::min<size_t>(
+      std::max(threads, 1u), longer.size() / kMinKeysPerThread + 1);
+  vector<size_t> a_bounds(chunks + 1);
+  vector<size_t> b_bounds(chunks + 1);
+  auto less = [&comp](const K *x, const K *pivot) { return comp(*x, *pivot); };
+  for (size_t i = 1; i < chunks; i++) {
+    const K *pivot = longer[longer.size() * i / chunks];
+    a_bounds[i] =
+        std::lower_bound(a.begin(), a.end(), pivot, less) - a.begin();
+    b_bounds[i] =
+        std::lower_bound(b.begin(), b.end(), pivot, less) - b.begin();
+  }
+  a_bounds[chunks] = a.size();
+  b_bounds[chunks] = b.size();
+
+  vector<KeyList<K>> parts(chunks);
+  auto run = [&](size_t i) {
+    walk(operation, a.data() + a_bounds[i], a.data() + a_bounds[i + 1],
+         b.data() + b_bounds[i], b.data() + b_bounds[i + 1], comp, parts[i]);
+  };
+  vector<std::thread> workers(chunks - 1);
+  for (size_t i = 1; i < chunks; i++) {
+    workers[i - 1] = std::thread(run, i);
+  }
+  run(0);
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  KeyList<K> keys;
+  if (chunks == 1) {
+    keys.swap(parts[0]);
+  } else {
+    size_t total = 0;
+    for (const KeyList<K> &part : parts) total += part.size();
+    keys.reserve(total);
+    for (const KeyList<K> &part : parts) {
+      for (const K *key : part) keys.push_back(key);
+    }
+  }
+  return set<K, Compare>(KeyIterator<K>(keys.data()),
+                         KeyIterator<K>(keys.data() + keys.size()), comp);
+}
+
+template <typename T, typename Compare>
+set<T, Compare> set_union(const set<T, Compare> &a, const set<T, Compare> &b,
+                          unsigned threads) {
+  using namespace set_algebra_detail;
+  return combine(Operation::kUnion, keysOf(a), keysOf(b), a.key_comp(),
+                 threads);
+}
+
+template <typename T, typename Compare>
+set<T, Compare> set_intersection(const set<T, Compare> &a,
+                                 const set<T, Compare> &b, unsigned threads) {
+  using namespace set_algebra_detail;
+  return combine(Operation::kIntersection, keysOf(a), keysOf(b), a.key_comp(),
+                 threads);
+}
+
+template <typename T, typename Compare>
+set<T, Compare> set_difference(const set<T, Compare> &a,
+                               const set<T, Compare> &b, unsigned threads) {
+  using namespace set_algebra_detail;
+  return combine(Operation::kDifference, keysOf(a), keysOf(b), a.key_comp(),
+                 threads);
+}
+
+template <typename T, typename Compare>
+set<T, Compare> set_symmetric_difference(const set<T, Compare> &a,
+                                         const set<T, Compare> &b,
+                                         unsigned threads) {
+  using namespace set_algebra_detail;
+  return combine(Operation::kSymmetric, keysOf(a), keysOf(b), a.key_comp(),
+                 threads);
+}
+
+template <typename K, typename V1, typename V2, typename Compare>
+set<K, Compare> set_union(const map<K, V1, Compare> &a,
+                          const map<K, V2, Compare> &b, unsigned threads) {
+  using namespace set_algebra_detail;
+  return combine(Operation::kUnion, keysOf(a), keysOf(b), a.key_comp(),
+                 threads);
+}
+
+template <typename K, typename V1, typename V2, typename Compare>
+set<K, Compare> set_intersection(const map<K, V1, Compare> &a,
+                                 const map<K, V2, Compare> &b,
+                                 unsigned threads) {
+  using namespace set_algebra_detail;
+  return combine(Operation::kIntersection, keysOf(a), keysOf(b), a.key_comp(),
+                 threads);
+}
+
+template <typename K, typename V1, typename V2, typename Compare>
+set<K, Compare> set_difference(const map<K, V1, Compare> &a,
+                               const map<K, V2, Compare> &b,
+                               unsigned threads) {
+  using namespace set_algebra_detail;
+  return combine(Operation::kDifference, keysOf(a), keysOf(b), a.key_comp(),
+                 threads);
+}
+
+template <typename K, typename V1, typename V2, typename Compare>
+set<K, Compare> set_symmetric_difference(const map<K, V1, Compare> &a,
+                                         const map<K, V2, Compare> &b,
+                                         unsigned threads) {
+  using namespace set_algebra_detail;
+  return combine(Operation::kSymmetric, keysOf(a), keysOf(b), a.key_comp(),
+                 threads);
+}
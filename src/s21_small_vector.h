@@ -0,0 +1,107 @@
+#ifndef SRC_S21_SMALL_VECTOR_H_
+#define SRC_S21_SMALL_VECTOR_H_
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_memory_stats.h"
+#include "s21_trace.h"
+
+namespace s21 {
+
+// vector with room for N elements inside the object itself: until it
+// holds more than N, no heap allocation is made at all, and past that it
+// moves to a heap buffer and grows by doubling as vector does. Unlike
+// vector, spare capacity holds no constructed elements, so T needs no
+// default constructor except for small_vector(n).
+//
+// Moving a small_vector that is on the heap takes its buffer; moving one
+// that is inline moves the elements one by one, so it is O(N) and, as
+// with swap, iterators into an inline small_vector do not follow its
+// elements. Heap use is reported under memory_category::vector.
+template <typename T, size_t N>
+class small_vector {
+  static_assert(N > 0, "small_vector needs room for at least one element");
+
+ public:
+  typedef T value_type;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef T *iterator;
+  typedef const T *const_iterator;
+  typedef size_t size_type;
+
+  static constexpr size_type inline_capacity = N;
+
+  small_vector();
+  explicit small_vector(size_type n);
+  small_vector(std::initializer_list<value_type> const &items);
+  small_vector(const small_vector &v);
+  small_vector(small_vector &&v);
+  ~small_vector();
+  small_vector &operator=(small_vector &&v);
+  small_vector &operator=(const small_vector &v);
+
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+  reference operator[](size_type pos) { return data_[pos]; }
+  const_reference operator[](size_type pos) const { return data_[pos]; }
+  reference front() { return data_[0]; }
+  const_reference front() const { return data_[0]; }
+  reference back() { return data_[size_ - 1]; }
+  const_reference back() const { return data_[size_ - 1]; }
+  iterator data() { return data_; }
+  const_iterator data() const { return data_; }
+
+  iterator begin() { return data_; }
+  const_iterator begin() const { return data_; }
+  iterator end() { return data_ + size_; }
+  const_iterator end() const { return data_ + size_; }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type max_size() const;
+  void reserve(size_type size);
+  size_type capacity() const { return capacity_; }
+  // Moves the elements back inline when they fit.
+  void shrink_to_fit();
+  // True while the elements are stored in the object rather than the heap.
+  bool is_inline() const { return data_ == inlineData(); }
+  memory_stats memory_usage() const;
+
+  void clear();
+
+  iterator insert(const_iterator pos, const_reference value);
+
+  void erase(iterator pos);
+  void erase(iterator first, iterator last);
+  void push_back(const_reference value);
+  void pop_back();
+  void swap(small_vector &other);
+
+ private:
+  T *inlineData() { return reinterpret_cast<T *>(inline_); }
+  const T *inlineData() const { return reinterpret_cast<const T *>(inline_); }
+  T *allocate(size_type n);
+  // Frees the heap buffer, if any; the elements must be destroyed already.
+  void release();
+  // Moves the elements to a heap buffer of new_capacity elements.
+  void reallocate(size_type new_capacity);
+  void grow(size_type min_capacity);
+  // Takes the elements of v, leaving it empty and inline.
+  void take(small_vector &v);
+
+  T *data_;
+  size_type size_;
+  size_type capacity_;
+  alignas(T) unsigned char inline_[N * sizeof(T)];
+  [[no_unique_address]] memory_counter<memory_category::vector> accounting_;
+};
+
+#include "s21_small_vector.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_SMALL_VECTOR_H_
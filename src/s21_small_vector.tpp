@@ -0,0 +1,256 @@
+using namespace s21;
+
+template <typename T, size_t N>
+small_vector<T, N>::small_vector()
+    : data_(inlineData()), size_(0), capacity_(N) {}
+
+template <typename T, size_t N>
+small_vector<T, N>::small_vector(size_type n) : small_vector() {
+  reserve(n);
+  std::uninitialized_value_construct_n(data_, n);
+  size_ = n;
+}
+
+template <typename T, size_t N>
+small_vector<T, N>::small_vector(
+    std::initializer_list<value_type> const &items)
+    : small_vector() {
+  reserve(items.size());
+  std::uninitialized_copy(items.begin(), items.end(), data_);
+  size_ = items.size();
+}
+
+template <typename T, size_t N>
+small_vector<T, N>::small_vector(const small_vector &v) : small_vector() {
+  reserve(v.size_);
+  std::uninitialized_copy(v.begin(), v.end(), data_);
+  size_ = v.size_;
+}
+
+template <typename T, size_t N>
+small_vector<T, N>::small_vector(small_vector &&v) : small_vector() {
+  take(v);
+}
+
+template <typename T, size_t N>
+small_vector<T, N>::~small_vector() {
+  clear();
+  release();
+}
+
+template <typename T, size_t N>
+small_vector<T, N> &small_vector<T, N>::operator=(small_vector &&v) {
+  if (this != &v) {
+    clear();
+    release();
+    data_ = inlineData();
+    capacity_ = N;
+    take(v);
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+small_vector<T, N> &small_vector<T, N>::operator=(const small_vector &v) {
+  if (this == &v) {
+    return *this;
+  }
+  if (v.size_ > capacity_) {
+    small_vector copy(v);
+    return *this = std::move(copy);
+  }
+  size_type common = std::min(size_, v.size_);
+  std::copy(v.begin(), v.begin() + common, data_);
+  if (v.size_ > size_) {
+    std::uninitialized_copy(v.begin() + common, v.end(), data_ + common);
+  } else {
+    std::destroy(data_ + common, data_ + size_);
+  }
+  size_ = v.size_;
+  return *this;
+}
+
+template <typename T, size_t N>
+typename small_vector<T, N>::reference small_vector<T, N>::at(size_type pos) {
+  if (pos >= size_) {
+    throw std::out_of_range("n >= size");
+  }
+  return data_[pos];
+}
+
+template <typename T, size_t N>
+typename small_vector<T, N>::const_reference small_vector<T, N>::at(
+    size_type pos) const {
+  if (pos >= size_) {
+    throw std::out_of_range("n >= size");
+  }
+  return data_[pos];
+}
+
+template <typename T, size_t N>
+typename small_vector<T, N>::size_type small_vector<T, N>::max_size() const {
+  return std::allocator_traits<std::allocator<T>>::max_size(
+      std::allocator<T>());
+}
+
+template <typename T, size_t N>
+T *small_vector<T, N>::allocate(size_type n) {
+  T *block = std::allocator<T>().allocate(n);
+  accounting_.allocated(n * sizeof(T));
+  return block;
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::release() {
+  if (!is_inline()) {
+    accounting_.freed(capacity_ * sizeof(T));
+    std::allocator<T>().deallocate(data_, capacity_);
+  }
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::reallocate(size_type new_capacity) {
+  trace_reallocation();
+  T *block = allocate(new_capacity);
+  std::uninitialized_move(begin(), end(), block);
+  std::destroy(begin(), end());
+  release();
+  data_ = block;
+  capacity_ = new_capacity;
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::grow(size_type min_capacity) {
+  reallocate(std::max(2 * capacity_, min_capacity));
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::take(small_vector &v) {
+  if (v.is_inline()) {
+    std::uninitialized_move(v.begin(), v.end(), data_);
+    std::destroy(v.begin(), v.end());
+  } else {
+    v.accounting_.released(v.capacity_ * sizeof(T));
+    accounting_.adopted(v.capacity_ * sizeof(T));
+    data_ = v.data_;
+    capacity_ = v.capacity_;
+    v.data_ = v.inlineData();
+    v.capacity_ = N;
+  }
+  size_ = std::exchange(v.size_, 0);
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::reserve(size_type size) {
+  trace_scope trace(trace_op::vector_reserve);
+  if (capacity_ < size) {
+    reallocate(size);
+  }
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::shrink_to_fit() {
+  trace_scope trace(trace_op::vector_shrink_to_fit);
+  if (is_inline() || size_ == capacity_) {
+    return;
+  }
+  if (size_ > N) {
+    reallocate(size_);
+    return;
+  }
+  T *heap = data_;
+  std::uninitialized_move(heap, heap + size_, inlineData());
+  std::destroy(heap, heap + size_);
+  release();
+  data_ = inlineData();
+  capacity_ = N;
+}
+
+template <typename T, size_t N>
+memory_stats small_vector<T, N>::memory_usage() const {
+  memory_stats stats;
+  if (!is_inline()) {
+    stats.live_bytes = capacity_ * sizeof(T);
+    stats.nodes = 1;
+    stats.slack_bytes = (capacity_ - size_) * sizeof(T);
+  }
+  accounting_.report(stats);
+  return stats;
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::clear() {
+  std::destroy(begin(), end());
+  size_ = 0;
+}
+
+template <typename T, size_t N>
+typename small_vector<T, N>::iterator small_vector<T, N>::insert(
+    const_iterator pos, const_reference value) {
+  trace_scope trace(trace_op::vector_insert);
+  size_type index = pos - begin();
+  value_type copy = value;
+  if (size_ == capacity_) grow(size_ + 1);
+  if (index == size_) {
+    new (data_ + size_) T(std::move(copy));
+  } else {
+    new (data_ + size_) T(std::move(back()));
+    std::move_backward(begin() + index, end() - 1, end());
+    data_[index] = std::move(copy);
+  }
+  size_++;
+  return begin() + index;
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::erase(iterator pos) {
+  erase(pos, pos + 1);
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::erase(iterator first, iterator last) {
+  trace_scope trace(trace_op::vector_erase);
+  iterator new_end = std::move(last, end(), first);
+  std::destroy(new_end, end());
+  size_ -= last - first;
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::push_back(const_reference value) {
+  trace_scope trace(trace_op::vector_insert);  // an insert at end()
+  if (size_ < capacity_) {
+    new (data_ + size_) T(value);
+    size_++;
+    return;
+  }
+  // value may live in the buffer that grow() is about to free.
+  value_type copy = value;
+  grow(size_ + 1);
+  new (data_ + size_) T(std::move(copy));
+  size_++;
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::pop_back() {
+  std::destroy_at(data_ + --size_);
+}
+
+// Two heap buffers trade pointers; otherwise the elements are moved
+// through a temporary, which costs O(N) for the inline side.
+template <typename T, size_t N>
+void small_vector<T, N>::swap(small_vector &other) {
+  if (this == &other) {
+    return;
+  }
+  if (!is_inline() && !other.is_inline()) {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    accounting_.exchange(other.accounting_, other.capacity_ * sizeof(T),
+                         capacity_ * sizeof(T));
+    return;
+  }
+  small_vector temp(std::move(other));
+  other = std::move(*this);
+  *this = std::move(temp);
+}
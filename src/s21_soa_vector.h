@@ -0,0 +1,188 @@
+#ifndef SRC_S21_SOA_VECTOR_H_
+#define SRC_S21_SOA_VECTOR_H_
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "s21_memory_stats.h"
+#include "s21_trace.h"
+
+namespace s21 {
+
+// A vector of rows (Ts...) stored as one array per field ("struct of
+// arrays"), so a pass that reads one field streams only that field's bytes
+// through the cache instead of whole rows. column<I>() is the I-th field
+// of every row as a contiguous span, ready for a plain loop the compiler
+// vectorizes or for simd::sum and friends.
+//
+// A row is a std::tuple<Ts...>. v[i] and *it return a proxy,
+// std::tuple<Ts &...>, which reads like a row, converts to one, takes
+// assignment from one and works with std::get and structured bindings:
+//   auto [x, id] = v[i];  // x and id refer to the fields in place
+//
+// Growth follows vector: capacity doubles from 1 when push_back runs out,
+// reserve() allocates exactly, and every column grows together, so
+// growing moves each field once. Columns are allocated with new T[], so
+// the field types need default constructors, as vector's element does.
+// Heap use is reported under memory_category::vector.
+template <typename... Ts>
+class soa_vector {
+  static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+ public:
+  using value_type = std::tuple<Ts...>;
+  using reference = std::tuple<Ts &...>;
+  using const_reference = std::tuple<const Ts &...>;
+  using size_type = size_t;
+  template <size_t I>
+  using column_type = std::tuple_element_t<I, value_type>;
+
+  template <bool Const>
+  class basic_iterator;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  soa_vector() = default;
+  explicit soa_vector(size_type n);
+  soa_vector(std::initializer_list<value_type> const &items);
+  soa_vector(const soa_vector &v);
+  soa_vector(soa_vector &&v);
+  ~soa_vector();
+  soa_vector &operator=(soa_vector &&v);
+  soa_vector &operator=(const soa_vector &v);
+
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+  reference operator[](size_type pos) { return row(pos); }
+  const_reference operator[](size_type pos) const { return row(pos); }
+  reference front() { return row(0); }
+  const_reference front() const { return row(0); }
+  reference back() { return row(size_ - 1); }
+  const_reference back() const { return row(size_ - 1); }
+
+  template <size_t I>
+  std::span<column_type<I>> column() {
+    return {std::get<I>(columns_), size_};
+  }
+  template <size_t I>
+  std::span<const column_type<I>> column() const {
+    return {std::get<I>(columns_), size_};
+  }
+
+  iterator begin() { return iterator(this, 0); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  iterator end() { return iterator(this, size_); }
+  const_iterator end() const { return const_iterator(this, size_); }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type capacity() const { return capacity_; }
+  void reserve(size_type size);
+  void shrink_to_fit();
+  memory_stats memory_usage() const;
+
+  void clear() { size_ = 0; }
+  void push_back(const value_type &value);
+  void pop_back() { --size_; }
+  void swap(soa_vector &other);
+
+ private:
+  static constexpr size_type kRowBytes = (sizeof(Ts) + ...);
+
+  reference row(size_type pos);
+  const_reference row(size_type pos) const;
+  // Calls f(column, index constant) for every column.
+  template <typename F>
+  void forEachColumn(F &&f);
+  // New columns of n rows, value-initialized if zeroed; if one allocation
+  // throws, the others are freed.
+  static std::tuple<Ts *...> allocateColumns(size_type n, bool zeroed);
+  // Moves the rows to new columns of new_capacity rows.
+  void reallocate(size_type new_capacity);
+  void grow(size_type min_capacity);
+  void destroy();
+
+  std::tuple<Ts *...> columns_{};
+  size_type size_ = 0;
+  size_type capacity_ = 0;
+  [[no_unique_address]] memory_counter<memory_category::vector> accounting_;
+};
+
+// Random access over rows by index; dereferencing yields a proxy row.
+template <typename... Ts>
+template <bool Const>
+class soa_vector<Ts...>::basic_iterator {
+  using owner = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = soa_vector::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference =
+      std::conditional_t<Const, soa_vector::const_reference,
+                         soa_vector::reference>;
+  using pointer = void;
+
+  basic_iterator() = default;
+  basic_iterator(owner *v, size_type index) : v_(v), index_(index) {}
+  // iterator converts to const_iterator.
+  operator basic_iterator<true>() const { return {v_, index_}; }
+
+  reference operator*() const { return (*v_)[index_]; }
+  reference operator[](difference_type n) const { return (*v_)[index_ + n]; }
+
+  basic_iterator &operator++() {
+    ++index_;
+    return *this;
+  }
+  basic_iterator operator++(int) { return {v_, index_++}; }
+  basic_iterator &operator--() {
+    --index_;
+    return *this;
+  }
+  basic_iterator operator--(int) { return {v_, index_--}; }
+  basic_iterator &operator+=(difference_type n) {
+    index_ += n;
+    return *this;
+  }
+  basic_iterator &operator-=(difference_type n) {
+    index_ -= n;
+    return *this;
+  }
+  basic_iterator operator+(difference_type n) const {
+    return {v_, index_ + n};
+  }
+  friend basic_iterator operator+(difference_type n, basic_iterator it) {
+    return it + n;
+  }
+  basic_iterator operator-(difference_type n) const {
+    return {v_, index_ - n};
+  }
+  difference_type operator-(const basic_iterator &other) const {
+    return difference_type(index_) - difference_type(other.index_);
+  }
+
+  bool operator==(const basic_iterator &other) const {
+    return index_ == other.index_;
+  }
+  std::strong_ordering operator<=>(const basic_iterator &other) const {
+    return index_ <=> other.index_;
+  }
+
+ private:
+  owner *v_ = nullptr;
+  size_type index_ = 0;
+};
+
+#include "s21_soa_vector.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_SOA_VECTOR_H_
@@ -0,0 +1,215 @@
+using namespace s21;
+
+template <typename... Ts>
+soa_vector<Ts...>::soa_vector(size_type n) {
+  if (n) {
+    columns_ = allocateColumns(n, true);
+    forEachColumn([&](auto *&column, auto) {
+      accounting_.allocated(n * sizeof(*column));
+    });
+    size_ = capacity_ = n;
+  }
+}
+
+template <typename... Ts>
+soa_vector<Ts...>::soa_vector(std::initializer_list<value_type> const &items)
+    : soa_vector() {
+  reserve(items.size());
+  for (const value_type &item : items) push_back(item);
+}
+
+template <typename... Ts>
+soa_vector<Ts...>::soa_vector(const soa_vector &v) : soa_vector() {
+  reserve(v.size_);
+  forEachColumn([&](auto *&column, auto index) {
+    const auto *source = std::get<decltype(index)::value>(v.columns_);
+    std::copy(source, source + v.size_, column);
+  });
+  size_ = v.size_;
+}
+
+template <typename... Ts>
+soa_vector<Ts...>::soa_vector(soa_vector &&v)
+    : columns_(std::exchange(v.columns_, {})),
+      size_(std::exchange(v.size_, 0)),
+      capacity_(std::exchange(v.capacity_, 0)) {
+  v.accounting_.released(capacity_ * kRowBytes);
+  accounting_.adopted(capacity_ * kRowBytes);
+}
+
+template <typename... Ts>
+soa_vector<Ts...>::~soa_vector() {
+  destroy();
+}
+
+template <typename... Ts>
+soa_vector<Ts...> &soa_vector<Ts...>::operator=(soa_vector &&v) {
+  if (this != &v) {
+    destroy();
+    v.accounting_.released(v.capacity_ * kRowBytes);
+    accounting_.adopted(v.capacity_ * kRowBytes);
+    columns_ = std::exchange(v.columns_, {});
+    size_ = std::exchange(v.size_, 0);
+    capacity_ = std::exchange(v.capacity_, 0);
+  }
+  return *this;
+}
+
+template <typename... Ts>
+soa_vector<Ts...> &soa_vector<Ts...>::operator=(const soa_vector &v) {
+  if (this != &v) {
+    soa_vector copy(v);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename... Ts>
+typename soa_vector<Ts...>::reference soa_vector<Ts...>::at(size_type pos) {
+  if (pos >= size_) {
+    throw std::out_of_range("n >= size");
+  }
+  return row(pos);
+}
+
+template <typename... Ts>
+typename soa_vector<Ts...>::const_reference soa_vector<Ts...>::at(
+    size_type pos) const {
+  if (pos >= size_) {
+    throw std::out_of_range("n >= size");
+  }
+  return row(pos);
+}
+
+template <typename... Ts>
+typename soa_vector<Ts...>::reference soa_vector<Ts...>::row(size_type pos) {
+  return std::apply([pos](Ts *...column) { return reference(column[pos]...); },
+                    columns_);
+}
+
+template <typename... Ts>
+typename soa_vector<Ts...>::const_reference soa_vector<Ts...>::row(
+    size_type pos) const {
+  return std::apply(
+      [pos](Ts *...column) { return const_reference(column[pos]...); },
+      columns_);
+}
+
+template <typename... Ts>
+template <typename F>
+void soa_vector<Ts...>::forEachColumn(F &&f) {
+  [&]<size_t... I>(std::index_sequence<I...>) {
+    (f(std::get<I>(columns_), std::integral_constant<size_t, I>()), ...);
+  }(std::index_sequence_for<Ts...>());
+}
+
+template <typename... Ts>
+std::tuple<Ts *...> soa_vector<Ts...>::allocateColumns(size_type n,
+                                                       bool zeroed) {
+  std::tuple<Ts *...> blocks{};
+  try {
+    std::apply(
+        [n, zeroed](Ts *&...block) {
+          ((block = zeroed ? new Ts[n]() : new Ts[n]), ...);
+        },
+        blocks);
+  } catch (...) {
+    std::apply([](Ts *...block) { (delete[] block, ...); }, blocks);
+    throw;
+  }
+  return blocks;
+}
+
+// Every row moves to the new columns before any old column is freed. If
+// an allocation or a move throws, the new columns are freed and the vector
+// keeps its old columns and capacity; rows a throwing move already passed
+// are left moved-from.
+template <typename... Ts>
+void soa_vector<Ts...>::reallocate(size_type new_capacity) {
+  trace_reallocation();
+  std::tuple<Ts *...> blocks = allocateColumns(new_capacity, false);
+  try {
+    forEachColumn([&](auto *&column, auto index) {
+      auto *block = std::get<decltype(index)::value>(blocks);
+      std::move(column, column + size_, block);
+    });
+  } catch (...) {
+    std::apply([](Ts *...block) { (delete[] block, ...); }, blocks);
+    throw;
+  }
+  destroy();
+  forEachColumn([&](auto *&column, auto index) {
+    column = std::get<decltype(index)::value>(blocks);
+    accounting_.allocated(new_capacity * sizeof(*column));
+  });
+  capacity_ = new_capacity;
+}
+
+template <typename... Ts>
+void soa_vector<Ts...>::grow(size_type min_capacity) {
+  size_type new_capacity = capacity_ ? capacity_ * 2 : 1;
+  if (new_capacity < min_capacity) new_capacity = min_capacity;
+  reallocate(new_capacity);
+}
+
+template <typename... Ts>
+void soa_vector<Ts...>::destroy() {
+  forEachColumn([&](auto *&column, auto) {
+    if (column) {
+      accounting_.freed(capacity_ * sizeof(*column));
+      delete[] column;
+      column = nullptr;
+    }
+  });
+}
+
+template <typename... Ts>
+void soa_vector<Ts...>::reserve(size_type size) {
+  trace_scope trace(trace_op::vector_reserve);
+  if (capacity_ < size) {
+    reallocate(size);
+  }
+}
+
+template <typename... Ts>
+void soa_vector<Ts...>::shrink_to_fit() {
+  trace_scope trace(trace_op::vector_shrink_to_fit);
+  if (size_ == capacity_) {
+    return;
+  }
+  if (size_ == 0) {
+    destroy();
+    capacity_ = 0;
+  } else {
+    reallocate(size_);
+  }
+}
+
+template <typename... Ts>
+memory_stats soa_vector<Ts...>::memory_usage() const {
+  memory_stats stats;
+  if (capacity_) {
+    stats.live_bytes = capacity_ * kRowBytes;
+    stats.nodes = sizeof...(Ts);
+    stats.slack_bytes = (capacity_ - size_) * kRowBytes;
+  }
+  accounting_.report(stats);
+  return stats;
+}
+
+template <typename... Ts>
+void soa_vector<Ts...>::push_back(const value_type &value) {
+  trace_scope trace(trace_op::vector_insert);  // an insert at end()
+  if (size_ == capacity_) grow(size_ + 1);
+  row(size_) = value;
+  ++size_;
+}
+
+template <typename... Ts>
+void soa_vector<Ts...>::swap(soa_vector &other) {
+  std::swap(columns_, other.columns_);
+  std::swap(size_, other.size_);
+  std::swap(capacity_, other.capacity_);
+  accounting_.exchange(other.accounting_, other.capacity_ * kRowBytes,
+                       capacity_ * kRowBytes);
+}
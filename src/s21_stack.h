@@ -24,6 +24,7 @@ class stack {
   void push(const_reference value) { stack_.push_back(value); };
   void pop() { stack_.pop_back(); };
   void swap(stack &other) { stack_.swap(other.stack_); };
+  memory_stats memory_usage() const { return stack_.memory_usage(); };
 
  private:
   list<T> stack_;
@@ -0,0 +1,83 @@
+#ifndef SRC_S21_STATIC_MAP_H_
+#define SRC_S21_STATIC_MAP_H_
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_map.h"
+#include "s21_static_set.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Immutable map built once from an s21::map. Keys are laid out in
+// Eytzinger order as in static_set, and the mapped values sit in a
+// parallel array at the same indices, so a lookup only touches key memory
+// until it lands.
+template <typename K, typename V, typename Compare = std::less<>>
+class static_map {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<key_type, mapped_type>;
+  using reference = std::pair<const key_type &, const mapped_type &>;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  class ConstIterator;
+
+  static_map() = default;
+  explicit static_map(const map<K, V, Compare> &source);
+  static_map(std::initializer_list<value_type> const &items);
+
+  ConstIterator begin() const;
+  ConstIterator end() const;
+
+  bool empty() const;
+  size_type size() const;
+  key_compare key_comp() const;
+  memory_stats memory_usage() const;
+
+  const V &at(const K &key) const;
+  bool contains(const K &key) const;
+  size_type count(const K &key) const;
+  ConstIterator find(const K &key) const;
+  ConstIterator lower_bound(const K &key) const;
+
+  class ConstIterator {
+   public:
+    struct ArrowProxy {
+      reference pair;
+      const reference *operator->() const { return &pair; }
+    };
+
+    bool operator==(const ConstIterator &other) const;
+    bool operator!=(const ConstIterator &other) const;
+    ConstIterator &operator++();
+    ConstIterator operator++(int);
+    reference operator*() const;
+    ArrowProxy operator->() const;
+
+   private:
+    friend class static_map;
+    ConstIterator(const static_map *owner, size_type index);
+    const static_map *owner_;
+    size_type index_;
+  };
+
+ private:
+  // Index 0 of both arrays is unused so that the root sits at index 1.
+  vector<K> keys_;
+  vector<V> values_;
+  size_type size_ = 0;
+  key_compare comp;
+
+  size_type findIndex(const K &key) const;
+};
+
+#include "s21_static_map.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_STATIC_MAP_H_
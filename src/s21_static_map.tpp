@@ -0,0 +1,149 @@
+using namespace s21;
+
+template <typename K, typename V, typename Compare>
+static_map<K, V, Compare>::static_map(const map<K, V, Compare> &source)
+    : keys_(source.size() + 1),
+      values_(source.size() + 1),
+      size_(source.size()),
+      comp(source.key_comp()) {
+  size_type k = eytzinger_first(size_);
+  for (auto it = source.begin(); it != source.end(); ++it) {
+    keys_[k] = it->first;
+    values_[k] = it->second;
+    k = eytzinger_next(k, size_);
+  }
+}
+
+template <typename K, typename V, typename Compare>
+static_map<K, V, Compare>::static_map(
+    std::initializer_list<value_type> const &items)
+    : static_map(map<K, V, Compare>(items.begin(), items.end())) {}
+
+template <typename K, typename V, typename Compare>
+typename static_map<K, V, Compare>::size_type
+static_map<K, V, Compare>::findIndex(const K &key) const {
+  size_type k = eytzinger_lower_bound(keys_.data(), size_, key, comp);
+  return (k != 0 && !comp(key, keys_[k])) ? k : 0;
+}
+
+template <typename K, typename V, typename Compare>
+typename static_map<K, V, Compare>::ConstIterator
+static_map<K, V, Compare>::begin() const {
+  return ConstIterator(this, eytzinger_first(size_));
+}
+
+template <typename K, typename V, typename Compare>
+typename static_map<K, V, Compare>::ConstIterator
+static_map<K, V, Compare>::end() const {
+  return ConstIterator(this, 0);
+}
+
+template <typename K, typename V, typename Compare>
+bool static_map<K, V, Compare>::empty() const {
+  return size_ == 0;
+}
+
+template <typename K, typename V, typename Compare>
+typename static_map<K, V, Compare>::size_type static_map<K, V, Compare>::size()
+    const {
+  return size_;
+}
+
+template <typename K, typename V, typename Compare>
+typename static_map<K, V, Compare>::key_compare
+static_map<K, V, Compare>::key_comp() const {
+  return comp;
+}
+
+// Slot 0 of both Eytzinger arrays is never used.
+template <typename K, typename V, typename Compare>
+memory_stats static_map<K, V, Compare>::memory_usage() const {
+  memory_stats stats = keys_.memory_usage();
+  stats += values_.memory_usage();
+  if (!keys_.empty()) {
+    stats.slack_bytes += sizeof(K) + sizeof(V);
+  }
+  return stats;
+}
+
+template <typename K, typename V, typename Compare>
+const V &static_map<K, V, Compare>::at(const K &key) const {
+  size_type k = findIndex(key);
+  if (k == 0) {
+    throw std::out_of_range("Key not found");
+  }
+  return values_[k];
+}
+
+template <typename K, typename V, typename Compare>
+bool static_map<K, V, Compare>::contains(const K &key) const {
+  return findIndex(key) != 0;
+}
+
+template <typename K, typename V, typename Compare>
+typename static_map<K, V, Compare>::size_type
+static_map<K, V, Compare>::count(const K &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+template <typename K, typename V, typename Compare>
+typename static_map<K, V, Compare>::ConstIterator
+static_map<K, V, Compare>::find(const K &key) const {
+  return ConstIterator(this, findIndex(key));
+}
+
+template <typename K, typename V, typename Compare>
+typename static_map<K, V, Compare>::ConstIterator
+static_map<K, V, Compare>::lower_bound(const K &key) const {
+  return ConstIterator(this,
+                       eytzinger_lower_bound(keys_.data(), size_, key, comp));
+}
+
+template <typename K, typename V, typename Compare>
+static_map<K, V, Compare>::ConstIterator::ConstIterator(
+    const static_map *owner, size_type index)
+    : owner_(owner), index_(index) {}
+
+template <typename K, typename V, typename Compare>
+bool static_map<K, V, Compare>::ConstIterator::operator==(
+    const ConstIterator &other) const {
+  return index_ == other.index_;
+}
+
+template <typename K, typename V, typename Compare>
+bool static_map<K, V, Compare>::ConstIterator::operator!=(
+    const ConstIterator &other) const {
+  return index_ != other.index_;
+}
+
+template <typename K, typename V, typename Compare>
+typename static_map<K, V, Compare>::ConstIterator &
+static_map<K, V, Compare>::ConstIterator::operator++() {
+  if (index_ != 0) {
+    index_ = eytzinger_next(index_, owner_->size_);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename Compare>
+typename static_map<K, V, Compare>::ConstIterator
+static_map<K, V, Compare>::ConstIterator::operator++(int) {
+  ConstIterator tmp = *this;
+  ++*this;
+  return tmp;
+}
+
+template <typename K, typename V, typename Compare>
+typename static_map<K, V, Compare>::reference
+static_map<K, V, Compare>::ConstIterator::operator*() const {
+  if (index_ == 0) {
+    throw std::runtime_error("Dereferencing null iterator");
+  }
+  return reference(owner_->keys_[index_], owner_->values_[index_]);
+}
+
+template <typename K, typename V, typename Compare>
+typename static_map<K, V, Compare>::ConstIterator::ArrowProxy
+static_map<K, V, Compare>::ConstIterator::operator->() const {
+  return ArrowProxy{**this};
+}
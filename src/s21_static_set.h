@@ -0,0 +1,107 @@
+#ifndef SRC_S21_STATIC_SET_H_
+#define SRC_S21_STATIC_SET_H_
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+
+#include "s21_set.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Lower bound over keys stored in Eytzinger (BFS) order at b[1..n]: the
+// children of b[k] are b[2k] and b[2k + 1]. The descent has no
+// data-dependent branch, and the descendants log2(64 / sizeof(T)) levels
+// below k, which fill one cache line, are prefetched while the upper
+// levels are compared.
+// Returns the index of the first key not less than key, or 0.
+template <typename T, typename Key, typename Compare>
+size_t eytzinger_lower_bound(const T *b, size_t n, const Key &key,
+                             const Compare &comp);
+
+// Index of the in-order successor of k in an n-key Eytzinger array, or 0.
+inline size_t eytzinger_next(size_t k, size_t n) {
+  if (2 * k + 1 <= n) {
+    k = 2 * k + 1;
+    while (2 * k <= n) k *= 2;
+    return k;
+  }
+  return k >> (std::countr_one(k) + 1);
+}
+
+// Index of the smallest key, or 0 when n is 0.
+inline size_t eytzinger_first(size_t n) {
+  size_t k = n ? 1 : 0;
+  while (k != 0 && 2 * k <= n) k *= 2;
+  return k;
+}
+
+// Immutable set for read-mostly lookups, built once from an s21::set. The
+// keys live in one contiguous array in Eytzinger order, so a lookup walks
+// an implicit tree whose top levels stay in cache instead of chasing heap
+// nodes. Iteration is in key order.
+template <typename T, typename Compare = std::less<>>
+class static_set {
+ public:
+  using key_type = T;
+  using value_type = T;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  class ConstIterator;
+
+  static_set() = default;
+  explicit static_set(const set<T, Compare> &source);
+  static_set(std::initializer_list<T> const &items);
+  template <typename InputIt>
+  static_set(InputIt first, InputIt last, const Compare &compare = Compare());
+
+  ConstIterator begin() const;
+  ConstIterator end() const;
+
+  bool empty() const;
+  size_type size() const;
+  key_compare key_comp() const;
+  memory_stats memory_usage() const;
+
+  bool contains(const T &key) const;
+  size_type count(const T &key) const;
+  ConstIterator find(const T &key) const;
+  ConstIterator lower_bound(const T &key) const;
+
+  class ConstIterator {
+   public:
+    bool operator==(const ConstIterator &other) const;
+    bool operator!=(const ConstIterator &other) const;
+    ConstIterator &operator++();
+    ConstIterator operator++(int);
+    const T &operator*() const;
+    const T *operator->() const;
+
+   private:
+    friend class static_set;
+    ConstIterator(const T *keys, size_type size, size_type index);
+    const T *keys_;
+    size_type size_;
+    size_type index_;
+  };
+
+ private:
+  // keys_[0] is unused so that the root sits at index 1.
+  vector<T> keys_;
+  size_type size_ = 0;
+  key_compare comp;
+
+  size_type findIndex(const T &key) const;
+  template <typename SortedIt>
+  void layout(SortedIt first, SortedIt last, size_type n);
+};
+
+#include "s21_static_set.tpp"
+}  // namespace s21
+
+#endif  //  SRC_S21_STATIC_SET_H_
@@ -0,0 +1,177 @@
+using namespace s21;
+
+template <typename T, typename Key, typename Compare>
+size_t eytzinger_lower_bound(const T *b, size_t n, const Key &key,
+                             const Compare &comp) {
+  constexpr size_t kBlock = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+  uintptr_t base = reinterpret_cast<uintptr_t>(b);
+  size_t k = 1;
+  while (k <= n) {
+    __builtin_prefetch(
+        reinterpret_cast<const void *>(base + k * kBlock * sizeof(T)));
+    k = 2 * k + comp(b[k], key);
+  }
+  // The path went right (key greater) after the answer and left ever
+  // since; strip those trailing right turns and the last left one.
+  return k >> (std::countr_one(k) + 1);
+}
+
+template <typename T, typename Compare>
+static_set<T, Compare>::static_set(const set<T, Compare> &source)
+    : comp(source.key_comp()) {
+  layout(source.begin(), source.end(), source.size());
+}
+
+template <typename T, typename Compare>
+static_set<T, Compare>::static_set(std::initializer_list<T> const &items)
+    : static_set(items.begin(), items.end()) {}
+
+template <typename T, typename Compare>
+template <typename InputIt>
+static_set<T, Compare>::static_set(InputIt first, InputIt last,
+                                   const Compare &compare)
+    : comp(compare) {
+  vector<T> sorted;
+  for (; first != last; ++first) {
+    sorted.push_back(*first);
+  }
+  std::sort(sorted.begin(), sorted.end(), comp);
+  auto unique_end = std::unique(
+      sorted.begin(), sorted.end(),
+      [this](const T &a, const T &b) { return !comp(a, b); });
+  layout(sorted.begin(), unique_end, unique_end - sorted.begin());
+}
+
+// Visits the Eytzinger slots in key order while reading the sorted input
+// once.
+template <typename T, typename Compare>
+template <typename SortedIt>
+void static_set<T, Compare>::layout(SortedIt first, SortedIt last,
+                                    size_type n) {
+  vector<T> keys(n + 1);
+  size_type k = eytzinger_first(n);
+  for (; first != last; ++first) {
+    keys[k] = *first;
+    k = eytzinger_next(k, n);
+  }
+  keys_.swap(keys);
+  size_ = n;
+}
+
+template <typename T, typename Compare>
+typename static_set<T, Compare>::size_type static_set<T, Compare>::findIndex(
+    const T &key) const {
+  size_type k = eytzinger_lower_bound(keys_.data(), size_, key, comp);
+  return (k != 0 && !comp(key, keys_[k])) ? k : 0;
+}
+
+template <typename T, typename Compare>
+typename static_set<T, Compare>::ConstIterator static_set<T, Compare>::begin()
+    const {
+  return ConstIterator(keys_.data(), size_, eytzinger_first(size_));
+}
+
+template <typename T, typename Compare>
+typename static_set<T, Compare>::ConstIterator static_set<T, Compare>::end()
+    const {
+  return ConstIterator(keys_.data(), size_, 0);
+}
+
+template <typename T, typename Compare>
+bool static_set<T, Compare>::empty() const {
+  return size_ == 0;
+}
+
+template <typename T, typename Compare>
+typename static_set<T, Compare>::size_type static_set<T, Compare>::size()
+    const {
+  return size_;
+}
+
+template <typename T, typename Compare>
+typename static_set<T, Compare>::key_compare static_set<T, Compare>::key_comp()
+    const {
+  return comp;
+}
+
+// Slot 0 of the Eytzinger array is never used.
+template <typename T, typename Compare>
+memory_stats static_set<T, Compare>::memory_usage() const {
+  memory_stats stats = keys_.memory_usage();
+  if (!keys_.empty()) {
+    stats.slack_bytes += sizeof(T);
+  }
+  return stats;
+}
+
+template <typename T, typename Compare>
+bool static_set<T, Compare>::contains(const T &key) const {
+  return findIndex(key) != 0;
+}
+
+template <typename T, typename Compare>
+typename static_set<T, Compare>::size_type static_set<T, Compare>::count(
+    const T &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+template <typename T, typename Compare>
+typename static_set<T, Compare>::ConstIterator static_set<T, Compare>::find(
+    const T &key) const {
+  return ConstIterator(keys_.data(), size_, findIndex(key));
+}
+
+template <typename T, typename Compare>
+typename static_set<T, Compare>::ConstIterator
+static_set<T, Compare>::lower_bound(const T &key) const {
+  return ConstIterator(keys_.data(), size_,
+                       eytzinger_lower_bound(keys_.data(), size_, key, comp));
+}
+
+template <typename T, typename Compare>
+static_set<T, Compare>::ConstIterator::ConstIterator(const T *keys,
+                                                     size_type size,
+                                                     size_type index)
+    : keys_(keys), size_(size), index_(index) {}
+
+template <typename T, typename Compare>
+bool static_set<T, Compare>::ConstIterator::operator==(
+    const ConstIterator &other) const {
+  return index_ == other.index_;
+}
+
+template <typename T, typename Compare>
+bool static_set<T, Compare>::ConstIterator::operator!=(
+    const ConstIterator &other) const {
+  return index_ != other.index_;
+}
+
+template <typename T, typename Compare>
+typename static_set<T, Compare>::ConstIterator &
+static_set<T, Compare>::ConstIterator::operator++() {
+  if (index_ != 0) {
+    index_ = eytzinger_next(index_, size_);
+  }
+  return *this;
+}
+
+template <typename T, typename Compare>
+typename static_set<T, Compare>::ConstIterator
+static_set<T, Compare>::ConstIterator::operator++(int) {
+  ConstIterator tmp = *this;
+  ++*this;
+  return tmp;
+}
+
+template <typename T, typename Compare>
+const T &static_set<T, Compare>::ConstIterator::operator*() const {
+  if (index_ == 0) {
+    throw std::runtime_error("Dereferencing null iterator");
+  }
+  return keys_[index_];
+}
+
+template <typename T, typename Compare>
+const T *static_set<T, Compare>::ConstIterator::operator->() const {
+  return &**this;
+}
@@ -1,11 +1,31 @@
+// Compiles in the allocation counters and operation tracing so the
+// memory_stats and trace tests see them.
+#define S21_MEMORY_STATS
+#define S21_TRACE
+
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
 #include <list>
 #include <map>
+#include <numeric>
 #include <queue>
+#include <random>
+#include <sstream>
 #include <stack>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "s21_containers.h"
+#include "s21_perf_counters.h"
 
 TEST(list, default_constructor) {
   s21::list<int> mylist;
@@ -446,12 +466,19 @@ TEST(vector, move_assignment_operators) {
   s21::vector<int> v1{1, 2, 3};
   s21::vector<int> v2;
   v2 = std::move(v1);
-  ASSERT_FALSE(v1.empty());
+  ASSERT_TRUE(v1.empty());
+  ASSERT_EQ(v1.capacity(), 0);
   ASSERT_FALSE(v2.empty());
   ASSERT_EQ(v2.size(), 3);
   ASSERT_EQ(v2[0], 1);
   ASSERT_EQ(v2[1], 2);
   ASSERT_EQ(v2[2], 3);
+  v1.push_back(4);
+  ASSERT_EQ(v1.size(), 1);
+  ASSERT_EQ(v1[0], 4);
+  s21::vector<int> &alias = v2;
+  v2 = std::move(alias);
+  ASSERT_EQ(v2.size(), 3);
 }
 
 TEST(vector, at) {
@@ -559,6 +586,83 @@ TEST(vector, max_size) {
   ASSERT_GE(v.max_size(), v.size());
 }
 
+// Runs the scans at every level the CPU has, over every start offset and
+// length up to a few registers, so that heads, bodies and tails all occur.
+template <typename T>
+void checkSimdKernels(T (*make)(int)) {
+  s21::vector<T> v;
+  for (int i = 0; i < 80; i++) v.push_back(make(i));
+  for (auto level : {s21::simd::level::scalar, s21::simd::level::sse2,
+                     s21::simd::level::avx2}) {
+    s21::simd::use(level);
+    for (int offset = 0; offset < 8; offset++) {
+      for (int length = 0; offset + length <= 80; length++) {
+        const T *first = v.data() + offset;
+        const T *last = first + length;
+        T probe = make(offset + length / 2);
+        ASSERT_EQ(s21::simd::find(first, last, probe),
+                  std::find(first, last, probe));
+        ASSERT_EQ(s21::simd::count(first, last, probe),
+                  size_t(std::count(first, last, probe)));
+        ASSERT_EQ(s21::simd::sum(first, last),
+                  std::accumulate(first, last, s21::simd::sum_type<T>(0)));
+        ASSERT_TRUE(s21::simd::equal(first, last, first));
+        if (length == 0) continue;
+        ASSERT_EQ(s21::simd::min(first, last), *std::min_element(first, last));
+        ASSERT_EQ(s21::simd::max(first, last), *std::max_element(first, last));
+        std::vector<T> copy(first, last);
+        copy[length - 1] = T(copy[length - 1] + 1);
+        ASSERT_FALSE(s21::simd::equal(first, last, copy.data()));
+      }
+    }
+  }
+  s21::simd::use(s21::simd::supported());
+}
+
+TEST(vector_simd, int32_kernels) {
+  checkSimdKernels<int32_t>(+[](int i) { return int32_t(i * 7919 % 61 - 30); });
+}
+
+TEST(vector_simd, float_kernels) {
+  // Halves keep every partial sum exact, so the order does not matter.
+  checkSimdKernels<float>(+[](int i) { return float(i * 7919 % 61) * 0.5f; });
+}
+
+TEST(vector_simd, fallback_types) {
+  checkSimdKernels<double>(+[](int i) { return double(i % 13); });
+  checkSimdKernels<uint8_t>(+[](int i) { return uint8_t(i * 31); });
+}
+
+TEST(vector_simd, vector_overloads_and_edge_cases) {
+  s21::vector<int32_t> v{3, -1, 4, 1, -5, 9, 2, -6, 5, 3, 5};
+  EXPECT_EQ(s21::simd::find(v, 9) - v.begin(), 5);
+  EXPECT_EQ(s21::simd::find(v, 7), v.end());
+  EXPECT_EQ(s21::simd::count(v, 5), 2u);
+  EXPECT_EQ(s21::simd::min(v), -6);
+  EXPECT_EQ(s21::simd::max(v), 9);
+  EXPECT_EQ(s21::simd::sum(v), 20);
+  s21::vector<int32_t> w(v);
+  EXPECT_TRUE(s21::simd::equal(v, w));
+  w.pop_back();
+  EXPECT_FALSE(s21::simd::equal(v, w));
+  s21::vector<int32_t> empty;
+  EXPECT_THROW(s21::simd::min(empty), std::out_of_range);
+  EXPECT_EQ(s21::simd::sum(empty), 0);
+
+  s21::vector<int32_t> big(100000);
+  for (size_t i = 0; i < big.size(); i++) big[i] = INT32_MAX;
+  EXPECT_EQ(s21::simd::sum(big), int64_t(INT32_MAX) * 100000);
+
+  s21::vector<float> nan(20);
+  nan[13] = NAN;
+  EXPECT_FALSE(s21::simd::equal(nan, nan));
+  EXPECT_EQ(s21::simd::find(nan, float(NAN)), nan.end());
+  s21::vector<float> zeros(20);
+  s21::vector<float> negativeZeros(20);
+  for (size_t i = 0; i < 20; i++) negativeZeros[i] = -0.0f;
+  EXPECT_TRUE(s21::simd::equal(zeros, negativeZeros));
+}
+
 TEST(mapConstructorTest, DefaultConstructor) {
   s21::map<int, std::string> m;
   EXPECT_EQ(m.size(), 0);
@@ -605,6 +709,9 @@ TEST(mapTest, Operator1) {
   s21::map<int, std::string> m{{1, "one"}, {2, "two"}, {3, "three"}};
   s21::map<int, std::string>::Iterator iter = m.end();
   iter--;
+  EXPECT_EQ(iter->first, 3);
+  EXPECT_EQ(iter->second, "three");
+  iter--;
   EXPECT_EQ(iter->first, 2);
   EXPECT_EQ(iter->second, "two");
 }
@@ -713,7 +820,9 @@ TEST(mapTest, Erase5) {
   map.insert(2, "two");
   map.insert(1, "one");
   s21::map<int, std::string>::Iterator it1 = map.end();
+  --it1;
   map.erase(it1->first);
+  EXPECT_FALSE(map.contains(3));
   EXPECT_EQ(map.size(), 2);
 }
 
@@ -764,6 +873,319 @@ TEST(mapTest, Count) {
   EXPECT_FALSE(map.count(3));
 }
 
+TEST(mapTest, FullScanMatchesStdMap) {
+  s21::map<int, int> m;
+  std::map<int, int> reference;
+  unsigned seed = 7;
+  for (int i = 0; i < 1000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = (seed >> 16) % 700;
+    m.insert(key, i);
+    reference[key] = i;
+  }
+  auto it = m.begin();
+  for (const auto &[key, value] : reference) {
+    ASSERT_TRUE(it != m.end());
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, value);
+    ++it;
+  }
+  EXPECT_TRUE(it == m.end());
+  auto rit = reference.rbegin();
+  for (auto back = m.end(); back != m.begin(); ++rit) {
+    --back;
+    EXPECT_EQ(back->first, rit->first);
+  }
+}
+
+TEST(mapTest, IterateAfterErase) {
+  s21::map<int, int> m;
+  std::map<int, int> reference;
+  for (int key : {50, 30, 70, 20, 40, 60, 80, 35, 45, 65}) {
+    m.insert(key, key);
+    reference.insert({key, key});
+  }
+  for (int key : {30, 50, 20, 80, 99}) {
+    m.erase(key);
+    reference.erase(key);
+    auto it = m.begin();
+    for (const auto &item : reference) {
+      ASSERT_TRUE(it != m.end());
+      EXPECT_EQ(it->first, item.first);
+      it++;
+    }
+    EXPECT_TRUE(it == m.end());
+  }
+  auto last = m.end();
+  last--;
+  EXPECT_EQ(last->first, 70);
+}
+
+TEST(mapTest, IteratorSurvivesEraseOfOtherNode) {
+  s21::map<int, int> m{{2, 2}, {1, 1}, {5, 5}, {4, 4}, {6, 6}};
+  auto it = m.begin();
+  ++it;
+  m.erase(5);
+  ++it;
+  EXPECT_EQ(it->first, 4);
+  ++it;
+  EXPECT_EQ(it->first, 6);
+  ++it;
+  EXPECT_TRUE(it == m.end());
+}
+
+struct CopyCountingKey {
+  static inline int copies = 0;
+  int value;
+  explicit CopyCountingKey(int v) : value(v) {}
+  CopyCountingKey(const CopyCountingKey &other) : value(other.value) {
+    ++copies;
+  }
+  CopyCountingKey(CopyCountingKey &&other) noexcept : value(other.value) {}
+  CopyCountingKey &operator=(const CopyCountingKey &other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+  bool operator<(const CopyCountingKey &other) const {
+    return value < other.value;
+  }
+};
+
+TEST(mapTest, LookupDoesNotCopyKeys) {
+  s21::map<CopyCountingKey, int> m;
+  for (int i : {50, 20, 80, 10, 30, 70, 90}) {
+    m.try_emplace(CopyCountingKey(i), i);
+  }
+  CopyCountingKey::copies = 0;
+  CopyCountingKey probe(30);
+  EXPECT_TRUE(m.contains(probe));
+  EXPECT_EQ(m.count(probe), 1);
+  EXPECT_EQ(m.at(probe), 30);
+  EXPECT_EQ(m[probe], 30);
+  EXPECT_EQ(m.find(probe)->second, 30);
+  m.erase(CopyCountingKey(90));
+  EXPECT_EQ(CopyCountingKey::copies, 0);
+}
+
+TEST(mapTest, HeterogeneousStringViewLookup) {
+  s21::map<std::string, int> m;
+  m.insert("alpha", 1);
+  m.insert("beta", 2);
+  m.insert("gamma", 3);
+  std::string_view probe = "beta";
+  EXPECT_TRUE(m.contains(probe));
+  EXPECT_EQ(m.at(probe), 2);
+  EXPECT_EQ(m.count(std::string_view("delta")), 0);
+  EXPECT_EQ(m.find(std::string_view("gamma"))->second, 3);
+  EXPECT_TRUE(m.find(std::string_view("omega")) == m.end());
+  EXPECT_THROW(m.at(std::string_view("omega")), std::out_of_range);
+  m.erase(std::string_view("alpha"));
+  EXPECT_FALSE(m.contains("alpha"));
+}
+
+TEST(mapTest, TryEmplaceAndInsertOrAssign) {
+  s21::map<std::string, std::string> m;
+  auto [it, inserted] = m.try_emplace("key", 3, 'x');
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(it->second, "xxx");
+  auto again = m.try_emplace("key", "ignored");
+  EXPECT_FALSE(again.second);
+  EXPECT_EQ(again.first->second, "xxx");
+  auto assigned = m.insert_or_assign("key", "new");
+  EXPECT_FALSE(assigned.second);
+  EXPECT_EQ(m.at("key"), "new");
+  EXPECT_TRUE(m.insert_or_assign(std::string("other"), "o").second);
+  EXPECT_EQ(m.size(), 2);
+}
+
+TEST(mapTest, BracketsInsertDefault) {
+  s21::map<std::string, int> m;
+  m["hits"] += 2;
+  m["hits"] += 3;
+  EXPECT_EQ(m.at("hits"), 5);
+  EXPECT_EQ(m["miss"], 0);
+  EXPECT_EQ(m.size(), 2);
+}
+
+TEST(mapTest, EmplaceConstructsPair) {
+  s21::map<int, std::string> m;
+  EXPECT_TRUE(m.emplace(1, "one").second);
+  EXPECT_FALSE(m.emplace(1, "uno").second);
+  EXPECT_EQ(m.at(1), "one");
+}
+
+struct ThreeWayCountingKey {
+  static inline int three_way_calls = 0;
+  static inline int less_calls = 0;
+  int value;
+  std::strong_ordering operator<=>(const ThreeWayCountingKey &other) const {
+    ++three_way_calls;
+    return value <=> other.value;
+  }
+  bool operator==(const ThreeWayCountingKey &other) const = default;
+  bool operator<(const ThreeWayCountingKey &other) const {
+    ++less_calls;
+    return value < other.value;
+  }
+};
+
+TEST(mapTest, ThreeWayComparisonOncePerNode) {
+  s21::map<ThreeWayCountingKey, int> m;
+  for (int key : {50, 30, 70, 20, 40, 60, 80}) m.insert({key}, key);
+  ThreeWayCountingKey::three_way_calls = 0;
+  ThreeWayCountingKey::less_calls = 0;
+  EXPECT_TRUE(m.contains({40}));
+  EXPECT_EQ(ThreeWayCountingKey::three_way_calls, 3);
+  EXPECT_EQ(ThreeWayCountingKey::less_calls, 0);
+}
+
+TEST(mapTest, CustomComparator) {
+  s21::map<int, std::string, std::greater<int>> m{
+      {1, "one"}, {3, "three"}, {2, "two"}};
+  std::string order;
+  for (auto it = m.begin(); it != m.end(); ++it) order += it->second[0];
+  EXPECT_EQ(order, "tto");
+  EXPECT_EQ(m.at(2), "two");
+  m.erase(3);
+  EXPECT_EQ(m.begin()->first, 2);
+}
+
+struct CaseInsensitiveLess {
+  bool operator()(const std::string &a, const std::string &b) const {
+    return std::lexicographical_compare(
+        a.begin(), a.end(), b.begin(), b.end(),
+        [](char x, char y) { return std::tolower(x) < std::tolower(y); });
+  }
+};
+
+TEST(set_test, custom_comparator) {
+  s21::set<std::string, CaseInsensitiveLess> s1{"Beta", "alpha", "BETA"};
+  EXPECT_EQ(s1.size(), 2);
+  EXPECT_TRUE(s1.contains("ALPHA"));
+  EXPECT_EQ(*s1.begin(), "alpha");
+  s21::set<int, std::greater<int>> s2{1, 5, 3};
+  EXPECT_EQ(*s2.begin(), 5);
+  s21::set<int, std::greater<int>> s3 = s2;
+  EXPECT_EQ(*(--s3.end()), 1);
+}
+
+TEST(mapTest, RangeConstructorKeepsFirstDuplicate) {
+  std::vector<std::pair<int, std::string>> items{
+      {3, "c"}, {1, "a"}, {3, "x"}, {2, "b"}, {1, "y"}};
+  s21::map<int, std::string> m(items.begin(), items.end());
+  EXPECT_EQ(m.size(), 3);
+  EXPECT_EQ(m.at(1), "a");
+  EXPECT_EQ(m.at(3), "c");
+  s21::map<int, std::string> copy(m);
+  EXPECT_EQ(copy.size(), 3);
+  EXPECT_EQ((--copy.end())->second, "c");
+}
+
+TEST(mapTest, MergeLeavesDuplicatesInSource) {
+  s21::map<int, int> a{{1, 1}, {3, 3}, {5, 5}};
+  s21::map<int, int> b{{2, 20}, {3, 30}, {6, 60}};
+  a.merge(b);
+  EXPECT_EQ(a.size(), 5);
+  EXPECT_EQ(a.at(3), 3);
+  EXPECT_EQ(b.size(), 1);
+  EXPECT_EQ(b.at(3), 30);
+  int expected[] = {1, 2, 3, 5, 6};
+  int i = 0;
+  for (auto it = a.begin(); it != a.end(); ++it) {
+    EXPECT_EQ(it->first, expected[i++]);
+  }
+  EXPECT_EQ(i, 5);
+}
+
+TEST(mapTest, LargeSortedBuildMatchesStdMap) {
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 100000; i++) items.push_back({i, -i});
+  s21::map<int, int> m(items.begin(), items.end());
+  std::map<int, int> reference(items.begin(), items.end());
+  EXPECT_EQ(m.size(), static_cast<int>(reference.size()));
+  auto it = m.begin();
+  for (const auto &[key, value] : reference) {
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, value);
+    ++it;
+  }
+  m.erase(500);
+  EXPECT_FALSE(m.contains(500));
+  EXPECT_EQ(m.at(99999), -99999);
+}
+
+TEST(set_test, range_constructor_and_merge) {
+  std::vector<int> items{5, 1, 4, 1, 3, 5, 2};
+  s21::set<int> s1(items.begin(), items.end());
+  EXPECT_EQ(s1.size(), 5);
+  s21::set<int> s2{4, 6, 8, 2};
+  s1.merge(s2);
+  EXPECT_EQ(s1.size(), 7);
+  EXPECT_EQ(s2.size(), 2);
+  EXPECT_TRUE(s2.contains(2));
+  EXPECT_TRUE(s2.contains(4));
+  int expected = 1;
+  for (auto it = s1.begin(); it != s1.end(); ++it, ++expected) {
+    if (expected == 7) expected = 8;
+    EXPECT_EQ(*it, expected);
+  }
+  s21::set<int> s3 = s1;
+  EXPECT_EQ(*(--s3.end()), 8);
+  s3.erase(8);
+  EXPECT_EQ(s3.size(), 6);
+}
+
+TEST(mapTest, NodeHandleMovesEntryWithoutCopies) {
+  s21::map<CopyCountingKey, std::string> a;
+  s21::map<CopyCountingKey, std::string> b;
+  for (int i : {5, 2, 8, 1, 3}) {
+    a.try_emplace(CopyCountingKey(i), std::to_string(i));
+  }
+  b.try_emplace(CopyCountingKey(3), "three");
+  const std::string *payload = &a.at(CopyCountingKey(2));
+  CopyCountingKey::copies = 0;
+
+  auto handle = a.extract(CopyCountingKey(2));
+  ASSERT_TRUE(handle);
+  EXPECT_EQ(handle.mapped(), "2");
+  EXPECT_EQ(a.size(), 4);
+  EXPECT_FALSE(a.contains(CopyCountingKey(2)));
+  auto result = b.insert(std::move(handle));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_TRUE(result.node.empty());
+  EXPECT_EQ(result.position->first.value, 2);
+  EXPECT_EQ(&b.at(CopyCountingKey(2)), payload);
+
+  auto clash = b.insert(a.extract(a.find(CopyCountingKey(3))));
+  EXPECT_FALSE(clash.inserted);
+  EXPECT_EQ(clash.position->second, "three");
+  EXPECT_EQ(clash.node.mapped(), "3");
+  clash.node.key().value = 4;
+  EXPECT_TRUE(b.insert(std::move(clash.node)).inserted);
+  EXPECT_EQ(b.at(CopyCountingKey(4)), "3");
+  EXPECT_EQ(CopyCountingKey::copies, 0);
+  EXPECT_EQ(b.size(), 3);
+  EXPECT_TRUE(a.extract(CopyCountingKey(42)).empty());
+}
+
+TEST(set_test, node_handle) {
+  s21::set<std::string> a{"apple", "kiwi", "pear"};
+  s21::set<std::string> b{"fig"};
+  const std::string *address = &*a.find("kiwi");
+  auto handle = a.extract("kiwi");
+  EXPECT_EQ(handle.value(), "kiwi");
+  auto result = b.insert(std::move(handle));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ(&*result.position, address);
+  EXPECT_EQ(a.size(), 2);
+  EXPECT_EQ(b.size(), 2);
+  EXPECT_EQ(*(--b.end()), "kiwi");
+  auto leftover = a.extract(a.begin());
+  EXPECT_EQ(leftover.value(), "apple");
+  EXPECT_EQ(*a.begin(), "pear");
+}
+
 TEST(set_test, constr1) {
   s21::set<int> s1 = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
   std::set<int> s2 = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
@@ -1033,8 +1455,8 @@ TEST(set_test, iter2) {
   std::set<int>::iterator it2 = s2.end();
   for (int i = 0; i < 4; i++) {
     --it2;
-    EXPECT_EQ(*it1, *it2);
     --it1;
+    EXPECT_EQ(*it1, *it2);
   }
 }
 
@@ -1043,10 +1465,10 @@ TEST(set_test, iter3) {
   std::set<int> s2 = {1, 5, 2, 4, 3, 6, 7, 8};
   s21::set<int>::Iterator it1 = s1.end();
   std::set<int>::iterator it2 = s2.end();
-  for (int i = 0; i < 7; i++) {
+  for (int i = 0; i < 8; i++) {
     --it2;
-    EXPECT_EQ(*it1, *it2);
     --it1;
+    EXPECT_EQ(*it1, *it2);
   }
 }
 
@@ -1055,10 +1477,46 @@ TEST(set_test, iter4) {
   std::set<int> s2 = {1, 3, 7, 4, 2, 6, 5, 8};
   s21::set<int>::Iterator it1 = s1.end();
   std::set<int>::iterator it2 = s2.end();
-  for (int i = 0; i < 7; i++) {
+  for (int i = 0; i < 8; i++) {
     --it2;
-    EXPECT_EQ(*it1, *it2);
     --it1;
+    EXPECT_EQ(*it1, *it2);
+  }
+}
+
+TEST(set_test, end_is_past_the_last) {
+  s21::set<int> s1 = {4, 2, 6};
+  auto it = s1.begin();
+  for (int i = 0; i < 3; i++) ++it;
+  EXPECT_TRUE(it == s1.end());
+  const s21::set<int> &cs = s1;
+  auto cit = cs.end();
+  --cit;
+  EXPECT_EQ(*cit, 6);
+}
+
+TEST(set_test, iterate_after_erase) {
+  s21::set<int> s1;
+  std::set<int> s2;
+  unsigned seed = 99;
+  for (int i = 0; i < 500; i++) {
+    seed = seed * 1103515245 + 12345;
+    int value = (seed >> 16) % 300;
+    s1.insert(value);
+    s2.insert(value);
+  }
+  for (int i = 0; i < 300; i += 3) {
+    s1.erase(i);
+    s2.erase(i);
+  }
+  ASSERT_EQ(s1.size(), static_cast<int>(s2.size()));
+  auto it1 = s1.begin();
+  for (int value : s2) EXPECT_EQ(*it1++, value);
+  EXPECT_TRUE(it1 == s1.end());
+  auto it2 = s2.rbegin();
+  for (auto back = s1.end(); back != s1.begin(); ++it2) {
+    --back;
+    EXPECT_EQ(*back, *it2);
   }
 }
 
@@ -1249,6 +1707,1667 @@ TEST(Set_Lookup, contains) {
   EXPECT_EQ(false, s21_set.contains(9555));
 }
 
+TEST(flat_set, bulk_construct_sorts_and_dedups) {
+  s21::flat_set<int> fs{5, 3, 9, 3, 1, 5, 7};
+  std::set<int> ss{5, 3, 9, 3, 1, 5, 7};
+  ASSERT_EQ(fs.size(), ss.size());
+  auto it = fs.begin();
+  for (int value : ss) EXPECT_EQ(*it++, value);
+}
+
+TEST(flat_set, insert_find_erase) {
+  s21::flat_set<std::string> fs;
+  EXPECT_TRUE(fs.insert("pear").second);
+  EXPECT_TRUE(fs.insert("apple").second);
+  EXPECT_FALSE(fs.insert("pear").second);
+  EXPECT_EQ(fs.size(), 2);
+  EXPECT_EQ(*fs.begin(), "apple");
+  EXPECT_TRUE(fs.contains("apple"));
+  EXPECT_EQ(fs.find("plum"), fs.end());
+  EXPECT_EQ(fs.erase("apple"), 1);
+  EXPECT_EQ(fs.erase("apple"), 0);
+  EXPECT_EQ(fs.size(), 1);
+}
+
+TEST(flat_set, bounds) {
+  s21::flat_set<int> fs{10, 20, 30, 40};
+  EXPECT_EQ(*fs.lower_bound(20), 20);
+  EXPECT_EQ(*fs.lower_bound(21), 30);
+  EXPECT_EQ(*fs.upper_bound(20), 30);
+  EXPECT_EQ(fs.lower_bound(41), fs.end());
+  EXPECT_EQ(fs.lower_bound(-5), fs.begin());
+}
+
+TEST(flat_set, insert_range_merges) {
+  s21::flat_set<int> fs{1, 4, 9};
+  s21::vector<int> more{8, 2, 4, 12, 2};
+  fs.insert_range(more.begin(), more.end());
+  std::set<int> ss{1, 4, 9, 8, 2, 12};
+  ASSERT_EQ(fs.size(), ss.size());
+  auto it = fs.begin();
+  for (int value : ss) EXPECT_EQ(*it++, value);
+}
+
+TEST(flat_set, matches_std_set_on_random_input) {
+  s21::flat_set<int> fs;
+  std::set<int> ss;
+  unsigned seed = 12345;
+  for (int i = 0; i < 2000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int value = (seed >> 16) % 500;
+    fs.insert(value);
+    ss.insert(value);
+  }
+  ASSERT_EQ(fs.size(), ss.size());
+  for (int i = -1; i <= 501; i++) EXPECT_EQ(fs.contains(i), ss.count(i) == 1);
+}
+
+TEST(flat_map, bulk_construct_first_wins) {
+  s21::flat_map<int, std::string> fm{
+      {3, "three"}, {1, "one"}, {3, "drei"}, {2, "two"}};
+  ASSERT_EQ(fm.size(), 3);
+  EXPECT_EQ(fm.at(1), "one");
+  EXPECT_EQ(fm.at(3), "three");
+  EXPECT_EQ(fm.keys()[0], 1);
+  EXPECT_EQ(fm.values()[2], "three");
+  EXPECT_THROW(fm.at(4), std::out_of_range);
+}
+
+TEST(flat_map, insert_and_brackets) {
+  s21::flat_map<std::string, int> fm;
+  EXPECT_TRUE(fm.insert("b", 2).second);
+  EXPECT_FALSE(fm.insert("b", 5).second);
+  EXPECT_EQ(fm["b"], 2);
+  fm["a"] = 1;
+  EXPECT_EQ(fm.size(), 2);
+  EXPECT_EQ(fm.begin()->first, "a");
+  EXPECT_EQ((*fm.begin()).second, 1);
+  EXPECT_FALSE(fm.insert_or_assign("b", 7).second);
+  EXPECT_EQ(fm.at("b"), 7);
+}
+
+TEST(flat_map, iteration_and_erase) {
+  s21::flat_map<int, int> fm{{5, 50}, {1, 10}, {3, 30}};
+  int expected = 1;
+  for (auto [key, value] : fm) {
+    EXPECT_EQ(key, expected);
+    EXPECT_EQ(value, expected * 10);
+    value += 1;
+    expected += 2;
+  }
+  EXPECT_EQ(fm.at(1), 11);
+  fm.erase(fm.find(3));
+  EXPECT_FALSE(fm.contains(3));
+  EXPECT_EQ(fm.erase(5), 1);
+  EXPECT_EQ(fm.size(), 1);
+}
+
+TEST(flat_map, insert_range_merges) {
+  s21::flat_map<int, char> fm{{2, 'b'}, {4, 'd'}};
+  std::pair<int, char> more[] = {{3, 'c'}, {1, 'a'}, {4, 'x'}, {5, 'e'}};
+  fm.insert_range(std::begin(more), std::end(more));
+  ASSERT_EQ(fm.size(), 5);
+  std::string joined;
+  for (auto it = fm.begin(); it != fm.end(); ++it) joined += it.value();
+  EXPECT_EQ(joined, "abcde");
+}
+
+template <typename Set>
+std::vector<int> toVector(const Set &s) {
+  std::vector<int> out;
+  for (auto it = s.begin(); it != s.end(); ++it) out.push_back(*it);
+  return out;
+}
+
+TEST(set_algebra, small_sets) {
+  s21::set<int> a{1, 2, 3, 5, 8};
+  s21::set<int> b{2, 3, 4, 8, 9};
+  EXPECT_EQ(toVector(s21::set_union(a, b)),
+            (std::vector<int>{1, 2, 3, 4, 5, 8, 9}));
+  EXPECT_EQ(toVector(s21::set_intersection(a, b)),
+            (std::vector<int>{2, 3, 8}));
+  EXPECT_EQ(toVector(s21::set_difference(a, b)), (std::vector<int>{1, 5}));
+  EXPECT_EQ(toVector(s21::set_symmetric_difference(a, b)),
+            (std::vector<int>{1, 4, 5, 9}));
+  s21::set<int> empty;
+  EXPECT_EQ(s21::set_intersection(a, empty).size(), 0);
+  EXPECT_EQ(s21::set_union(empty, b).size(), 5);
+}
+
+TEST(set_algebra, map_key_sets) {
+  s21::map<int, std::string, std::greater<int>> a{
+      {1, "a"}, {2, "b"}, {3, "c"}};
+  s21::map<int, double, std::greater<int>> b{{3, 0.5}, {4, 1.5}};
+  s21::set<int, std::greater<int>> keys = s21::set_union(a, b);
+  EXPECT_EQ(toVector(keys), (std::vector<int>{4, 3, 2, 1}));
+  EXPECT_EQ(toVector(s21::set_difference(a, b)), (std::vector<int>{2, 1}));
+}
+
+TEST(set_algebra, parallel_matches_std) {
+  std::set<int> std_a;
+  std::set<int> std_b;
+  std::vector<int> a_items;
+  std::vector<int> b_items;
+  for (int i = 0; i < 200000; i++) {
+    if (i % 3 == 0) a_items.push_back(i);
+    if (i % 5 == 0 || i > 150000) b_items.push_back(i);
+  }
+  std_a.insert(a_items.begin(), a_items.end());
+  std_b.insert(b_items.begin(), b_items.end());
+  s21::set<int> a(a_items.begin(), a_items.end());
+  s21::set<int> b(b_items.begin(), b_items.end());
+  std::vector<int> expected;
+  std::set_symmetric_difference(std_a.begin(), std_a.end(), std_b.begin(),
+                                std_b.end(), std::back_inserter(expected));
+  EXPECT_EQ(toVector(s21::set_symmetric_difference(a, b, 4)), expected);
+  expected.clear();
+  std::set_intersection(std_a.begin(), std_a.end(), std_b.begin(),
+                        std_b.end(), std::back_inserter(expected));
+  EXPECT_EQ(toVector(s21::set_intersection(a, b, 4)), expected);
+  EXPECT_EQ(toVector(s21::set_union(a, b, 3)), toVector(s21::set_union(a, b)));
+  EXPECT_EQ(toVector(s21::set_difference(b, a, 8)),
+            toVector(s21::set_difference(b, a)));
+}
+
+TEST(persistent_map, snapshot_is_isolated) {
+  s21::persistent_map<int, std::string> m{{2, "two"}, {1, "one"}};
+  s21::persistent_map<int, std::string> before = m.snapshot();
+  EXPECT_TRUE(m.insert(3, "three"));
+  EXPECT_FALSE(m.insert(1, "uno"));
+  EXPECT_FALSE(m.insert_or_assign(2, "dos"));
+  EXPECT_EQ(m.erase(1), 1);
+  EXPECT_EQ(m.erase(1), 0);
+  EXPECT_EQ(m.size(), 2);
+  EXPECT_EQ(m.at(2), "dos");
+  EXPECT_EQ(m.find(1), nullptr);
+  EXPECT_EQ(before.size(), 2);
+  EXPECT_EQ(before.at(1), "one");
+  EXPECT_EQ(before.at(2), "two");
+  EXPECT_FALSE(before.contains(3));
+  EXPECT_THROW(m.at(1), std::out_of_range);
+}
+
+TEST(persistent_map, updates_share_untouched_nodes) {
+  s21::persistent_map<int, int> m;
+  for (int i = 0; i < 1000; i++) m.insert(i, i);
+  s21::persistent_map<int, int> old = m.snapshot();
+  m.insert_or_assign(500, -1);
+  int shared = 0;
+  for (int i = 0; i < 1000; i++) shared += (m.find(i) == old.find(i));
+  EXPECT_GE(shared, 1000 - 20);
+  EXPECT_NE(m.find(500), old.find(500));
+  EXPECT_EQ(*old.find(500), 500);
+}
+
+TEST(persistent_map, matches_std_map) {
+  s21::persistent_map<int, int> m;
+  std::map<int, int> reference;
+  unsigned seed = 7;
+  for (int i = 0; i < 20000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = (seed >> 8) % 3000;
+    if (i % 3 == 0) {
+      EXPECT_EQ(m.erase(key), reference.erase(key));
+    } else {
+      m.insert_or_assign(key, i);
+      reference[key] = i;
+    }
+  }
+  EXPECT_EQ(m.size(), reference.size());
+  auto it = m.begin();
+  for (const auto &[key, value] : reference) {
+    ASSERT_NE(it, m.end());
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, value);
+    ++it;
+  }
+  EXPECT_EQ(it, m.end());
+}
+
+TEST(persistent_map, reader_keeps_snapshot_while_writer_updates) {
+  s21::persistent_map<int, int> m;
+  for (int i = 0; i < 5000; i++) m.insert(i, i);
+  s21::persistent_map<int, int> view = m.snapshot();
+  long sum = 0;
+  std::thread reader([&view, &sum] {
+    for (auto it = view.begin(); it != view.end(); ++it) sum += it->second;
+  });
+  for (int i = 0; i < 5000; i += 2) m.erase(i);
+  for (int i = 5000; i < 8000; i++) m.insert(i, i);
+  reader.join();
+  EXPECT_EQ(sum, 5000L * 4999 / 2);
+  EXPECT_EQ(view.size(), 5000);
+  EXPECT_EQ(m.size(), 5500);
+}
+
+TEST(persistent_map, readers_load_versions_a_writer_publishes) {
+  s21::persistent_map<int, int>::atomic_root root;
+  EXPECT_TRUE(root.load().empty());
+  std::atomic<bool> done{false};
+  int loads = 0;
+  std::thread reader([&root, &done, &loads] {
+    size_t last = 0;
+    do {
+      s21::persistent_map<int, int> version = root.load();
+      // Version n holds the keys 0..n-1, each mapped to its square.
+      size_t n = 0;
+      for (auto it = version.begin(); it != version.end(); ++it, ++n) {
+        ASSERT_EQ(it->first, int(n));
+        ASSERT_EQ(it->second, int(n * n));
+      }
+      ASSERT_EQ(n, version.size());
+      ASSERT_GE(n, last);
+      last = n;
+      loads++;
+    } while (!done);
+  });
+  s21::persistent_map<int, int> m;
+  for (int i = 0; i < 2000; i++) {
+    m.insert(i, i * i);
+    root.publish(m);
+  }
+  done = true;
+  reader.join();
+  EXPECT_GT(loads, 0);
+  EXPECT_EQ(root.load().size(), 2000u);
+  EXPECT_EQ(root.load().at(1999), 1999 * 1999);
+}
+
+TEST(concurrent_map, basic_operations) {
+  s21::concurrent_map<std::string, int> m(5);
+  EXPECT_EQ(m.shard_count(), 8);
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.insert("a", 1));
+  EXPECT_FALSE(m.insert("a", 2));
+  EXPECT_EQ(m.find("a"), 1);
+  EXPECT_FALSE(m.insert_or_assign("a", 3));
+  EXPECT_EQ(m.find("a"), 3);
+  EXPECT_FALSE(m.find("b").has_value());
+  EXPECT_EQ(m.compute_if_absent("b", [] { return 7; }), 7);
+  EXPECT_EQ(m.compute_if_absent("b", [] { return 8; }), 7);
+  EXPECT_TRUE(m.update("b", [](int &v) { v *= 2; }));
+  EXPECT_FALSE(m.update("c", [](int &v) { v = 0; }));
+  EXPECT_EQ(m.find("b"), 14);
+  EXPECT_EQ(m.size(), 2);
+  EXPECT_TRUE(m.erase("a"));
+  EXPECT_FALSE(m.erase("a"));
+  EXPECT_FALSE(m.contains("a"));
+  for (int i = 0; i < 1000; i++) m.insert(std::to_string(i), i);
+  EXPECT_EQ(m.size(), 1001);
+  EXPECT_EQ(m.find("999"), 999);
+  m.clear();
+  EXPECT_TRUE(m.empty());
+}
+
+TEST(concurrent_map, parallel_writers_and_readers) {
+  s21::concurrent_map<int, int> m(16);
+  std::atomic<int> computed{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&m, &computed, t] {
+      for (int i = t; i < 20000; i += 4) m.insert(i, i);
+      for (int i = 0; i < 1000; i++) {
+        m.compute_if_absent(-1 - i, [&computed, i] {
+          computed++;
+          return i;
+        });
+        m.update(i, [](int &v) { v++; });
+        EXPECT_TRUE(!m.contains(i) || *m.find(i) >= i);
+      }
+      for (int i = t; i < 20000; i += 8) m.erase(i);
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  EXPECT_EQ(computed, 1000);
+  EXPECT_EQ(m.size(), 10000 + 1000);
+  EXPECT_FALSE(m.contains(0));
+  EXPECT_EQ(m.find(19999), 19999);
+}
+
+// Integer keys hash to themselves, so keys that share their low bits must
+// still spread over a shard's buckets. With one shard and every key a
+// multiple of 4096, a bucket taken from the unmixed low bits would put all
+// of them in one chain and make the loop quadratic.
+TEST(concurrent_map, strided_keys_keep_chains_short) {
+  const int n = 1 << 16;
+  auto fillAndFind = [n](int stride) {
+    auto best = std::chrono::steady_clock::duration::max();
+    for (int run = 0; run < 3; run++) {
+      auto start = std::chrono::steady_clock::now();
+      s21::concurrent_map<long, int> m(1);
+      for (int i = 0; i < n; i++) m.insert(long(i) * stride, i);
+      for (int i = 0; i < n; i++) EXPECT_EQ(m.find(long(i) * stride), i);
+      best = std::min(best, std::chrono::steady_clock::now() - start);
+    }
+    return best;
+  };
+  auto sequential = fillAndFind(1);
+  auto strided = fillAndFind(4096);
+  EXPECT_LT(strided, 4 * sequential);
+}
+
+TEST(concurrent_skiplist, map_matches_std_map) {
+  s21::concurrent_skiplist_map<int, std::string> m;
+  std::map<int, std::string> reference;
+  unsigned seed = 11;
+  for (int i = 0; i < 5000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = (seed >> 8) % 700;
+    if (i % 3 == 0) {
+      EXPECT_EQ(m.erase(key), reference.erase(key) == 1);
+    } else {
+      EXPECT_EQ(m.insert(key, std::to_string(i)),
+                reference.insert({key, std::to_string(i)}).second);
+    }
+  }
+  EXPECT_EQ(m.size(), reference.size());
+  auto it = m.begin();
+  for (const auto &[key, value] : reference) {
+    ASSERT_TRUE(it != m.end());
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, value);
+    ++it;
+  }
+  EXPECT_TRUE(it == m.end());
+  auto from = m.lower_bound(350);
+  EXPECT_EQ(from->first, reference.lower_bound(350)->first);
+  EXPECT_EQ(*m.find(from->first), reference.lower_bound(350)->second);
+  EXPECT_FALSE(m.find(-1).has_value());
+}
+
+struct LiveCounter {
+  static inline std::atomic<int> live{0};
+  int value;
+  LiveCounter(int v) : value(v) { live++; }
+  LiveCounter(const LiveCounter &other) : value(other.value) { live++; }
+  ~LiveCounter() { live--; }
+};
+
+TEST(concurrent_skiplist, erased_nodes_are_reclaimed) {
+  {
+    s21::concurrent_skiplist_map<int, LiveCounter> m;
+    for (int round = 0; round < 10; round++) {
+      for (int i = 0; i < 100; i++) m.insert(i, LiveCounter(i));
+      for (int i = 0; i < 100; i++) m.erase(i);
+    }
+    EXPECT_LT(LiveCounter::live, 1000);
+    m.insert(1, LiveCounter(1));
+  }
+  EXPECT_LT(LiveCounter::live, 1000);
+}
+
+TEST(concurrent_skiplist, concurrent_writers_and_scanners) {
+  s21::concurrent_skiplist_set<int> s;
+  for (int i = 0; i < 4000; i += 2) s.insert(i);
+  std::atomic<bool> ordered{true};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&s, t] {
+      for (int i = 1 + 2 * t; i < 4000; i += 8) s.insert(i);
+      for (int i = 4 * t; i < 4000; i += 16) s.erase(i);
+    });
+  }
+  threads.emplace_back([&s, &ordered] {
+    for (int scan = 0; scan < 20; scan++) {
+      int previous = -1;
+      for (auto it = s.lower_bound(100); it != s.end(); ++it) {
+        if (*it <= previous || *it < 100) ordered = false;
+        previous = *it;
+      }
+    }
+  });
+  for (std::thread &thread : threads) thread.join();
+  EXPECT_TRUE(ordered);
+  int count = 0;
+  int previous = -1;
+  for (int value : s) {
+    EXPECT_GT(value, previous);
+    EXPECT_NE(value % 4, 0);
+    previous = value;
+    count++;
+  }
+  EXPECT_EQ(count, 3000);
+  EXPECT_EQ(s.size(), 3000);
+}
+
+TEST(static_set, matches_source_set) {
+  for (int n : {0, 1, 2, 7, 8, 100, 1023, 1024, 1025}) {
+    std::vector<int> items;
+    for (int i = 0; i < n; i++) items.push_back(3 * i);
+    s21::set<int> source(items.begin(), items.end());
+    s21::static_set<int> frozen(source);
+    EXPECT_EQ(frozen.size(), static_cast<size_t>(n));
+    EXPECT_EQ(toVector(frozen), items);
+    for (int probe = -1; probe <= 3 * n; probe++) {
+      EXPECT_EQ(frozen.contains(probe),
+                probe >= 0 && probe < 3 * n && probe % 3 == 0);
+      auto it = frozen.lower_bound(probe);
+      auto expected = std::lower_bound(items.begin(), items.end(), probe);
+      if (expected == items.end()) {
+        EXPECT_TRUE(it == frozen.end());
+      } else {
+        EXPECT_EQ(*it, *expected);
+      }
+    }
+  }
+}
+
+TEST(static_set, custom_comparator) {
+  s21::static_set<int, std::greater<int>> frozen{4, 1, 9, 7};
+  EXPECT_EQ(toVector(frozen), (std::vector<int>{9, 7, 4, 1}));
+  EXPECT_EQ(*frozen.lower_bound(5), 4);
+  EXPECT_TRUE(frozen.find(8) == frozen.end());
+  EXPECT_EQ(*frozen.find(7), 7);
+}
+
+TEST(static_map, lookups_and_order) {
+  s21::map<std::string, int> source{{"pear", 3}, {"apple", 1}, {"fig", 2}};
+  s21::static_map<std::string, int> frozen(source);
+  EXPECT_EQ(frozen.size(), 3);
+  EXPECT_EQ(frozen.at("fig"), 2);
+  EXPECT_THROW(frozen.at("kiwi"), std::out_of_range);
+  EXPECT_TRUE(frozen.contains("pear"));
+  EXPECT_EQ(frozen.count("plum"), 0);
+  EXPECT_EQ(frozen.find("apple")->second, 1);
+  EXPECT_EQ(frozen.lower_bound("b")->first, "fig");
+  std::string order;
+  for (auto it = frozen.begin(); it != frozen.end(); ++it) {
+    order += (*it).first[0];
+  }
+  EXPECT_EQ(order, "afp");
+  s21::static_map<int, int> empty;
+  EXPECT_TRUE(empty.begin() == empty.end());
+  EXPECT_FALSE(empty.contains(0));
+}
+
+TEST(lru_cache, evicts_least_recently_used) {
+  s21::lru_cache<int, std::string> cache(3);
+  std::vector<int> evicted;
+  cache.set_eviction_callback(
+      [&evicted](const int &key, std::string &) { evicted.push_back(key); });
+  EXPECT_TRUE(cache.put(1, "one"));
+  EXPECT_TRUE(cache.put(2, "two"));
+  EXPECT_TRUE(cache.put(3, "three"));
+  ASSERT_NE(cache.get(1), nullptr);
+  EXPECT_TRUE(cache.put(4, "four"));
+  EXPECT_EQ(evicted, std::vector<int>{2});
+  EXPECT_FALSE(cache.contains(2));
+  EXPECT_FALSE(cache.put(3, "THREE"));
+  EXPECT_TRUE(cache.put(5, "five"));
+  EXPECT_EQ(evicted, (std::vector<int>{2, 1}));
+  EXPECT_EQ(*cache.peek(3), "THREE");
+  EXPECT_EQ(cache.get(2), nullptr);
+  EXPECT_EQ(cache.stats().hits, 1);
+  EXPECT_EQ(cache.stats().misses, 1);
+  EXPECT_EQ(cache.stats().evictions, 2);
+  EXPECT_TRUE(cache.erase(4));
+  EXPECT_FALSE(cache.erase(4));
+  EXPECT_EQ(cache.size(), 2);
+  cache.reset_stats();
+  EXPECT_EQ(cache.stats().hits, 0);
+  cache.clear();
+  EXPECT_TRUE(cache.empty());
+  EXPECT_EQ(evicted.size(), 2);
+}
+
+TEST(lru_cache, byte_budget) {
+  s21::lru_cache<int, std::string> cache(
+      10, [](const int &, const std::string &value) { return value.size(); });
+  cache.put(1, "aaaa");
+  cache.put(2, "bbbb");
+  EXPECT_EQ(cache.cost(), 8);
+  cache.put(3, "cc");
+  EXPECT_EQ(cache.size(), 3);
+  cache.put(1, "aaaaaa");
+  EXPECT_FALSE(cache.contains(2));
+  EXPECT_EQ(cache.cost(), 8);
+  cache.put(4, std::string(11, 'x'));
+  EXPECT_FALSE(cache.contains(4));
+  EXPECT_TRUE(cache.empty());
+  EXPECT_EQ(cache.cost(), 0);
+}
+
+TEST(lru_cache, many_entries) {
+  s21::lru_cache<int, int> cache(1000);
+  for (int i = 0; i < 10000; i++) cache.put(i, i);
+  EXPECT_EQ(cache.size(), 1000);
+  for (int i = 0; i < 9000; i++) EXPECT_FALSE(cache.contains(i));
+  for (int i = 9000; i < 10000; i++) EXPECT_EQ(*cache.get(i), i);
+  EXPECT_EQ(cache.stats().evictions, 9000);
+}
+
+TEST(memory_stats, vector_buffer) {
+  s21::vector<int> v;
+  EXPECT_EQ(v.memory_usage().nodes, 0u);
+  v.reserve(8);
+  v.push_back(1);
+  v.push_back(2);
+  s21::memory_stats stats = v.memory_usage();
+  EXPECT_EQ(stats.live_bytes, 8 * sizeof(int));
+  EXPECT_EQ(stats.slack_bytes, 6 * sizeof(int));
+  EXPECT_EQ(stats.nodes, 1u);
+  EXPECT_EQ(stats.allocations, 1u);
+  v.shrink_to_fit();
+  stats = v.memory_usage();
+  EXPECT_EQ(stats.live_bytes, 2 * sizeof(int));
+  EXPECT_EQ(stats.slack_bytes, 0u);
+  EXPECT_EQ(stats.allocations, 2u);
+  EXPECT_EQ(stats.deallocations, 1u);
+  // Both buffers are alive while the elements are copied across.
+  EXPECT_EQ(stats.peak_bytes, 10 * sizeof(int));
+
+  s21::vector<int> moved(std::move(v));
+  EXPECT_EQ(moved.memory_usage().live_bytes, 2 * sizeof(int));
+  EXPECT_EQ(moved.memory_usage().allocations, 0u);
+  EXPECT_EQ(v.memory_usage().live_bytes, 0u);
+}
+
+TEST(memory_stats, list_nodes_are_freed) {
+  size_t before =
+      s21::global_memory_stats(s21::memory_category::list).live_bytes;
+  {
+    s21::queue<int> q;
+    for (int i = 0; i < 10; i++) q.push(i);
+    for (int i = 0; i < 4; i++) q.pop();
+    s21::memory_stats stats = q.memory_usage();
+    EXPECT_EQ(stats.nodes, 6u);
+    EXPECT_EQ(stats.allocations, 10u);
+    EXPECT_EQ(stats.deallocations, 4u);
+    EXPECT_EQ(stats.peak_bytes * 6, stats.live_bytes * 10);
+    EXPECT_GT(s21::global_memory_stats(s21::memory_category::list).live_bytes,
+              before);
+    while (!q.empty()) q.pop();
+    q.push(42);
+    EXPECT_EQ(q.front(), 42);
+    EXPECT_EQ(q.memory_usage().nodes, 1u);
+  }
+  EXPECT_EQ(s21::global_memory_stats(s21::memory_category::list).live_bytes,
+            before);
+}
+
+TEST(memory_stats, map_node_handles_move_bytes) {
+  s21::map<int, int> a{{1, 1}, {2, 2}, {3, 3}};
+  s21::map<int, int> b;
+  s21::memory_stats before =
+      s21::global_memory_stats(s21::memory_category::map);
+  b.insert(a.extract(2));
+  EXPECT_EQ(a.memory_usage().live_bytes, 2 * b.memory_usage().live_bytes);
+  EXPECT_EQ(a.memory_usage().allocations, 3u);
+  EXPECT_EQ(b.memory_usage().allocations, 0u);
+  EXPECT_EQ(s21::global_memory_stats(s21::memory_category::map).live_bytes,
+            before.live_bytes);
+  { auto handle = a.extract(1); }
+  s21::memory_stats after =
+      s21::global_memory_stats(s21::memory_category::map);
+  EXPECT_EQ(after.deallocations, before.deallocations + 1);
+  EXPECT_EQ(after.live_bytes, before.live_bytes - b.memory_usage().live_bytes);
+  EXPECT_EQ(a.memory_usage().deallocations, 0u);
+}
+
+TEST(memory_stats, set_merge_moves_bytes) {
+  s21::set<int> x{1, 2, 3};
+  s21::set<int> y{3, 4};
+  size_t node = x.memory_usage().live_bytes / 3;
+  x.merge(y);
+  EXPECT_EQ(x.memory_usage().live_bytes, 4 * node);
+  EXPECT_EQ(x.memory_usage().peak_bytes, 4 * node);
+  EXPECT_EQ(x.memory_usage().allocations, 3u);
+  EXPECT_EQ(y.memory_usage().live_bytes, node);
+  EXPECT_EQ(y.memory_usage().allocations, 2u);
+  x.swap(y);
+  EXPECT_EQ(x.memory_usage().live_bytes, node);
+  EXPECT_EQ(y.memory_usage().live_bytes, 4 * node);
+}
+
+// Without moves, every block a container made and has not freed is one
+// of its nodes or buffers.
+template <typename Container>
+void expectBalanced(const Container &container) {
+  s21::memory_stats stats = container.memory_usage();
+  EXPECT_EQ(stats.allocations - stats.deallocations, stats.nodes);
+  EXPECT_LE(stats.live_bytes, stats.peak_bytes);
+}
+
+TEST(memory_stats, composite_containers) {
+  s21::flat_map<int, int> flat;
+  for (int i = 0; i < 100; i++) flat.insert(i, i);
+  expectBalanced(flat);
+  EXPECT_EQ(flat.memory_usage().nodes, 2u);
+
+  s21::lru_cache<int, int> cache(10);
+  for (int i = 0; i < 50; i++) cache.put(i, i);
+  expectBalanced(cache);
+
+  s21::concurrent_map<int, int> shared(4);
+  for (int i = 0; i < 100; i++) shared.insert(i, i);
+  for (int i = 0; i < 10; i++) shared.erase(i);
+  // 90 entries, the shard array and one bucket array per shard.
+  EXPECT_EQ(shared.memory_usage().nodes, 95u);
+
+  s21::static_set<int> frozen{3, 1, 2};
+  EXPECT_EQ(frozen.memory_usage().slack_bytes, sizeof(int));
+}
+
+TEST(memory_stats, global_totals_return_to_baseline) {
+  s21::memory_stats before = s21::global_memory_stats();
+  {
+    s21::vector<int> v{1, 2, 3};
+    s21::list<int> l{1, 2, 3};
+    s21::map<int, int> m{{1, 1}};
+    s21::set<int> s{1, 2};
+    s21::memory_stats during = s21::global_memory_stats();
+    EXPECT_EQ(during.allocations, before.allocations + 7);
+    EXPECT_EQ(during.live_bytes,
+              before.live_bytes + v.memory_usage().live_bytes +
+                  l.memory_usage().live_bytes + m.memory_usage().live_bytes +
+                  s.memory_usage().live_bytes);
+    EXPECT_GE(during.peak_bytes, during.live_bytes);
+  }
+  s21::memory_stats after = s21::global_memory_stats();
+  EXPECT_EQ(after.live_bytes, before.live_bytes);
+  EXPECT_EQ(after.nodes, before.nodes);
+}
+
+TEST(trace, vector_reallocations) {
+  s21::trace_reset();
+  s21::vector<int> v;
+  for (int i = 0; i < 100; i++) v.push_back(i);
+  s21::trace_stats stats = s21::trace_snapshot(s21::trace_op::vector_insert);
+  EXPECT_EQ(stats.calls, 100u);
+  // Capacity doubles 1, 2, 4, ..., 128.
+  EXPECT_EQ(stats.reallocations, 8u);
+  EXPECT_EQ(std::accumulate(std::begin(stats.histogram),
+                            std::end(stats.histogram), uint64_t(0)),
+            100u);
+  EXPECT_LE(stats.max_ns, stats.total_ns);
+}
+
+TEST(trace, comparisons_are_charged_to_open_scopes) {
+  s21::map<int, int> m{{1, 1}, {2, 2}, {3, 3}};
+  s21::trace_reset();
+  EXPECT_TRUE(m.contains(1));
+  s21::trace_stats lookup = s21::trace_snapshot(s21::trace_op::map_lookup);
+  EXPECT_EQ(lookup.calls, 1u);
+  EXPECT_EQ(lookup.comparisons, 2u);
+  m.erase(3);
+  s21::trace_stats erase = s21::trace_snapshot(s21::trace_op::map_erase);
+  EXPECT_EQ(erase.calls, 1u);
+  EXPECT_EQ(erase.comparisons, 2u);
+  EXPECT_EQ(s21::trace_snapshot(s21::trace_op::map_lookup).calls, 2u);
+
+  s21::list<int> l{3, 1, 2};
+  l.sort();
+  s21::trace_stats sort = s21::trace_snapshot(s21::trace_op::list_sort);
+  EXPECT_EQ(sort.calls, 1u);
+  EXPECT_GT(sort.comparisons, 0u);
+}
+
+TEST(trace, dump_json) {
+  s21::trace_reset();
+  s21::set<int> s;
+  s.insert(1);
+  s.insert(2);
+  std::ostringstream out;
+  s21::trace_dump_json(out);
+  std::string json = out.str();
+  EXPECT_EQ(json.rfind("{\"tracing\": true, \"operations\": [", 0), 0u);
+  EXPECT_NE(json.find("{\"name\": \"set::insert\", \"calls\": 2"),
+            std::string::npos);
+  EXPECT_EQ(json.find("map::insert"), std::string::npos);
+  EXPECT_EQ(json.back(), '}');
+}
+
+// Hardware counters are often missing (containers, virtual machines); the
+// test checks whichever behaviour this machine gives.
+TEST(perf_counters, count_or_explain) {
+  s21::perf_counters counters;
+  counters.reset();
+  counters.start();
+  s21::vector<int> v;
+  for (int i = 0; i < 100000; i++) v.push_back(i);
+  counters.stop();
+  for (int i = 0; i < s21::kPerfEvents; i++) {
+    auto event = s21::perf_event(i);
+    if (!counters.available(event)) {
+      EXPECT_FALSE(counters.unavailable_reason().empty());
+      EXPECT_EQ(counters.read(event), 0u);
+    }
+  }
+  if (counters.available(s21::perf_event::instructions)) {
+    EXPECT_GT(counters.read(s21::perf_event::instructions), 100000u);
+  }
+}
+
+// Complexity checks. CountedKey and CountingLess record the copies, moves
+// and comparisons a container makes; allocations come from the containers'
+// own memory_usage(). Bounds are asserted at sizes where a quadratic or
+// per-element-allocating implementation would miss them by far.
+struct Tally {
+  static inline size_t copies = 0;
+  static inline size_t moves = 0;
+  static inline size_t comparisons = 0;
+
+  static void reset() { copies = moves = comparisons = 0; }
+};
+
+struct CountedKey {
+  int key = 0;
+
+  CountedKey() = default;
+  CountedKey(int k) : key(k) {}
+  CountedKey(const CountedKey &other) : key(other.key) { ++Tally::copies; }
+  CountedKey(CountedKey &&other) noexcept : key(other.key) { ++Tally::moves; }
+  CountedKey &operator=(const CountedKey &other) {
+    key = other.key;
+    ++Tally::copies;
+    return *this;
+  }
+  CountedKey &operator=(CountedKey &&other) noexcept {
+    key = other.key;
+    ++Tally::moves;
+    return *this;
+  }
+  bool operator<(const CountedKey &other) const {
+    ++Tally::comparisons;
+    return key < other.key;
+  }
+  bool operator==(const CountedKey &other) const {
+    ++Tally::comparisons;
+    return key == other.key;
+  }
+};
+
+struct CountingLess {
+  bool operator()(int a, int b) const {
+    ++Tally::comparisons;
+    return a < b;
+  }
+};
+
+TEST(complexity, vector_push_back_is_amortized) {
+  const size_t n = 1 << 16;
+  s21::vector<CountedKey> v;
+  CountedKey key(7);
+  Tally::reset();
+  for (size_t i = 0; i < n; i++) v.push_back(key);
+  EXPECT_EQ(Tally::copies, n);
+  // Growth moves 1 + 2 + ... + n/2 elements.
+  EXPECT_LE(Tally::moves, 2 * n);
+  EXPECT_LE(v.memory_usage().allocations, 18u);
+}
+
+TEST(complexity, vector_erase_does_not_allocate) {
+  s21::vector<CountedKey> v;
+  for (int i = 0; i < 1000; i++) v.push_back(i);
+  size_t allocations = v.memory_usage().allocations;
+  Tally::reset();
+  v.erase(v.begin());
+  EXPECT_EQ(Tally::moves, 999u);
+  v.erase(v.begin() + 100, v.begin() + 200);
+  EXPECT_EQ(Tally::moves, 999u + 799u);
+  EXPECT_EQ(Tally::copies, 0u);
+  EXPECT_EQ(v.memory_usage().allocations, allocations);
+  EXPECT_EQ(v[100].key, 201);
+}
+
+TEST(complexity, list_sort_is_n_log_n) {
+  const int n = 1 << 12;
+  std::vector<int> keys(n);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  s21::list<CountedKey> l;
+  for (int key : keys) l.push_back(key);
+  size_t allocations = l.memory_usage().allocations;
+  Tally::reset();
+  l.sort();
+  EXPECT_LE(Tally::comparisons, size_t(n) * 12);
+  EXPECT_EQ(Tally::copies + Tally::moves, 0u);
+  EXPECT_EQ(l.memory_usage().allocations, allocations);
+  int expected = 0;
+  for (auto it = l.begin(); it != l.end(); ++it) {
+    EXPECT_EQ((*it).key, expected++);
+  }
+  EXPECT_EQ(l.back().key, n - 1);
+}
+
+TEST(complexity, list_splice_and_merge_relink_nodes) {
+  s21::list<CountedKey> a, b, c;
+  for (int i = 0; i < 1000; i++) {
+    a.push_back(2 * i);
+    b.push_back(2 * i + 1);
+    c.push_back(i);
+  }
+  Tally::reset();
+  a.merge(b);
+  EXPECT_LE(Tally::comparisons, 2000u);
+  a.splice(a.beginConst(), c);
+  EXPECT_EQ(Tally::copies + Tally::moves, 0u);
+  EXPECT_EQ(a.size(), 3000u);
+  EXPECT_TRUE(b.empty());
+  EXPECT_TRUE(c.empty());
+  EXPECT_EQ(a.memory_usage().allocations, 1000u);
+  EXPECT_EQ(a.memory_usage().nodes, 3000u);
+  EXPECT_EQ(a.front().key, 0);
+  EXPECT_EQ(a.back().key, 1999);
+}
+
+// A red-black tree is at most 2 * log2(n + 1) deep, and a descent asks the
+// comparator at most twice per level.
+TEST(complexity, sorted_insertion_keeps_lookups_logarithmic) {
+  const int n = 1 << 14;
+  const size_t perLookup = 2 * 2 * 15;
+  s21::map<int, int, CountingLess> m;
+  s21::set<int, CountingLess> s;
+  Tally::reset();
+  for (int i = 0; i < n; i++) {
+    m.insert(i, i);
+    s.insert(n - i);
+  }
+  EXPECT_LE(Tally::comparisons, 2 * n * perLookup);
+  Tally::reset();
+  for (int i = 0; i < n; i++) {
+    EXPECT_TRUE(m.contains(i));
+    EXPECT_TRUE(s.contains(i + 1));
+  }
+  EXPECT_LE(Tally::comparisons, 2 * n * perLookup);
+  Tally::reset();
+  for (int i = 0; i < n; i += 2) {
+    m.erase(i);
+    s.erase(i + 1);
+  }
+  EXPECT_LE(Tally::comparisons, n * perLookup);
+  EXPECT_EQ(m.size(), n / 2);
+  EXPECT_EQ(s.size(), n / 2);
+  EXPECT_EQ(m.begin()->first, 1);
+}
+
+TEST(complexity, merging_a_few_nodes_does_not_rebuild) {
+  const int n = 1 << 14;
+  s21::map<int, int, CountingLess> m;
+  s21::set<int, CountingLess> s;
+  for (int i = 0; i < n; i++) {
+    m.insert(2 * i, i);
+    s.insert(2 * i);
+  }
+  s21::map<int, int, CountingLess> few_pairs{{1, 1}, {4, -4}, {99, 99}};
+  s21::set<int, CountingLess> few{1, 4, 99};
+  Tally::reset();
+  m.merge(few_pairs);
+  s.merge(few);
+  EXPECT_LE(Tally::comparisons, 2 * 3 * 2 * 2 * 15u);
+  EXPECT_EQ(m.size(), size_t(n + 2));
+  EXPECT_EQ(s.size(), n + 2);
+  EXPECT_EQ(few_pairs.size(), 1u);
+  EXPECT_EQ(few_pairs.at(4), -4);
+  EXPECT_EQ(m.at(4), 2);
+  EXPECT_TRUE(few.contains(4));
+  EXPECT_EQ(few.size(), 1);
+  EXPECT_TRUE(m.contains(99));
+  EXPECT_TRUE(s.contains(1));
+  EXPECT_TRUE(m.validate());
+  EXPECT_TRUE(s.validate());
+  EXPECT_TRUE(few_pairs.validate());
+  EXPECT_TRUE(few.validate());
+}
+
+TEST(tree_stats, shape_of_built_and_grown_trees) {
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 1023; i++) items.emplace_back(i, i);
+  s21::map<int, int> built(items.begin(), items.end());
+  s21::tree_stats stats = built.stats();
+  EXPECT_EQ(stats.size, 1023u);
+  EXPECT_EQ(stats.height, 10u);
+  EXPECT_EQ(stats.max_depth, 9u);
+  EXPECT_DOUBLE_EQ(stats.balance, 1.0);
+  ASSERT_EQ(stats.depth_histogram.size(), 10u);
+  for (size_t depth = 0; depth < 10; depth++) {
+    EXPECT_EQ(stats.depth_histogram[depth], size_t(1) << depth);
+  }
+  EXPECT_TRUE(built.validate());
+
+  s21::set<int> grown;
+  for (int i = 0; i < 4096; i++) grown.insert(i);
+  stats = grown.stats();
+  EXPECT_EQ(std::accumulate(stats.depth_histogram.begin(),
+                            stats.depth_histogram.end(), size_t(0)),
+            4096u);
+  EXPECT_GT(stats.height, 12u);
+  EXPECT_LE(stats.balance, 2.0);
+  EXPECT_LT(stats.average_depth, stats.max_depth);
+  EXPECT_TRUE(grown.validate());
+
+  s21::set<int> empty;
+  EXPECT_EQ(empty.stats().height, 0u);
+  EXPECT_TRUE(empty.validate());
+}
+
+TEST(tree_stats, validate_after_mixed_operations) {
+  std::mt19937 rng(7);
+  s21::map<int, int> m;
+  s21::set<int> s;
+  for (int i = 0; i < 20000; i++) {
+    int key = rng() % 2000;
+    if (rng() % 3) {
+      m[key] = i;
+      s.insert(key);
+    } else {
+      m.erase(key);
+      s.erase(key);
+    }
+    if (i % 500 == 0) {
+      ASSERT_TRUE(m.validate());
+      ASSERT_TRUE(s.validate());
+    }
+  }
+  s21::set<int> other{1, 5000, 6000};
+  s.merge(other);
+  s21::map<int, int> moved(std::move(m));
+  EXPECT_TRUE(s.validate());
+  EXPECT_TRUE(other.validate());
+  EXPECT_TRUE(moved.validate());
+  EXPECT_TRUE(m.validate());
+  EXPECT_LE(moved.stats().balance, 2.0);
+}
+
+TEST(parallel, sort_matches_std_sort) {
+  s21::par::thread_pool pool(3);
+  s21::par::thread_pool alone(0);
+  std::mt19937 rng(11);
+  for (size_t n : {size_t(0), size_t(1), size_t(1000), size_t(100003),
+                   size_t(400000)}) {
+    s21::vector<int> v(n);
+    for (size_t i = 0; i < n; i++) v[i] = rng() % 50000;
+    std::vector<int> expected(v.begin(), v.end());
+    std::sort(expected.begin(), expected.end());
+    s21::vector<int> copy(v);
+    s21::par::sort(pool, v);
+    s21::par::sort(alone, copy);
+    ASSERT_TRUE(std::equal(v.begin(), v.end(), expected.begin()));
+    ASSERT_TRUE(std::equal(copy.begin(), copy.end(), expected.begin()));
+    s21::par::sort(pool, v, std::greater<>());
+    ASSERT_TRUE(std::is_sorted(v.begin(), v.end(), std::greater<>()));
+  }
+  s21::vector<std::string> words(70000);
+  for (size_t i = 0; i < words.size(); i++) {
+    words[i] = std::to_string(rng() % 100000);
+  }
+  s21::par::sort(pool, words);
+  EXPECT_TRUE(std::is_sorted(words.begin(), words.end()));
+}
+
+TEST(parallel, transform_reduce_and_for_each) {
+  s21::par::thread_pool pool(3);
+  s21::vector<int> v(100000);
+  for (size_t i = 0; i < v.size(); i++) v[i] = int(i % 10);
+  s21::par::for_each(pool, v, [](int &x) { x += 1; });
+  EXPECT_EQ(s21::par::reduce(pool, v, 0L, std::plus<>()), 550000L);
+  s21::vector<double> halves =
+      s21::par::transform(pool, v, [](int x) { return x / 2.0; });
+  ASSERT_EQ(halves.size(), v.size());
+  EXPECT_EQ(halves[12345], 3.0);
+  EXPECT_EQ(s21::par::reduce(halves, 0.0, std::plus<>()), 275000.0);
+
+  // Concatenation is associative but not commutative: the runs must be
+  // combined in order.
+  std::string text = s21::par::reduce(
+      pool, v, std::string(),
+      [](std::string s, int x) { return s += char('0' + x); },
+      [](std::string a, const std::string &b) { return a += b; });
+  ASSERT_EQ(text.size(), v.size());
+  for (size_t i = 0; i < v.size(); i += 997) {
+    ASSERT_EQ(text[i], char('0' + v[i]));
+  }
+  s21::vector<int> empty;
+  EXPECT_EQ(s21::par::reduce(pool, empty, 7, std::plus<>()), 7);
+}
+
+template <typename V, typename Op>
+concept reducible_with_op_only =
+    requires(s21::par::thread_pool &pool, const V &v, Op op) {
+      s21::par::reduce(pool, v, 0L, op);
+    };
+
+TEST(parallel, reduce_into_a_wider_type) {
+  auto add = [](long sum, int x) { return sum + x; };
+  static_assert(!reducible_with_op_only<s21::vector<int>, decltype(add)>);
+  static_assert(!reducible_with_op_only<s21::set<int>, decltype(add)>);
+  static_assert(reducible_with_op_only<s21::vector<int>, std::plus<>>);
+
+  s21::vector<int> v(1 << 20);
+  for (size_t i = 0; i < v.size(); i++) v[i] = 1 << 20;
+  s21::set<int> s;
+  for (int i = 0; i < 100000; i++) s.insert(i + (1 << 30));
+  const long expected = 100000L * (1 << 30) + 100000L * 99999 / 2;
+  for (unsigned threads : {1u, 4u}) {
+    s21::par::thread_pool pool(threads - 1);
+    EXPECT_EQ(s21::par::reduce(pool, v, 0L, add, std::plus<long>()),
+              1L << 40);
+    EXPECT_EQ(s21::par::reduce(pool, s, 0L, add, std::plus<long>()),
+              expected);
+  }
+}
+
+TEST(parallel, nested_groups_and_exceptions) {
+  s21::par::thread_pool pool(2);
+  std::function<long(int)> fib = [&](int n) -> long {
+    if (n < 12) return n < 2 ? n : fib(n - 1) + fib(n - 2);
+    long left = 0;
+    s21::par::task_group group(pool);
+    group.run([&] { left = fib(n - 1); });
+    long right = fib(n - 2);
+    group.wait();
+    return left + right;
+  };
+  EXPECT_EQ(fib(24), 46368);
+
+  s21::vector<int> v(50000);
+  int *bad = v.data() + 31337;
+  auto touch = [bad](int &x) {
+    if (&x == bad) throw std::runtime_error("bad element");
+    x = 1;
+  };
+  EXPECT_THROW(s21::par::for_each(pool, v, touch), std::runtime_error);
+  // The pool is still usable.
+  v[31337] = 1;
+  s21::par::for_each(pool, v, [](int &x) { x = 1; });
+  EXPECT_EQ(s21::par::reduce(pool, v, 0L, std::plus<>()), 50000L);
+}
+
+TEST(parallel, trees_split_into_ordered_runs) {
+  s21::set<int> empty;
+  EXPECT_EQ(empty.split(4).size(), 1u);
+  s21::set<int> s;
+  for (int i = 0; i < 100000; i++) s.insert(i * 3 % 100000);
+  for (size_t parts : {1, 2, 5, 16, 64}) {
+    auto cuts = s.split(parts);
+    ASSERT_LE(cuts.size(), parts + 1);
+    ASSERT_TRUE(cuts.front() == s.begin());
+    ASSERT_TRUE(cuts.back() == s.end());
+    int expected = 0;
+    for (size_t i = 0; i + 1 < cuts.size(); i++) {
+      ASSERT_TRUE(cuts[i] != cuts[i + 1]);
+      for (auto it = cuts[i]; it != cuts[i + 1]; ++it) {
+        ASSERT_EQ(*it, expected++);
+      }
+    }
+    ASSERT_EQ(expected, 100000);
+  }
+  EXPECT_GE(s.split(16).size(), 9u);
+
+  s21::par::thread_pool pool(3);
+  std::atomic<long> total{0};
+  s21::par::for_each(pool, s, [&](int x) { total += x; });
+  EXPECT_EQ(total.load(), 4999950000L);
+  s21::map<int, int> m;
+  for (int i = 0; i < 30000; i++) m.insert(i, i % 7);
+  EXPECT_EQ(s21::par::reduce(
+                pool, m, 0L, [](long sum, const auto &node) {
+                  return sum + node.second;
+                },
+                std::plus<>()),
+            89995L);
+  bool ordered = s21::par::reduce(
+      pool, m, std::pair<int, int>(-1, -1),
+      [](std::pair<int, int> range, const auto &node) {
+        if (range.first == -1) range.first = node.first;
+        range.second = range.second == -1 || range.second + 1 == node.first
+                            ? node.first
+                            : -2;
+        return range;
+      },
+      [](std::pair<int, int> a, std::pair<int, int> b) {
+        if (a.first == -1) return b;
+        if (b.first == -1) return a;
+        return std::pair<int, int>(
+            a.first, a.second + 1 == b.first ? b.second : -2);
+      }) == std::pair<int, int>(0, 29999);
+  EXPECT_TRUE(ordered);
+}
+
+template <typename T>
+void checkRadixSort(std::mt19937_64 &rng, size_t n) {
+  s21::vector<T> v(n);
+  for (size_t i = 0; i < n; i++) {
+    uint64_t bits = rng();
+    // Keys with few distinct high bytes make some passes skippable.
+    if (i % 3 == 0) bits &= 0xFFFF;
+    std::memcpy(&v[i], &bits, sizeof(T));
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(v[i])) v[i] = T(i) - T(n / 2);
+    }
+  }
+  std::vector<T> expected(v.begin(), v.end());
+  std::sort(expected.begin(), expected.end());
+  s21::list<T> l;
+  for (size_t i = 0; i < n; i++) l.push_back(v[i]);
+  s21::radix_sort(v);
+  ASSERT_TRUE(std::equal(v.begin(), v.end(), expected.begin()));
+  l.radix_sort();
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+  if (n != 0) {
+    ASSERT_EQ(l.back(), expected.back());
+  }
+}
+
+TEST(radix_sort, matches_std_sort_for_every_key_type) {
+  std::mt19937_64 rng(3);
+  for (size_t n : {size_t(0), size_t(1), size_t(50), size_t(1000),
+                   size_t(70000)}) {
+    checkRadixSort<int8_t>(rng, n);
+    checkRadixSort<uint8_t>(rng, n);
+    checkRadixSort<int16_t>(rng, n);
+    checkRadixSort<int32_t>(rng, n);
+    checkRadixSort<uint32_t>(rng, n);
+    checkRadixSort<int64_t>(rng, n);
+    checkRadixSort<uint64_t>(rng, n);
+    checkRadixSort<float>(rng, n);
+    checkRadixSort<double>(rng, n);
+  }
+}
+
+TEST(radix_sort, float_edge_values) {
+  s21::vector<double> v{0.0,  -0.0, INFINITY, -INFINITY, 1e-310, -1e-310,
+                        -2.5, 2.5,  DBL_MAX,  -DBL_MAX,  1.0,    -1.0};
+  for (int i = 0; i < 100; i++) v.push_back(i % 7 - 3);
+  s21::radix_sort(v);
+  EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+  EXPECT_EQ(v.front(), -INFINITY);
+  EXPECT_EQ(v.back(), INFINITY);
+  auto zero = std::find(v.begin(), v.end(), 0.0);
+  EXPECT_TRUE(std::signbit(*zero));
+  EXPECT_FALSE(std::signbit(*(zero + 1)));
+}
+
+TEST(radix_sort, key_extractor_is_stable) {
+  struct Record {
+    int64_t id;
+    int order;
+    std::string name;
+  };
+  s21::vector<Record> v;
+  s21::list<Record> l;
+  std::mt19937 rng(9);
+  for (int i = 0; i < 5000; i++) {
+    Record record{int64_t(rng() % 300) - 150, i, std::to_string(i)};
+    v.push_back(record);
+    l.push_back(record);
+  }
+  auto byId = [](const Record &r) { return r.id; };
+  s21::radix_sort(v, byId);
+  l.radix_sort(byId);
+  auto before = [](const Record &a, const Record &b) {
+    return a.id < b.id || (a.id == b.id && a.order < b.order);
+  };
+  EXPECT_TRUE(std::is_sorted(v.begin(), v.end(), before));
+  for (const Record &r : v) ASSERT_EQ(r.name, std::to_string(r.order));
+  struct Narrow {
+    uint16_t key;
+    uint16_t order;
+  };
+  s21::vector<Narrow> narrow;
+  for (int i = 0; i < 3000; i++) {
+    narrow.push_back(Narrow{uint16_t(rng() % 40), uint16_t(i)});
+  }
+  s21::radix_sort(narrow, [](const Narrow &x) { return x.key; });
+  EXPECT_TRUE(std::is_sorted(
+      narrow.begin(), narrow.end(), [](const Narrow &a, const Narrow &b) {
+        return a.key < b.key || (a.key == b.key && a.order < b.order);
+      }));
+  std::vector<Record> listed;
+  for (auto it = l.begin(); it != l.end(); ++it) listed.push_back(*it);
+  EXPECT_EQ(listed.size(), 5000u);
+  EXPECT_TRUE(std::is_sorted(listed.begin(), listed.end(), before));
+}
+
+struct MappedRecord {
+  int64_t id;
+  double value;
+};
+
+// A file in the temporary directory, removed when the test ends.
+class TempFile {
+ public:
+  explicit TempFile(const std::string &name)
+      : path_(std::filesystem::temp_directory_path() /
+              (name + "." + std::to_string(getpid()))) {
+    std::filesystem::remove(path_);
+  }
+  ~TempFile() { std::filesystem::remove(path_); }
+  std::string path() const { return path_.string(); }
+  size_t size() const { return std::filesystem::file_size(path_); }
+
+ private:
+  std::filesystem::path path_;
+};
+
+TEST(mmap_vector, write_then_reopen) {
+  TempFile file("s21_mmap_vector_records");
+  {
+    s21::mmap_vector<MappedRecord> v(file.path(), s21::mmap_mode::read_write);
+    EXPECT_TRUE(v.empty());
+    for (int i = 0; i < 100000; i++) v.push_back({i, i * 0.5});
+    EXPECT_GE(v.capacity(), v.size());
+    v.pop_back();
+    v.flush();
+    EXPECT_EQ(file.size(), 99999 * sizeof(MappedRecord));
+    EXPECT_EQ(v.capacity(), v.size());
+    v.push_back({-1, -1});
+  }
+  EXPECT_EQ(file.size(), 100000 * sizeof(MappedRecord));
+
+  s21::mmap_vector<MappedRecord> loaded(file.path());
+  EXPECT_FALSE(loaded.writable());
+  ASSERT_EQ(loaded.size(), 100000u);
+  loaded.advise(s21::mmap_access::sequential);
+  for (size_t i = 0; i < 99999; i++) {
+    ASSERT_EQ(loaded[i].id, int64_t(i));
+    ASSERT_EQ(loaded[i].value, i * 0.5);
+  }
+  EXPECT_EQ(loaded.back().id, -1);
+  EXPECT_THROW(loaded.at(100000), std::out_of_range);
+  EXPECT_THROW(loaded.push_back({0, 0}), std::logic_error);
+  EXPECT_THROW(loaded.resize(5), std::logic_error);
+
+  s21::mmap_vector<MappedRecord> moved(std::move(loaded));
+  EXPECT_FALSE(loaded.is_open());
+  EXPECT_EQ(moved.size(), 100000u);
+}
+
+TEST(mmap_vector, resize_shares_pages_and_reports_errors) {
+  TempFile file("s21_mmap_vector_ints");
+  s21::mmap_vector<int> writer(file.path(), s21::mmap_mode::read_write);
+  writer.resize(5000);
+  EXPECT_EQ(std::count(writer.begin(), writer.end(), 0), 5000);
+  writer[4321] = 7;
+  writer.resize(10);
+  writer.resize(20);
+  EXPECT_EQ(std::accumulate(writer.begin(), writer.end(), 0), 0);
+  writer.reserve(1 << 20);
+  writer.advise(s21::mmap_access::random);
+  writer.flush();
+  EXPECT_EQ(file.size(), 20 * sizeof(int));
+
+  // Both map the same pages, so writes show through without a flush.
+  s21::mmap_vector<int> other(file.path(), s21::mmap_mode::read_write);
+  other[3] = 42;
+  EXPECT_EQ(writer[3], 42);
+  writer.clear();
+  writer.close();
+  EXPECT_EQ(file.size(), 0u);
+  EXPECT_FALSE(writer.is_open());
+
+  TempFile missing("s21_mmap_vector_missing");
+  EXPECT_THROW(s21::mmap_vector<int>(missing.path()), std::system_error);
+  TempFile odd("s21_mmap_vector_odd");
+  {
+    s21::mmap_vector<char> bytes(odd.path(), s21::mmap_mode::read_write);
+    bytes.resize(6);
+  }
+  EXPECT_THROW(s21::mmap_vector<int>(odd.path()), std::runtime_error);
+}
+
+// A value with its own serializer, as a user of save() would write one.
+struct Tagged {
+  std::string tag;
+  int weight;
+  bool operator==(const Tagged &) const = default;
+};
+
+template <>
+struct s21::serializer<Tagged> {
+  static void write(serial_writer &out, const Tagged &value) {
+    out.value(value.tag);
+    out.value(value.weight);
+  }
+  static Tagged read(serial_reader &in) {
+    std::string tag = in.value<std::string>();
+    return Tagged{std::move(tag), in.value<int>()};
+  }
+};
+
+TEST(serialize, map_and_set_round_trip) {
+  s21::map<int64_t, double> numbers;
+  std::mt19937_64 rng(48);
+  for (int i = 0; i < 20000; i++) {
+    int64_t key = int64_t(rng());
+    numbers.insert_or_assign(key, double(key) / 3);
+  }
+  std::stringstream stream;
+  numbers.save(stream);
+  s21::map<int64_t, double> loaded{{1, 1}, {2, 2}};
+  loaded.load(stream);
+  ASSERT_EQ(loaded.size(), numbers.size());
+  EXPECT_TRUE(std::equal(
+      loaded.begin(), loaded.end(), numbers.begin(),
+      [](const auto &a, const auto &b) {
+        return a.first == b.first && a.second == b.second;
+      }));
+  EXPECT_TRUE(loaded.validate());
+  EXPECT_LE(loaded.stats().balance, 1.1);
+
+  s21::set<int> primes{2, 3, 5, 7, 11, 13};
+  s21::set<int> none;
+  std::stringstream set_stream;
+  primes.save(set_stream);
+  none.save(set_stream);
+  s21::set<int> copy{100};
+  copy.load(set_stream);
+  std::vector<int> values;
+  for (int value : copy) values.push_back(value);
+  EXPECT_EQ(values, (std::vector<int>{2, 3, 5, 7, 11, 13}));
+  EXPECT_TRUE(copy.validate());
+  copy.load(set_stream);
+  EXPECT_TRUE(copy.empty());
+
+  s21::map<std::string, Tagged> words{{"", {"empty", 0}},
+                                      {"pear", {"fruit", 3}},
+                                      {std::string(100000, 'z'), {"long", 9}}};
+  std::stringstream word_stream;
+  words.save(word_stream);
+  s21::map<std::string, Tagged> words_loaded;
+  words_loaded.load(word_stream);
+  ASSERT_EQ(words_loaded.size(), 3u);
+  EXPECT_EQ(words_loaded.at("pear"), (Tagged{"fruit", 3}));
+  EXPECT_EQ(words_loaded.at(std::string(100000, 'z')).tag, "long");
+  EXPECT_EQ(words_loaded.at("").tag, "empty");
+}
+
+TEST(serialize, bad_input_leaves_container_unchanged) {
+  s21::map<int, int> source;
+  for (int i = 0; i < 1000; i++) source.insert(i, i * i);
+  std::stringstream stream;
+  source.save(stream);
+  const std::string saved = stream.str();
+
+  s21::map<int, int> target{{-1, -1}};
+  auto expectUnchanged = [&target] {
+    ASSERT_EQ(target.size(), 1u);
+    EXPECT_EQ(target.at(-1), -1);
+  };
+  for (size_t at : {size_t(5), size_t(30), saved.size() / 2,
+                    saved.size() - 1}) {
+    std::string corrupt = saved;
+    corrupt[at] ^= 0x10;
+    std::istringstream in(corrupt);
+    EXPECT_THROW(target.load(in), std::runtime_error);
+    expectUnchanged();
+  }
+  std::istringstream truncated(saved.substr(0, saved.size() - 9));
+  EXPECT_THROW(target.load(truncated), std::runtime_error);
+  expectUnchanged();
+  std::istringstream empty("");
+  EXPECT_THROW(target.load(empty), std::runtime_error);
+  expectUnchanged();
+
+  s21::map<int, int64_t> wider;
+  std::istringstream as_wider(saved);
+  EXPECT_THROW(wider.load(as_wider), std::runtime_error);
+  s21::set<int> as_set;
+  std::istringstream as_set_stream(saved);
+  EXPECT_THROW(as_set.load(as_set_stream), std::runtime_error);
+
+  // The count sits after the magic and version; a string's length before
+  // its characters, and the first key comes right after the header.
+  std::string huge_count = saved;
+  uint64_t count = uint64_t(1) << 40;
+  std::memcpy(huge_count.data() + 8, &count, sizeof(count));
+  std::istringstream too_many(huge_count);
+  EXPECT_THROW(target.load(too_many), std::runtime_error);
+  std::istringstream too_many_set(huge_count.replace(3, 1, "s"));
+  EXPECT_THROW(as_set.load(too_many_set), std::runtime_error);
+  expectUnchanged();
+
+  s21::map<std::string, int> words{{"key", 1}};
+  std::stringstream word_stream;
+  words.save(word_stream);
+  std::string long_key = word_stream.str();
+  uint64_t length = uint64_t(1) << 62;
+  std::memcpy(long_key.data() + 24, &length, sizeof(length));
+  std::istringstream long_key_stream(long_key);
+  EXPECT_THROW(words.load(long_key_stream), std::runtime_error);
+  EXPECT_EQ(words.at("key"), 1);
+
+  std::istringstream intact(saved);
+  target.load(intact);
+  EXPECT_EQ(target.size(), 1000u);
+  EXPECT_EQ(target.at(999), 999 * 999);
+}
+
+// Counts live instances, so a test can check that every element a
+// container constructs is destroyed exactly once.
+struct Tracked {
+  static inline int live = 0;
+  std::string text;
+  explicit Tracked(std::string t = "") : text(std::move(t)) { ++live; }
+  Tracked(const Tracked &other) : text(other.text) { ++live; }
+  Tracked(Tracked &&other) noexcept : text(std::move(other.text)) { ++live; }
+  Tracked &operator=(const Tracked &) = default;
+  Tracked &operator=(Tracked &&) noexcept = default;
+  ~Tracked() { --live; }
+};
+
+template <size_t N>
+static std::vector<std::string> texts(const s21::small_vector<Tracked, N> &v) {
+  std::vector<std::string> out;
+  for (const Tracked &item : v) out.push_back(item.text);
+  return out;
+}
+
+TEST(small_vector, stays_inline_until_full) {
+  s21::small_vector<int, 4> v;
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(v.capacity(), 4u);
+  for (int i = 0; i < 4; i++) v.push_back(i);
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(v.memory_usage().allocations, 0u);
+  EXPECT_EQ(v.memory_usage().live_bytes, 0u);
+  v.push_back(4);
+  EXPECT_FALSE(v.is_inline());
+  EXPECT_EQ(v.capacity(), 8u);
+  EXPECT_EQ(v.memory_usage().allocations, 1u);
+  EXPECT_EQ(v.at(4), 4);
+  EXPECT_THROW(v.at(5), std::out_of_range);
+
+  v.insert(v.begin() + 1, 10);
+  v.erase(v.begin() + 3, v.begin() + 5);
+  EXPECT_EQ(std::vector<int>(v.begin(), v.end()),
+            (std::vector<int>{0, 10, 1, 4}));
+  v.shrink_to_fit();
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(v.memory_usage().deallocations, 1u);
+  v.pop_back();
+  EXPECT_EQ(v.back(), 1);
+  EXPECT_EQ(v.front(), 0);
+
+  s21::small_vector<int, 2> sized(5);
+  EXPECT_EQ(std::count(sized.begin(), sized.end(), 0), 5);
+  s21::small_vector<int, 8> listed{1, 2, 3};
+  EXPECT_TRUE(listed.is_inline());
+  EXPECT_EQ(listed.size(), 3u);
+  listed.reserve(100);
+  EXPECT_EQ(listed.capacity(), 100u);
+  EXPECT_EQ(listed[2], 3);
+}
+
+TEST(small_vector, moves_and_swaps_in_every_state) {
+  {
+    using Small = s21::small_vector<Tracked, 3>;
+    Small inline_a{Tracked("a"), Tracked("b")};
+    Small heap_a{Tracked("1"), Tracked("2"), Tracked("3"), Tracked("4")};
+    ASSERT_TRUE(inline_a.is_inline());
+    ASSERT_FALSE(heap_a.is_inline());
+
+    const Tracked *buffer = heap_a.data();
+    Small moved_heap(std::move(heap_a));
+    EXPECT_EQ(moved_heap.data(), buffer);
+    EXPECT_TRUE(heap_a.empty());
+    EXPECT_TRUE(heap_a.is_inline());
+    Small moved_inline(std::move(inline_a));
+    EXPECT_TRUE(moved_inline.is_inline());
+    EXPECT_TRUE(inline_a.empty());
+    EXPECT_EQ(texts(moved_inline), (std::vector<std::string>{"a", "b"}));
+
+    moved_inline.swap(moved_heap);
+    EXPECT_EQ(texts(moved_inline),
+              (std::vector<std::string>{"1", "2", "3", "4"}));
+    EXPECT_EQ(moved_inline.data(), buffer);
+    EXPECT_TRUE(moved_heap.is_inline());
+    EXPECT_EQ(texts(moved_heap), (std::vector<std::string>{"a", "b"}));
+
+    Small other_inline{Tracked("x")};
+    other_inline.swap(moved_heap);
+    EXPECT_EQ(texts(other_inline), (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(texts(moved_heap), (std::vector<std::string>{"x"}));
+
+    Small other_heap(5);
+    other_heap.swap(moved_inline);
+    EXPECT_EQ(other_heap.data(), buffer);
+    EXPECT_EQ(moved_inline.size(), 5u);
+
+    moved_heap = std::move(other_heap);
+    EXPECT_EQ(moved_heap.data(), buffer);
+    other_heap = std::move(other_inline);
+    EXPECT_EQ(texts(other_heap), (std::vector<std::string>{"a", "b"}));
+    Small copy = moved_heap;
+    EXPECT_EQ(texts(copy), texts(moved_heap));
+    copy = other_heap;
+    EXPECT_EQ(texts(copy), (std::vector<std::string>{"a", "b"}));
+    copy = moved_heap;
+    EXPECT_EQ(copy.size(), 4u);
+    copy.insert(copy.begin(), copy.back());
+    EXPECT_EQ(texts(copy).front(), "4");
+    copy.erase(copy.begin());
+    copy.clear();
+    EXPECT_TRUE(copy.empty());
+  }
+  EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(soa_vector, columns_rows_and_growth) {
+  s21::soa_vector<float, int, std::string> v;
+  EXPECT_EQ(v.capacity(), 0u);
+  for (int i = 0; i < 5; i++) {
+    v.push_back({i * 0.5f, i, std::to_string(i)});
+  }
+  EXPECT_EQ(v.size(), 5u);
+  EXPECT_EQ(v.capacity(), 8u);
+  EXPECT_EQ(v.memory_usage().allocations, 4u * 3);
+  EXPECT_EQ(v.memory_usage().nodes, 3u);
+
+  std::span<float> xs = v.column<0>();
+  ASSERT_EQ(xs.size(), 5u);
+  EXPECT_EQ(&xs[4] - &xs[0], 4);
+  EXPECT_EQ(s21::simd::sum(xs.data(), xs.data() + xs.size()), 5.0);
+  for (float &x : xs) x *= 2;
+  EXPECT_EQ(std::get<0>(v[3]), 3.0f);
+
+  auto [x, id, name] = v[2];
+  x = -1;
+  name = "two";
+  EXPECT_EQ(std::get<0>(v.at(2)), -1.0f);
+  EXPECT_EQ(v.column<2>()[2], "two");
+  EXPECT_EQ(id, 2);
+  v[0] = std::tuple<float, int, std::string>{7, 70, "seven"};
+  std::tuple<float, int, std::string> row = v.front();
+  EXPECT_EQ(row, std::make_tuple(7.0f, 70, std::string("seven")));
+  v.push_back(v.back());
+  EXPECT_EQ(std::get<2>(v.back()), "4");
+  v.push_back(v.front());
+  v.push_back(v.front());
+  v.push_back(v.front());
+  EXPECT_EQ(v.capacity(), 16u);
+  EXPECT_EQ(std::get<1>(v.back()), 70);
+  EXPECT_THROW(v.at(9), std::out_of_range);
+
+  int ids = 0;
+  for (auto [f, i, s] : v) ids += i;
+  EXPECT_EQ(ids, 70 + 1 + 2 + 3 + 4 + 4 + 70 * 3);
+  const auto &cv = v;
+  auto found = std::find_if(cv.begin(), cv.end(), [](const auto &r) {
+    return std::get<2>(r) == "two";
+  });
+  EXPECT_EQ(found - cv.begin(), 2);
+  EXPECT_EQ(cv.end() - cv.begin(), 9);
+
+  v.pop_back();
+  v.shrink_to_fit();
+  EXPECT_EQ(v.capacity(), 8u);
+  EXPECT_EQ(v.memory_usage().slack_bytes, 0u);
+  v.reserve(100);
+  EXPECT_EQ(v.capacity(), 100u);
+  v.clear();
+  EXPECT_TRUE(v.empty());
+  v.shrink_to_fit();
+  EXPECT_EQ(v.memory_usage().live_bytes, 0u);
+}
+
+TEST(soa_vector, copy_move_and_swap) {
+  s21::soa_vector<double, char> a{{1.5, 'a'}, {2.5, 'b'}};
+  s21::soa_vector<double, char> b(3);
+  EXPECT_EQ(b.size(), 3u);
+  EXPECT_EQ(b.column<0>()[2], 0.0);
+
+  s21::soa_vector<double, char> copy(a);
+  std::get<1>(copy[0]) = 'z';
+  EXPECT_EQ(std::get<1>(a[0]), 'a');
+  const double *column = a.column<0>().data();
+  s21::soa_vector<double, char> moved(std::move(a));
+  EXPECT_EQ(moved.column<0>().data(), column);
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(a.capacity(), 0u);
+
+  moved.swap(b);
+  EXPECT_EQ(b.column<0>().data(), column);
+  EXPECT_EQ(moved.size(), 3u);
+  b = copy;
+  EXPECT_EQ(std::get<1>(b[0]), 'z');
+  b = std::move(moved);
+  EXPECT_EQ(b.size(), 3u);
+  copy = copy;
+  EXPECT_EQ(copy.size(), 2u);
+  a = b;
+  EXPECT_EQ(a.column<1>().size(), 3u);
+}
+
+// A field whose assignment throws once a countdown runs out.
+struct ThrowingField {
+  static inline int assignments_left = -1;
+  int value = 0;
+
+  ThrowingField &operator=(const ThrowingField &other) {
+    if (assignments_left-- == 0) throw std::runtime_error("assignment");
+    value = other.value;
+    return *this;
+  }
+};
+
+TEST(soa_vector, throwing_field_leaks_nothing) {
+  using rows = s21::soa_vector<int, ThrowingField>;
+  size_t live =
+      s21::global_memory_stats(s21::memory_category::vector).live_bytes;
+  {
+    rows v;
+    for (int i = 0; i < 6; i++) v.push_back({i, ThrowingField{i}});
+    ThrowingField::assignments_left = 3;
+    EXPECT_THROW(rows copy(v), std::runtime_error);
+    ThrowingField::assignments_left = 3;
+    EXPECT_THROW((rows{{1, {}}, {2, {}}, {3, {}}, {4, {}}, {5, {}}}),
+                 std::runtime_error);
+    ThrowingField::assignments_left = 3;
+    EXPECT_THROW(v.reserve(100), std::runtime_error);
+    ThrowingField::assignments_left = -1;
+    EXPECT_EQ(v.capacity(), 8u);
+    EXPECT_EQ(v.size(), 6u);
+    EXPECT_EQ(v.column<0>()[5], 5);
+    EXPECT_EQ(v.memory_usage().live_bytes,
+              8 * (sizeof(int) + sizeof(ThrowingField)));
+    v.reserve(100);
+    EXPECT_EQ(v.column<1>()[5].value, 5);
+  }
+  EXPECT_EQ(s21::global_memory_stats(s21::memory_category::vector).live_bytes,
+            live);
+}
+
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
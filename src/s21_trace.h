@@ -0,0 +1,230 @@
+#ifndef SRC_S21_TRACE_H_
+#define SRC_S21_TRACE_H_
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace s21 {
+
+// Operation tracing for the containers.
+//
+// Each traced operation opens a trace_scope. When S21_TRACE is defined the
+// scope times the call and, on exit, adds it to the process-wide record for
+// its operation: a call count, a latency histogram with power-of-two
+// buckets, and the key comparisons and buffer reallocations made while it
+// was open. Comparisons and reallocations are reported from wherever they
+// happen (a recursive helper, a vector grown on behalf of another
+// container) through trace_comparison() and trace_reallocation(), and are
+// charged to every scope open on that thread, so an outer operation
+// includes the work of the ones it calls. Without S21_TRACE the scope and
+// the hooks are empty inline functions and compile away.
+enum class trace_op {
+  vector_insert,
+  vector_erase,
+  vector_reserve,
+  vector_shrink_to_fit,
+  list_sort,
+  list_merge,
+  list_splice,
+  list_unique,
+  map_lookup,
+  map_insert,
+  map_erase,
+  map_merge,
+  set_lookup,
+  set_insert,
+  set_erase,
+  set_merge,
+};
+
+inline constexpr int kTraceOps = 16;
+
+// Bucket b counts calls that took less than 2^b ns and at least 2^(b-1);
+// the last bucket also takes everything slower.
+inline constexpr int kTraceBuckets = 40;
+
+inline const char *trace_op_name(trace_op op) {
+  static const char *const names[kTraceOps] = {
+      "vector::insert", "vector::erase", "vector::reserve",
+      "vector::shrink_to_fit", "list::sort", "list::merge",
+      "list::splice", "list::unique", "map::lookup",
+      "map::insert", "map::erase", "map::merge",
+      "set::lookup", "set::insert", "set::erase",
+      "set::merge",
+  };
+  return names[static_cast<int>(op)];
+}
+
+struct trace_stats {
+  uint64_t calls = 0;
+  uint64_t total_ns = 0;
+  uint64_t max_ns = 0;
+  uint64_t comparisons = 0;
+  uint64_t reallocations = 0;
+  uint64_t histogram[kTraceBuckets] = {};
+};
+
+namespace trace_detail {
+
+struct alignas(64) Record {
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> total_ns{0};
+  std::atomic<uint64_t> max_ns{0};
+  std::atomic<uint64_t> comparisons{0};
+  std::atomic<uint64_t> reallocations{0};
+  std::atomic<uint64_t> histogram[kTraceBuckets] = {};
+
+  void add(uint64_t ns, uint64_t compared, uint64_t reallocated) {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    calls.fetch_add(1, relaxed);
+    total_ns.fetch_add(ns, relaxed);
+    comparisons.fetch_add(compared, relaxed);
+    reallocations.fetch_add(reallocated, relaxed);
+    int bucket = std::bit_width(ns);
+    histogram[bucket < kTraceBuckets ? bucket : kTraceBuckets - 1].fetch_add(
+        1, relaxed);
+    uint64_t seen = max_ns.load(relaxed);
+    while (seen < ns && !max_ns.compare_exchange_weak(seen, ns, relaxed)) {
+    }
+  }
+};
+
+inline Record &record(trace_op op) {
+  static Record table[kTraceOps];
+  return table[static_cast<int>(op)];
+}
+
+// Running totals for the calling thread; scopes remember them on entry.
+struct Events {
+  uint64_t comparisons = 0;
+  uint64_t reallocations = 0;
+};
+
+inline Events &events() {
+  thread_local Events local;
+  return local;
+}
+
+}  // namespace trace_detail
+
+#ifdef S21_TRACE
+
+inline constexpr bool kTracing = true;
+
+class trace_scope {
+ public:
+  explicit trace_scope(trace_op op)
+      : op_(op),
+        comparisons_(trace_detail::events().comparisons),
+        reallocations_(trace_detail::events().reallocations),
+        start_(std::chrono::steady_clock::now()) {}
+  trace_scope(const trace_scope &) = delete;
+  trace_scope &operator=(const trace_scope &) = delete;
+
+  ~trace_scope() {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    const trace_detail::Events &now = trace_detail::events();
+    trace_detail::record(op_).add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+        now.comparisons - comparisons_, now.reallocations - reallocations_);
+  }
+
+ private:
+  trace_op op_;
+  uint64_t comparisons_;
+  uint64_t reallocations_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+inline void trace_comparison() { ++trace_detail::events().comparisons; }
+inline void trace_reallocation() { ++trace_detail::events().reallocations; }
+
+#else
+
+inline constexpr bool kTracing = false;
+
+class trace_scope {
+ public:
+  explicit trace_scope(trace_op) {}
+  trace_scope(const trace_scope &) = delete;
+  trace_scope &operator=(const trace_scope &) = delete;
+};
+
+inline void trace_comparison() {}
+inline void trace_reallocation() {}
+
+#endif  // S21_TRACE
+
+inline trace_stats trace_snapshot(trace_op op) {
+  constexpr auto relaxed = std::memory_order_relaxed;
+  const trace_detail::Record &record = trace_detail::record(op);
+  trace_stats stats;
+  stats.calls = record.calls.load(relaxed);
+  stats.total_ns = record.total_ns.load(relaxed);
+  stats.max_ns = record.max_ns.load(relaxed);
+  stats.comparisons = record.comparisons.load(relaxed);
+  stats.reallocations = record.reallocations.load(relaxed);
+  for (int bucket = 0; bucket < kTraceBuckets; bucket++) {
+    stats.histogram[bucket] = record.histogram[bucket].load(relaxed);
+  }
+  return stats;
+}
+
+// Not atomic with respect to scopes closing on other threads.
+inline void trace_reset() {
+  constexpr auto relaxed = std::memory_order_relaxed;
+  for (int op = 0; op < kTraceOps; op++) {
+    trace_detail::Record &record = trace_detail::record(trace_op(op));
+    record.calls.store(0, relaxed);
+    record.total_ns.store(0, relaxed);
+    record.max_ns.store(0, relaxed);
+    record.comparisons.store(0, relaxed);
+    record.reallocations.store(0, relaxed);
+    for (auto &bucket : record.histogram) {
+      bucket.store(0, relaxed);
+    }
+  }
+}
+
+// Writes every operation that has been called at least once as
+//   {"tracing": true, "operations": [{"name": "map::insert", "calls": 3,
+//    "total_ns": ..., "max_ns": ..., "comparisons": ...,
+//    "reallocations": ..., "histogram": [{"below_ns": 1024, "count": 2},
+//    ...]}, ...]}
+// where the histogram lists only non-empty buckets.
+inline void trace_dump_json(std::ostream &out) {
+  out << "{\"tracing\": " << (kTracing ? "true" : "false")
+      << ", \"operations\": [";
+  const char *separator = "";
+  for (int op = 0; op < kTraceOps; op++) {
+    trace_stats stats = trace_snapshot(trace_op(op));
+    if (stats.calls == 0) {
+      continue;
+    }
+    out << separator << "{\"name\": \"" << trace_op_name(trace_op(op))
+        << "\", \"calls\": " << stats.calls
+        << ", \"total_ns\": " << stats.total_ns
+        << ", \"max_ns\": " << stats.max_ns
+        << ", \"comparisons\": " << stats.comparisons
+        << ", \"reallocations\": " << stats.reallocations
+        << ", \"histogram\": [";
+    const char *comma = "";
+    for (int bucket = 0; bucket < kTraceBuckets; bucket++) {
+      if (stats.histogram[bucket] != 0) {
+        out << comma << "{\"below_ns\": " << (uint64_t(1) << bucket)
+            << ", \"count\": " << stats.histogram[bucket] << "}";
+        comma = ", ";
+      }
+    }
+    out << "]}";
+    separator = ", ";
+  }
+  out << "]}";
+}
+
+}  // namespace s21
+
+#endif  //  SRC_S21_TRACE_H_
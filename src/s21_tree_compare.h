@@ -0,0 +1,51 @@
+#ifndef SRC_S21_TREE_COMPARE_H_
+#define SRC_S21_TREE_COMPARE_H_
+
+#include <compare>
+#include <functional>
+#include <type_traits>
+
+namespace s21 {
+
+// A comparator advertising is_transparent accepts any key type it can
+// compare, so lookups may probe with e.g. std::string_view without first
+// building a key_type.
+template <typename Compare>
+concept transparent_compare = requires { typename Compare::is_transparent; };
+
+template <typename Compare>
+struct is_std_less : std::false_type {};
+template <typename T>
+struct is_std_less<std::less<T>> : std::true_type {};
+
+template <typename Compare>
+struct is_std_greater : std::false_type {};
+template <typename T>
+struct is_std_greater<std::greater<T>> : std::true_type {};
+
+// Orders a against b for a tree descent: negative, zero or positive.
+// std::less and std::greater are defined by the key's own ordering, so when
+// the operands have operator<=> one three-way comparison answers both
+// "less?" and "equal?" at a node. Any other comparator is asked at most
+// twice.
+template <typename Compare, typename A, typename B>
+int compare_keys(const Compare &comp, const A &a, const B &b) {
+  if constexpr (is_std_less<Compare>::value &&
+                std::three_way_comparable_with<A, B>) {
+    auto order = a <=> b;
+    return (order < 0) ? -1 : (order > 0);
+  } else if constexpr (is_std_greater<Compare>::value &&
+                       std::three_way_comparable_with<A, B>) {
+    auto order = b <=> a;
+    return (order < 0) ? -1 : (order > 0);
+  } else {
+    if (comp(a, b)) {
+      return -1;
+    }
+    return comp(b, a) ? 1 : 0;
+  }
+}
+
+}  // namespace s21
+
+#endif  //  SRC_S21_TREE_COMPARE_H_
@@ -3,13 +3,18 @@
 
 #include <stdarg.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
+#include "s21_memory_stats.h"
+#include "s21_trace.h"
+
 namespace s21 {
 
 template <typename T>
 class vector {
+ public:
   typedef T value_type;
   typedef T &reference;
   typedef const T &const_reference;
@@ -21,7 +26,10 @@ class vector {
   value_type *arr;
   size_type m_size;
   size_type m_capacity;
+  [[no_unique_address]] memory_counter<memory_category::vector> accounting_;
+  value_type *allocate(size_type n);
   void destroy();
+  void grow(size_type min_capacity);
 
  public:
   vector();
@@ -35,23 +43,26 @@ class vector {
 
   reference at(size_type pos);
   reference operator[](size_type pos);
+  const_reference operator[](size_type pos) const;
   const_reference front() const;
   reference front();
   const_reference back() const;
   reference back();
   iterator data();
+  const_iterator data() const;
 
   iterator begin();
   const_iterator begin() const;
   iterator end();
   const_iterator end() const;
 
-  bool empty();
-  size_type size();
+  bool empty() const;
+  size_type size() const;
   size_type max_size();
   void reserve(size_type size);
-  size_type capacity();
+  size_type capacity() const;
   void shrink_to_fit();
+  memory_stats memory_usage() const;
 
   void clear();
 
@@ -59,6 +70,7 @@ class vector {
   iterator insert(iterator_type pos, const_reference value);
 
   void erase(iterator pos);
+  void erase(iterator first, iterator last);
   void push_back(const_reference value);
   void pop_back();
   void swap(vector &other);
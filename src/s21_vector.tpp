@@ -4,13 +4,11 @@ template <typename T>
 vector<T>::vector() : arr(nullptr), m_size(0), m_capacity(0) {}
 
 template <typename T>
-vector<T>::vector(size_type n) try : arr(new T[n]), m_size(n), m_capacity(n) {
-  for (size_type i = 0; i < m_size; i++) arr[i] = 0;
-  std::cout << std::endl;
-} catch (int &e) {
-  if (arr) delete[] arr;
-  e = 1;
-  throw std::invalid_argument("vector(n), exception");
+vector<T>::vector(size_type n) : arr(nullptr), m_size(n), m_capacity(n) {
+  if (n) {
+    arr = new T[n]();
+    accounting_.allocated(n * sizeof(T));
+  }
 }
 
 template <typename T>
@@ -24,7 +22,7 @@ vector<T>::vector(const vector &v) {
   m_size = v.m_size;
   m_capacity = v.m_size;
   if (v.begin()) {
-    arr = new T[m_size];
+    arr = allocate(m_size);
     std::copy(v.begin(), v.end(), begin());
   } else {
     arr = nullptr;
@@ -34,13 +32,38 @@ vector<T>::vector(const vector &v) {
 template <typename T>
 vector<T>::vector(vector &&v)
     : arr(v.arr), m_size(v.m_size), m_capacity(v.m_capacity) {
+  v.accounting_.released(m_capacity * sizeof(T));
+  accounting_.adopted(m_capacity * sizeof(T));
   v.arr = nullptr;
   v.m_size = 0;
+  v.m_capacity = 0;
+}
+
+template <typename T>
+typename vector<T>::value_type *vector<T>::allocate(size_type n) {
+  value_type *block = new T[n];
+  accounting_.allocated(n * sizeof(T));
+  return block;
 }
 
 template <typename T>
 void vector<T>::destroy() {
-  if (arr) delete[] arr;
+  if (arr) {
+    accounting_.freed(m_capacity * sizeof(T));
+    delete[] arr;
+  }
+}
+
+template <typename T>
+void vector<T>::grow(size_type min_capacity) {
+  size_type new_capacity = m_capacity ? m_capacity * 2 : 1;
+  if (new_capacity < min_capacity) new_capacity = min_capacity;
+  trace_reallocation();
+  T *newarr = allocate(new_capacity);
+  std::move(begin(), end(), newarr);
+  destroy();
+  arr = newarr;
+  m_capacity = new_capacity;
 }
 
 template <typename T>
@@ -50,28 +73,36 @@ vector<T>::~vector() {
 
 template <typename T>
 vector<T> &vector<T>::operator=(vector &&v) {
+  if (this == &v) {
+    return *this;
+  }
   destroy();
+  v.accounting_.released(v.m_capacity * sizeof(T));
+  accounting_.adopted(v.m_capacity * sizeof(T));
   arr = v.arr;
   m_size = v.m_size;
   m_capacity = v.m_capacity;
   v.arr = nullptr;
+  v.m_size = 0;
+  v.m_capacity = 0;
   return *this;
 }
 
 template <typename T>
 vector<T> &vector<T>::operator=(const vector &v) {
-  auto temp_v = v;
-  if (temp_v.size() > size()) {
-    if (temp_v.capacity() > m_capacity) m_capacity = temp_v.capacity();
-    value_type *newarr = new value_type[temp_v.size()];
-    std::copy(temp_v.begin(), temp_v.end(), newarr);
-    delete[] arr;
+  if (this == &v) {
+    return *this;
+  }
+  if (v.m_size > m_capacity) {
+    value_type *newarr = allocate(v.m_size);
+    std::copy(v.begin(), v.end(), newarr);
+    destroy();
     arr = newarr;
+    m_capacity = v.m_size;
   } else {
-    m_size = temp_v.size();
-    std::copy(temp_v.begin(), temp_v.end(), begin());
+    std::copy(v.begin(), v.end(), begin());
   }
-  m_size = temp_v.size();
+  m_size = v.m_size;
   return *this;
 }
 
@@ -88,6 +119,12 @@ typename vector<T>::reference vector<T>::operator[](size_type pos) {
   return arr[pos];
 }
 
+template <typename T>
+typename vector<T>::const_reference vector<T>::operator[](
+    size_type pos) const {
+  return arr[pos];
+}
+
 template <typename T>
 typename vector<T>::const_reference vector<T>::front() const {
   return arr[0];
@@ -113,6 +150,11 @@ typename vector<T>::iterator vector<T>::data() {
   return arr;
 }
 
+template <typename T>
+typename vector<T>::const_iterator vector<T>::data() const {
+  return arr;
+}
+
 template <typename T>
 typename vector<T>::iterator vector<T>::begin() {
   return arr;
@@ -134,17 +176,17 @@ typename vector<T>::const_iterator vector<T>::end() const {
 }
 
 template <typename T>
-bool vector<T>::empty() {
+bool vector<T>::empty() const {
   return m_size == 0;
 }
 
 template <typename T>
-typename vector<T>::size_type vector<T>::size() {
+typename vector<T>::size_type vector<T>::size() const {
   return m_size;
 }
 
 template <typename T>
-typename vector<T>::size_type vector<T>::capacity() {
+typename vector<T>::size_type vector<T>::capacity() const {
   return m_capacity;
 }
 
@@ -152,51 +194,39 @@ template <typename T>
 template <typename iterator_type>
 typename vector<T>::iterator vector<T>::insert(iterator_type pos,
                                                const_reference value) {
-  T *newarr = nullptr;
-  if (size() + 1 > capacity()) {
-    newarr = new T[m_size + 1];
-  } else {
-    newarr = begin();
-  }
-  auto nai = newarr;
-  auto i = begin();
-  for (; i != pos; i++, nai++) {
-    *nai = *i;
-  }
-  *nai = value;
-  T *res = nai;
-  nai++;
-  for (; i != end(); i++, nai++) {
-    *nai = *i;
-  }
-  if (newarr != begin()) {
-    delete[] arr;
-    arr = newarr;
-  }
+  trace_scope trace(trace_op::vector_insert);
+  size_type index = pos - begin();
+  value_type copy = value;
+  if (m_size == m_capacity) grow(m_size + 1);
+  std::move_backward(begin() + index, end(), end() + 1);
+  arr[index] = std::move(copy);
   m_size++;
-  if (m_capacity < m_size) m_capacity = m_size;
-  return res;
+  return begin() + index;
 }
 
 template <typename T>
 void vector<T>::reserve(size_type size) {
+  trace_scope trace(trace_op::vector_reserve);
   if (capacity() < size) {
-    m_capacity = size;
-    T *newarr = new T[m_capacity];
-    std::copy(begin(), end(), newarr);
-    delete[] arr;
+    trace_reallocation();
+    T *newarr = allocate(size);
+    std::move(begin(), end(), newarr);
+    destroy();
     arr = newarr;
+    m_capacity = size;
   }
 }
 
 template <typename T>
 void vector<T>::shrink_to_fit() {
+  trace_scope trace(trace_op::vector_shrink_to_fit);
   if (size() != capacity()) {
-    m_capacity = m_size;
-    T *newarr = new T[m_size];
-    std::copy(begin(), end(), newarr);
-    delete[] arr;
+    trace_reallocation();
+    T *newarr = allocate(m_size);
+    std::move(begin(), end(), newarr);
+    destroy();
     arr = newarr;
+    m_capacity = m_size;
   }
 }
 
@@ -207,24 +237,27 @@ void vector<T>::clear() {
 
 template <typename T>
 void vector<T>::erase(iterator pos) {
-  T *newarr = new T[m_capacity];
-  auto nai = newarr;
-  auto i = begin();
-  for (; i != pos; i++, nai++) {
-    *nai = *i;
-  }
-  i++;
-  for (; i != end(); i++, nai++) {
-    *nai = *i;
-  }
-  delete[] arr;
-  arr = newarr;
-  m_size--;
+  erase(pos, pos + 1);
+}
+
+template <typename T>
+void vector<T>::erase(iterator first, iterator last) {
+  trace_scope trace(trace_op::vector_erase);
+  std::move(last, end(), first);
+  m_size -= last - first;
 }
 
 template <typename T>
 void vector<T>::push_back(const_reference value) {
-  insert(end(), value);
+  trace_scope trace(trace_op::vector_insert);  // an insert at end()
+  if (m_size < m_capacity) {
+    arr[m_size++] = value;
+    return;
+  }
+  // value may live in the buffer that grow() is about to free.
+  value_type copy = value;
+  grow(m_size + 1);
+  arr[m_size++] = std::move(copy);
 }
 
 template <typename T>
@@ -243,6 +276,20 @@ void vector<T>::swap(vector &other) {
   other.m_capacity = capacity_temp;
   other.m_size = size_temp;
   other.arr = array_temp;
+  accounting_.exchange(other.accounting_, capacity_temp * sizeof(T),
+                       m_capacity * sizeof(T));
+}
+
+template <typename T>
+memory_stats vector<T>::memory_usage() const {
+  memory_stats stats;
+  if (arr) {
+    stats.live_bytes = m_capacity * sizeof(T);
+    stats.nodes = 1;
+    stats.slack_bytes = (m_capacity - m_size) * sizeof(T);
+  }
+  accounting_.report(stats);
+  return stats;
 }
 
 template <class T>
@@ -0,0 +1,432 @@
+#ifndef SRC_S21_VECTOR_SIMD_H_
+#define SRC_S21_VECTOR_SIMD_H_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_vector.h"
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define S21_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+
+// Scans over vectors of arithmetic types: find, count, min, max, sum and
+// equal. For int32_t and float the work is done 4 (SSE2) or 8 (AVX2)
+// elements at a time; the widest instruction set the CPU supports is
+// picked at run time, so no -m flags are needed. Other types, other
+// compilers and other architectures get the plain loop.
+//
+// Every function also takes a [first, last) range of any alignment: the
+// elements before the first vector-aligned address and after the last full
+// vector are handled one at a time.
+//
+// Results match the plain loop, with two exceptions. A float sum is added
+// up in double, in a different order, so it may differ from a sequential
+// sum in the last bits. With NaNs among the elements, float min and max are
+// unspecified.
+namespace simd {
+
+enum class level { scalar, sse2, avx2 };
+
+// The widest level this CPU runs.
+level supported();
+// The level in use, supported() unless use() said otherwise.
+level active();
+// Selects a level for the whole process, e.g. to compare them in a
+// benchmark; anything above supported() is lowered to it.
+void use(level wanted);
+
+template <typename T>
+concept arithmetic = std::is_arithmetic_v<T>;
+
+// Sum of a range: int64_t for signed, uint64_t for unsigned, double for
+// floating-point elements.
+template <arithmetic T>
+using sum_type =
+    std::conditional_t<std::is_floating_point_v<T>, double,
+                       std::conditional_t<std::is_signed_v<T>, int64_t,
+                                          uint64_t>>;
+
+template <arithmetic T>
+const T *find(const T *first, const T *last, T value);
+template <arithmetic T>
+size_t count(const T *first, const T *last, T value);
+// min and max throw std::out_of_range on an empty range.
+template <arithmetic T>
+T min(const T *first, const T *last);
+template <arithmetic T>
+T max(const T *first, const T *last);
+template <arithmetic T>
+sum_type<T> sum(const T *first, const T *last);
+// Element-wise ==, so for floats NaN != NaN and -0.0 == 0.0.
+template <arithmetic T>
+bool equal(const T *first, const T *last, const T *other);
+
+template <arithmetic T>
+typename vector<T>::const_iterator find(const vector<T> &v, T value);
+template <arithmetic T>
+size_t count(const vector<T> &v, T value);
+template <arithmetic T>
+T min(const vector<T> &v);
+template <arithmetic T>
+T max(const vector<T> &v);
+template <arithmetic T>
+sum_type<T> sum(const vector<T> &v);
+template <arithmetic T>
+bool equal(const vector<T> &a, const vector<T> &b);
+
+namespace detail {
+
+template <typename T>
+constexpr bool kVectorized =
+    std::is_same_v<T, int32_t> || std::is_same_v<T, float>;
+
+// The plain loops, also used for the unaligned head and tail.
+namespace scalar {
+
+template <typename T>
+const T *find(const T *first, const T *last, T value) {
+  for (; first != last; ++first) {
+    if (*first == value) {
+      break;
+    }
+  }
+  return first;
+}
+
+template <typename T>
+size_t count(const T *first, const T *last, T value) {
+  size_t found = 0;
+  for (; first != last; ++first) {
+    found += *first == value;
+  }
+  return found;
+}
+
+template <bool Max, typename T>
+T extreme(const T *first, const T *last, T best) {
+  for (; first != last; ++first) {
+    if (Max ? best < *first : *first < best) {
+      best = *first;
+    }
+  }
+  return best;
+}
+
+template <typename T>
+sum_type<T> sum(const T *first, const T *last) {
+  sum_type<T> total = 0;
+  for (; first != last; ++first) {
+    total += *first;
+  }
+  return total;
+}
+
+template <typename T>
+bool equal(const T *first, const T *last, const T *other) {
+  for (; first != last; ++first, ++other) {
+    if (!(*first == *other)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace scalar
+
+#ifdef S21_SIMD_X86
+
+// Each instruction set gets a Lanes<T> describing its registers, and the
+// same kernels from s21_vector_simd.tpp are compiled against it.
+namespace sse2 {
+
+template <typename T>
+struct Lanes;
+
+template <>
+struct Lanes<int32_t> {
+  using reg = __m128i;
+  using acc = __m128i;  // two int64_t partial sums
+  static constexpr size_t kWidth = 4;
+  static constexpr unsigned kAll = 0xF;
+
+  static reg load(const int32_t *p) {
+    return _mm_load_si128(reinterpret_cast<const reg *>(p));
+  }
+  static reg loadu(const int32_t *p) {
+    return _mm_loadu_si128(reinterpret_cast<const reg *>(p));
+  }
+  static void store(int32_t *p, reg x) {
+    _mm_storeu_si128(reinterpret_cast<reg *>(p), x);
+  }
+  static reg splat(int32_t value) { return _mm_set1_epi32(value); }
+  static unsigned equal(reg a, reg b) {
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));
+  }
+  // SSE2 has no 32-bit min/max; pick through a comparison mask.
+  static reg min(reg a, reg b) {
+    reg greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(greater, b),
+                        _mm_andnot_si128(greater, a));
+  }
+  static reg max(reg a, reg b) {
+    reg greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(greater, a),
+                        _mm_andnot_si128(greater, b));
+  }
+  static acc zero() { return _mm_setzero_si128(); }
+  static acc accumulate(acc total, reg x) {
+    reg sign = _mm_cmpgt_epi32(_mm_setzero_si128(), x);
+    total = _mm_add_epi64(total, _mm_unpacklo_epi32(x, sign));
+    return _mm_add_epi64(total, _mm_unpackhi_epi32(x, sign));
+  }
+  static int64_t reduce(acc total) {
+    alignas(16) int64_t parts[2];
+    _mm_store_si128(reinterpret_cast<acc *>(parts), total);
+    return parts[0] + parts[1];
+  }
+};
+
+template <>
+struct Lanes<float> {
+  using reg = __m128;
+  using acc = __m128d;
+  static constexpr size_t kWidth = 4;
+  static constexpr unsigned kAll = 0xF;
+
+  static reg load(const float *p) { return _mm_load_ps(p); }
+  static reg loadu(const float *p) { return _mm_loadu_ps(p); }
+  static void store(float *p, reg x) { _mm_storeu_ps(p, x); }
+  static reg splat(float value) { return _mm_set1_ps(value); }
+  static unsigned equal(reg a, reg b) {
+    return _mm_movemask_ps(_mm_cmpeq_ps(a, b));
+  }
+  static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+  static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+  static acc zero() { return _mm_setzero_pd(); }
+  static acc accumulate(acc total, reg x) {
+    total = _mm_add_pd(total, _mm_cvtps_pd(x));
+    return _mm_add_pd(total, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+  }
+  static double reduce(acc total) {
+    alignas(16) double parts[2];
+    _mm_store_pd(parts, total);
+    return parts[0] + parts[1];
+  }
+};
+
+#include "s21_vector_simd.tpp"
+
+}  // namespace sse2
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+namespace avx2 {
+
+template <typename T>
+struct Lanes;
+
+template <>
+struct Lanes<int32_t> {
+  using reg = __m256i;
+  using acc = __m256i;  // four int64_t partial sums
+  static constexpr size_t kWidth = 8;
+  static constexpr unsigned kAll = 0xFF;
+
+  static reg load(const int32_t *p) {
+    return _mm256_load_si256(reinterpret_cast<const reg *>(p));
+  }
+  static reg loadu(const int32_t *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const reg *>(p));
+  }
+  static void store(int32_t *p, reg x) {
+    _mm256_storeu_si256(reinterpret_cast<reg *>(p), x);
+  }
+  static reg splat(int32_t value) { return _mm256_set1_epi32(value); }
+  static unsigned equal(reg a, reg b) {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+  }
+  static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+  static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+  static acc zero() { return _mm256_setzero_si256(); }
+  static acc accumulate(acc total, reg x) {
+    __m128i low = _mm256_castsi256_si128(x);
+    __m128i high = _mm256_extracti128_si256(x, 1);
+    total = _mm256_add_epi64(total, _mm256_cvtepi32_epi64(low));
+    return _mm256_add_epi64(total, _mm256_cvtepi32_epi64(high));
+  }
+  static int64_t reduce(acc total) {
+    alignas(32) int64_t parts[4];
+    _mm256_store_si256(reinterpret_cast<acc *>(parts), total);
+    return parts[0] + parts[1] + parts[2] + parts[3];
+  }
+};
+
+template <>
+struct Lanes<float> {
+  using reg = __m256;
+  using acc = __m256d;
+  static constexpr size_t kWidth = 8;
+  static constexpr unsigned kAll = 0xFF;
+
+  static reg load(const float *p) { return _mm256_load_ps(p); }
+  static reg loadu(const float *p) { return _mm256_loadu_ps(p); }
+  static void store(float *p, reg x) { _mm256_storeu_ps(p, x); }
+  static reg splat(float value) { return _mm256_set1_ps(value); }
+  static unsigned equal(reg a, reg b) {
+    return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+  }
+  static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+  static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+  static acc zero() { return _mm256_setzero_pd(); }
+  static acc accumulate(acc total, reg x) {
+    total = _mm256_add_pd(total, _mm256_cvtps_pd(_mm256_castps256_ps128(x)));
+    return _mm256_add_pd(total, _mm256_cvtps_pd(_mm256_extractf128_ps(x, 1)));
+  }
+  static double reduce(acc total) {
+    alignas(32) double parts[4];
+    _mm256_store_pd(parts, total);
+    return (parts[0] + parts[1]) + (parts[2] + parts[3]);
+  }
+};
+
+#include "s21_vector_simd.tpp"
+
+}  // namespace avx2
+
+#pragma GCC pop_options
+
+#endif  // S21_SIMD_X86
+
+inline std::atomic<level> &selected() {
+  static std::atomic<level> current{supported()};
+  return current;
+}
+
+// Calls the kernel for the active level, or the plain loop for types
+// without one.
+#ifdef S21_SIMD_X86
+#define S21_SIMD_DISPATCH(T, call, fallback) \
+  do {                                       \
+    if constexpr (detail::kVectorized<T>) {  \
+      switch (active()) {                    \
+        case level::avx2:                    \
+          return detail::avx2::call;         \
+        case level::sse2:                    \
+          return detail::sse2::call;         \
+        case level::scalar:                  \
+          break;                             \
+      }                                      \
+    }                                        \
+    return fallback;                         \
+  } while (false)
+#else
+#define S21_SIMD_DISPATCH(T, call, fallback) return fallback
+#endif
+
+}  // namespace detail
+
+inline level supported() {
+#ifdef S21_SIMD_X86
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") ? level::avx2 : level::sse2;
+#else
+  return level::scalar;
+#endif
+}
+
+inline level active() {
+  return detail::selected().load(std::memory_order_relaxed);
+}
+
+inline void use(level wanted) {
+  detail::selected().store(std::min(wanted, supported()),
+                           std::memory_order_relaxed);
+}
+
+template <arithmetic T>
+const T *find(const T *first, const T *last, T value) {
+  S21_SIMD_DISPATCH(T, find(first, last, value),
+                    detail::scalar::find(first, last, value));
+}
+
+template <arithmetic T>
+size_t count(const T *first, const T *last, T value) {
+  S21_SIMD_DISPATCH(T, count(first, last, value),
+                    detail::scalar::count(first, last, value));
+}
+
+template <arithmetic T>
+T min(const T *first, const T *last) {
+  if (first == last) {
+    throw std::out_of_range("min of an empty range");
+  }
+  S21_SIMD_DISPATCH(T, extreme<false>(first, last),
+                    detail::scalar::extreme<false>(first + 1, last, *first));
+}
+
+template <arithmetic T>
+T max(const T *first, const T *last) {
+  if (first == last) {
+    throw std::out_of_range("max of an empty range");
+  }
+  S21_SIMD_DISPATCH(T, extreme<true>(first, last),
+                    detail::scalar::extreme<true>(first + 1, last, *first));
+}
+
+template <arithmetic T>
+sum_type<T> sum(const T *first, const T *last) {
+  S21_SIMD_DISPATCH(T, sum(first, last), detail::scalar::sum(first, last));
+}
+
+template <arithmetic T>
+bool equal(const T *first, const T *last, const T *other) {
+  S21_SIMD_DISPATCH(T, equal(first, last, other),
+                    detail::scalar::equal(first, last, other));
+}
+
+#undef S21_SIMD_DISPATCH
+
+template <arithmetic T>
+typename vector<T>::const_iterator find(const vector<T> &v, T value) {
+  return find(v.begin(), v.end(), value);
+}
+
+template <arithmetic T>
+size_t count(const vector<T> &v, T value) {
+  return count(v.begin(), v.end(), value);
+}
+
+template <arithmetic T>
+T min(const vector<T> &v) {
+  return min(v.begin(), v.end());
+}
+
+template <arithmetic T>
+T max(const vector<T> &v) {
+  return max(v.begin(), v.end());
+}
+
+template <arithmetic T>
+sum_type<T> sum(const vector<T> &v) {
+  return sum(v.begin(), v.end());
+}
+
+template <arithmetic T>
+bool equal(const vector<T> &a, const vector<T> &b) {
+  return a.size() == b.size() && equal(a.begin(), a.end(), b.begin());
+}
+
+}  // namespace simd
+
+}  // namespace s21
+
+#endif  //  SRC_S21_VECTOR_SIMD_H_
@@ -0,0 +1,103 @@
+using namespace s21;
+
+// Kernels over Lanes<T>, compiled once per instruction set. Each one walks
+// the unaligned head one element at a time, then whole aligned registers,
+// then the tail that does not fill a register.
+
+// The elements before the first address aligned for Lanes<T>::reg.
+template <typename T>
+const T *alignedStart(const T *first, const T *last) {
+  constexpr uintptr_t kAlign = sizeof(typename Lanes<T>::reg);
+  uintptr_t address = reinterpret_cast<uintptr_t>(first);
+  uintptr_t aligned = (address + kAlign - 1) & ~(kAlign - 1);
+  size_t head = (aligned - address) / sizeof(T);
+  return (head < size_t(last - first)) ? first + head : last;
+}
+
+// The end of the last whole register starting at an aligned p.
+template <typename T>
+const T *alignedEnd(const T *p, const T *last) {
+  return p + (last - p) / Lanes<T>::kWidth * Lanes<T>::kWidth;
+}
+
+template <typename T>
+const T *find(const T *first, const T *last, T value) {
+  using L = Lanes<T>;
+  const T *p = alignedStart(first, last);
+  const T *found = scalar::find(first, p, value);
+  if (found != p) {
+    return found;
+  }
+  const T *end = alignedEnd(p, last);
+  typename L::reg needle = L::splat(value);
+  for (; p != end; p += L::kWidth) {
+    unsigned mask = L::equal(L::load(p), needle);
+    if (mask != 0) {
+      return p + std::countr_zero(mask);
+    }
+  }
+  return scalar::find(p, last, value);
+}
+
+template <typename T>
+size_t count(const T *first, const T *last, T value) {
+  using L = Lanes<T>;
+  const T *p = alignedStart(first, last);
+  size_t found = scalar::count(first, p, value);
+  const T *end = alignedEnd(p, last);
+  typename L::reg needle = L::splat(value);
+  for (; p != end; p += L::kWidth) {
+    found += std::popcount(L::equal(L::load(p), needle));
+  }
+  return found + scalar::count(p, last, value);
+}
+
+// first != last.
+template <bool Max, typename T>
+T extreme(const T *first, const T *last) {
+  using L = Lanes<T>;
+  const T *p = alignedStart(first, last);
+  T best = scalar::extreme<Max>(first, p, *first);
+  const T *end = alignedEnd(p, last);
+  if (p != end) {
+    typename L::reg lanes = L::splat(best);
+    for (; p != end; p += L::kWidth) {
+      lanes = Max ? L::max(lanes, L::load(p)) : L::min(lanes, L::load(p));
+    }
+    T parts[L::kWidth];
+    L::store(parts, lanes);
+    best = scalar::extreme<Max>(parts, parts + L::kWidth, best);
+  }
+  return scalar::extreme<Max>(p, last, best);
+}
+
+template <typename T>
+sum_type<T> sum(const T *first, const T *last) {
+  using L = Lanes<T>;
+  const T *p = alignedStart(first, last);
+  sum_type<T> total = scalar::sum(first, p);
+  const T *end = alignedEnd(p, last);
+  typename L::acc lanes = L::zero();
+  for (; p != end; p += L::kWidth) {
+    lanes = L::accumulate(lanes, L::load(p));
+  }
+  return total + L::reduce(lanes) + scalar::sum(p, last);
+}
+
+// Aligned on first; other is read unaligned.
+template <typename T>
+bool equal(const T *first, const T *last, const T *other) {
+  using L = Lanes<T>;
+  const T *p = alignedStart(first, last);
+  if (!scalar::equal(first, p, other)) {
+    return false;
+  }
+  other += p - first;
+  const T *end = alignedEnd(p, last);
+  for (; p != end; p += L::kWidth, other += L::kWidth) {
+    if (L::equal(L::load(p), L::loadu(other)) != L::kAll) {
+      return false;
+    }
+  }
+  return scalar::equal(p, last, other);
+}